@@ -0,0 +1,115 @@
+/**
+ * @file
+ *
+ * Benchmark for cone searches, sky catalog against the angular 
+ * distance of every object.
+ *
+ * Usage: cone_search_bench [count] [radius]
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/sky_catalog.hxx>
+#include <sidereus/rotation.hxx>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Random cones searched.
+#define BENCH_QUERIES 200
+
+static double now()
+{
+  return std::chrono::duration< double >( 
+          std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+static double random_ra()
+{
+  return 360.0 * rand() / ( RAND_MAX + 1.0 );
+}
+
+static double random_dec()
+{
+  return GEN_GEOMETRY_RADTODEG( std::asin( 2.0 * rand() / RAND_MAX - 1.0 ));
+}
+
+int main( int argc, char* argv[] ) 
+{
+  size_t count = argc > 1 ? std::strtoul( argv[1], 0, 10 ) : 4000000;
+  double radius = argc > 2 ? std::atof( argv[2] ) : 1.0;
+
+  genesis::proto_geo::point_rect_coord center, v;
+
+  std::vector< double > ra( count ), dec( count ), x( count ), y( count ),
+                        z( count );
+  std::vector< size_t > ids, brute_ids;
+
+  double start = 0.0, build = 0.0, brute = 0.0, cone = 0.0;
+
+  size_t found = 0, brute_found = 0;
+
+  srand( 1 );
+
+  for( size_t i = 0; i < count; i++ ) {
+    ra[i] = random_ra();
+    dec[i] = random_dec();
+
+    // Brute force gets its vectors for free.
+    sidereus::rotation::get_rect( ra[i], dec[i], &v );
+    x[i] = v.x;
+    y[i] = v.y;
+    z[i] = v.z;
+  }
+
+  sidereus::sky_catalog catalog;
+
+  start = now();
+  catalog.build( &ra[0], &dec[0], count );
+  build = now() - start;
+
+  for( int q = 0; q < BENCH_QUERIES; q++ ) {
+    double query_ra = random_ra(), query_dec = random_dec();
+    double limit = std::cos( GEN_GEOMETRY_DEGTORAD( radius ));
+
+    sidereus::rotation::get_rect( query_ra, query_dec, &center );
+
+    start = now();
+    brute_ids.clear();
+
+    for( size_t i = 0; i < count; i++ ) {
+      if( x[i] * center.x + y[i] * center.y + z[i] * center.z >= limit ) {
+        brute_ids.push_back( i );
+      }
+    }
+
+    brute += now() - start;
+    brute_found += brute_ids.size();
+
+    start = now();
+    found += catalog.get_cone( query_ra, query_dec, radius, &ids );
+    cone += now() - start;
+  }
+
+  std::fprintf( stdout, "%zu objects, radius %g deg, build %.1f ms\n", 
+                count, radius, build * 1e3 );
+  std::fprintf( stdout, "Objects per cone: %.1f (brute force %.1f)\n", 
+                ( double )found / BENCH_QUERIES, 
+                ( double )brute_found / BENCH_QUERIES );
+  std::fprintf( stdout, "Brute force: %.1f us per cone\n", 
+                brute * 1e6 / BENCH_QUERIES );
+  std::fprintf( stdout, "Sky catalog: %.1f us per cone\n", 
+                cone * 1e6 / BENCH_QUERIES );
+  std::fprintf( stdout, "Speedup: %.0fx\n", brute / cone );
+
+  return 0;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file
+ *
+ * Benchmark for the nutation series, one day at a time against
+ * arrays of days.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/nutation.hxx>
+#include <sidereus/vector_math.hxx>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Days one apart, so the cache never answers for the scalar series.
+static void make_days( std::vector< double >* days )
+{
+  for( size_t i = 0; i < days->size(); i++ ) {
+    ( *days )[i] = 2415020.0 + ( double )i;
+  }
+}
+
+static double now()
+{
+  return std::chrono::duration< double >( 
+          std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+int main( int argc, char* argv[] ) 
+{
+  size_t count = argc > 1 ? std::strtoul( argv[1], 0, 10 ) : 50000;
+
+  std::vector< double > days( count ), longitude( count ), 
+                        obliquity( count ), ecliptic( count );
+
+  sidereus::nutation::nut nutation;
+  sidereus::nutation_cache cache( 0.0 );
+
+  double start = 0.0, scalar = 0.0, batch = 0.0, error = 0.0;
+
+  make_days( &days );
+
+  // Scalar constructor.
+  start = now();
+
+  for( size_t i = 0; i < count; i++ ) {
+    sidereus::nutation( days[i], &nutation, &cache );
+    longitude[i] = nutation.longitude;
+  }
+
+  scalar = now() - start;
+
+  // Keep the scalar results to compare.
+  std::vector< double > reference( longitude );
+
+  // Batch series.
+  start = now();
+  sidereus::nutation::get( &days[0], count, &longitude[0], &obliquity[0], 
+                           &ecliptic[0] );
+  batch = now() - start;
+
+  for( size_t i = 0; i < count; i++ ) {
+    error = std::max( error, std::fabs( longitude[i] - reference[i] ) );
+  }
+
+  std::fprintf( stdout, "days: %zu, isa: %s\n", count, 
+                sidereus::vector_math::get_isa() );
+  std::fprintf( stdout, "scalar: %.1f ns/day\n", scalar * 1e9 / count );
+  std::fprintf( stdout, "batch: %.1f ns/day\n", batch * 1e9 / count );
+  std::fprintf( stdout, "speedup: %.1fx\n", scalar / batch );
+  std::fprintf( stdout, "max longitude difference: %.3g arcsec\n", 
+                error * 3600.0 );
+
+  return 0;
+}
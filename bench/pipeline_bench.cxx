@@ -0,0 +1,107 @@
+/**
+ * @file
+ *
+ * Scaling benchmark for the catalog pipeline, from one thread up to
+ * every hardware thread (or --threads N).
+ *
+ * Usage: pipeline_bench [--count N] [--threads N] [--parallax]
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/pipeline.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Runs per thread count, the best one is reported.
+#define BENCH_RUNS 5
+
+static double now()
+{
+  return std::chrono::duration< double >( 
+          std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+int main( int argc, char* argv[] ) 
+{
+  size_t count = 4 << 20;
+  unsigned threads = std::max( 1u, std::thread::hardware_concurrency() );
+  bool parallax = false;
+
+  genesis::proto_geo::point_lon_lat_posn position = { -116.8630, 33.3561 };
+
+  for( int i = 1; i < argc; i++ ) {
+    if( std::strcmp( argv[i], "--count" ) == 0 && i + 1 < argc ) {
+      count = std::strtoul( argv[++i], 0, 10 );
+    } else if( std::strcmp( argv[i], "--threads" ) == 0 && i + 1 < argc ) {
+      threads = std::max( 1ul, std::strtoul( argv[++i], 0, 10 ));
+    } else if( std::strcmp( argv[i], "--parallax" ) == 0 ) {
+      parallax = true;
+    } else {
+      std::fprintf( stderr, "Usage: %s [--count N] [--threads N] "
+                    "[--parallax]\n", argv[0] );
+      return 1;
+    }
+  }
+
+  std::vector< double > ra( count ), dec( count ), distance( count ), 
+                        a( count ), d( count );
+
+  sidereus::observer palomar( &position, 1706 );
+  sidereus::epoch frame( 2451545.0 );
+
+  double single = 0.0;
+
+  for( size_t i = 0; i < count; i++ ) {
+    ra[i] = std::fmod( i * 137.508, 360.0 );
+    dec[i] = std::fmod( i * 17.3, 170.0 ) - 85.0;
+    distance[i] = 0.002 + 0.001 * ( i % 50 );
+  }
+
+  std::fprintf( stdout, "%zu objects%s\n", count, 
+                parallax ? ", parallax" : "" );
+  std::fprintf( stdout, "%7s %10s %14s %8s %10s %8s\n", "threads", "ms", 
+                "objects/s", "speedup", "efficiency", "steals" );
+
+  // Powers of two, then the requested count.
+  for( unsigned t = 1; t <= threads; t = t < threads ? 
+       std::min( 2 * t, threads ) : threads + 1 ) {
+    sidereus::pipeline P( t );
+
+    double best = 1e30;
+
+    for( int run = 0; run < BENCH_RUNS; run++ ) {
+      double start = 0.0;
+
+      std::copy( ra.begin(), ra.end(), a.begin() );
+      std::copy( dec.begin(), dec.end(), d.begin() );
+
+      start = now();
+      P.run( &palomar, &frame, &a[0], &d[0], count, 
+             parallax ? &distance[0] : 0 );
+      best = std::min( best, now() - start );
+    }
+
+    if( t == 1 ) {
+      single = best;
+    }
+
+    std::fprintf( stdout, "%7u %10.3f %14.0f %8.2f %9.0f%% %8zu\n", t, 
+                  best * 1e3, count / best, single / best, 
+                  100.0 * single / best / t, P.get_steals() );
+  }
+
+  return 0;
+}
@@ -0,0 +1,861 @@
+/**
+ * @file
+ *
+ * Benchmark of every public sidereus routine, in ns per call.
+ *
+ * Each routine is run over distinct Julian days, so the nutation
+ * cache misses on every call (cold), and routines that use nutation
+ * are run again over a single Julian day, so it always hits (warm).
+ * Every case runs on one thread and on all hardware threads; each
+ * thread has its own nutation cache.
+ *
+ * Usage: sidereus_bench [--csv | --json] [--calls N] [--threads N]
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/apparent_place.hxx>
+#include <sidereus/epoch.hxx>
+#include <sidereus/frames.hxx>
+#include <sidereus/julian_day.hxx>
+#include <sidereus/nutation.hxx>
+#include <sidereus/nutation_table.hxx>
+#include <sidereus/observer.hxx>
+#include <sidereus/parallax.hxx>
+#include <sidereus/precession.hxx>
+#include <sidereus/refraction.hxx>
+#include <sidereus/sidereal_time.hxx>
+#include <sidereus/transform_chain.hxx>
+#include <sidereus/transform_coord.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Objects per call of the array routines.
+#define BENCH_BATCH 1024
+
+// Days after J2000 holding every cold Julian day, a century where the
+// nutation series is meant to be used.
+#define BENCH_SPAN 36525.0
+
+// Days between successive cold Julian days, more than the nutation 
+// cache tolerance.
+#define BENCH_STEP 0.37
+
+/**
+ * Inputs and outputs of one thread.
+ */
+struct bench_data {
+  std::vector< double > JD;  ///< One Julian day per call.
+  std::vector< double > ra;  ///< Right ascensions or longitudes.
+  std::vector< double > dec; ///< Declinations or latitudes.
+  std::vector< double > out1; ///< First output array.
+  std::vector< double > out2; ///< Second output array.
+  std::vector< double > out3; ///< Third output array.
+  std::vector< genesis::proto_datetime::date > dates; ///< Calendar dates.
+  double sink;               ///< Keeps results alive.
+};
+
+/**
+ * A benchmarked routine.
+ */
+struct bench_case {
+  const char* name;              ///< Routine.
+  void ( *run )( bench_data* );  ///< Calls it once per Julian day.
+  bool nutation;                 ///< True if it uses the nutation cache.
+  size_t objects;                ///< Objects per call.
+};
+
+static genesis::proto_geo::point_lon_lat_posn site = { -116.8630, 33.3561 };
+
+static sidereus::nutation_table table;
+
+// Julian day.
+static void bench_julian_day( bench_data* d )
+{
+  sidereus::julian_day J;
+  genesis::proto_datetime::date date;
+
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    date.years = 1900 + i % 200;
+    date.months = 1 + i % 12;
+    date.days = 1 + i % 28;
+    date.hours = i % 24;
+    date.minutes = i % 60;
+    date.seconds = 0.5 * ( i % 120 );
+    d->sink += J.get_julian_day( &date );
+  }
+}
+
+static void bench_julian_day_batch( bench_data* d )
+{
+  for( size_t i = 0; i + BENCH_BATCH <= d->JD.size(); i += BENCH_BATCH ) {
+    sidereus::julian_day::get_julian_day( &d->dates[i], BENCH_BATCH,
+                                          &d->out1[0] );
+    d->sink += d->out1[0];
+  }
+}
+
+static void bench_date_batch( bench_data* d )
+{
+  for( size_t i = 0; i + BENCH_BATCH <= d->JD.size(); i += BENCH_BATCH ) {
+    sidereus::julian_day::get_date( &d->JD[i], BENCH_BATCH, &d->dates[0] );
+    d->sink += d->dates[0].seconds;
+  }
+}
+
+// Nutation.
+static void bench_nutation( bench_data* d )
+{
+  sidereus::nutation::nut n;
+
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    sidereus::nutation( d->JD[i], &n );
+    d->sink += n.longitude;
+  }
+}
+
+static void bench_nutation_batch( bench_data* d )
+{
+  for( size_t i = 0; i + BENCH_BATCH <= d->JD.size(); i += BENCH_BATCH ) {
+    sidereus::nutation::get( &d->JD[i], BENCH_BATCH, &d->out1[0],
+                             &d->out2[0], &d->out3[0] );
+    d->sink += d->out1[0];
+  }
+}
+
+static void bench_nutation_table( bench_data* d )
+{
+  sidereus::nutation::nut n;
+
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    table.get( d->JD[i], &n );
+    d->sink += n.longitude;
+  }
+}
+
+// Sidereal time.
+static void bench_sidereal_mean( bench_data* d )
+{
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    d->sink += sidereus::sidereal_time::get_mean( d->JD[i] );
+  }
+}
+
+static void bench_sidereal_apparent( bench_data* d )
+{
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    d->sink += sidereus::sidereal_time::get_apparent( d->JD[i] );
+  }
+}
+
+static void bench_sidereal_table( bench_data* d )
+{
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    d->sink += table.get_apparent_sidereal( d->JD[i] );
+  }
+}
+
+// Epoch.
+static void bench_epoch( bench_data* d )
+{
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    sidereus::epoch frame( d->JD[i] );
+    d->sink += frame.get_apparent_sidereal();
+  }
+}
+
+// Precession.
+static void bench_precession( bench_data* d )
+{
+  genesis::proto_geo::point_equ_posn object, position;
+
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    object.ra = d->ra[i];
+    object.dec = d->dec[i];
+    sidereus::precession::get_equ_prec2( &object, JULIAN_DAY_JD2000,
+                                         d->JD[i], &position );
+    d->sink += position.ra;
+  }
+}
+
+static void bench_precession_batch( bench_data* d )
+{
+  sidereus::precession P;
+
+  for( size_t i = 0; i + BENCH_BATCH <= d->JD.size(); i += BENCH_BATCH ) {
+    P.apply( &d->ra[i], &d->dec[i], BENCH_BATCH, JULIAN_DAY_JD2000,
+             d->JD[i], &d->out1[0], &d->out2[0] );
+    d->sink += d->out1[0];
+  }
+}
+
+// Apparent place, one epoch per call.
+static void bench_apparent_place( bench_data* d )
+{
+  genesis::proto_geo::point_equ_posn mean, position;
+
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    sidereus::epoch frame( d->JD[i] );
+    sidereus::apparent_place place( &frame );
+
+    mean.ra = d->ra[i];
+    mean.dec = d->dec[i];
+    place.get( &mean, &position );
+    d->sink += position.ra;
+  }
+}
+
+static void bench_apparent_place_batch( bench_data* d )
+{
+  for( size_t i = 0; i + BENCH_BATCH <= d->JD.size(); i += BENCH_BATCH ) {
+    sidereus::epoch frame( d->JD[i] );
+    sidereus::apparent_place place( &frame );
+
+    place.get( &d->ra[i], &d->dec[i], BENCH_BATCH, &d->out1[0], 
+               &d->out2[0] );
+    d->sink += d->out1[0];
+  }
+}
+
+// Parallax.
+static void bench_parallax( bench_data* d )
+{
+  genesis::proto_geo::point_equ_posn object, parallax;
+
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    object.ra = d->ra[i];
+    object.dec = d->dec[i];
+    sidereus::parallax::get( &object, 0.37, &site, 1706, d->JD[i],
+                             &parallax );
+    d->sink += parallax.ra;
+  }
+}
+
+static void bench_parallax_ha( bench_data* d )
+{
+  genesis::proto_geo::point_equ_posn object, parallax;
+
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    object.ra = d->ra[i];
+    object.dec = d->dec[i];
+    sidereus::parallax::get_ha( &object, 0.37, &site, 1706,
+                                d->ra[i] / 15.0, &parallax );
+    d->sink += parallax.ra;
+  }
+}
+
+static void bench_parallax_ha_batch( bench_data* d )
+{
+  std::vector< double > distance( BENCH_BATCH, 0.37 );
+
+  for( size_t i = 0; i + BENCH_BATCH <= d->JD.size(); i += BENCH_BATCH ) {
+    sidereus::parallax::get_ha( &d->dec[i], &distance[0], &d->ra[i],
+                                BENCH_BATCH, &site, 1706,
+                                &d->out1[0], &d->out2[0] );
+    d->sink += d->out1[0];
+  }
+}
+
+// Transforms.
+static void bench_hrz_from_equ( bench_data* d )
+{
+  sidereus::transform_coord T;
+  genesis::proto_geo::point_equ_posn object;
+  genesis::proto_geo::point_hrz_posn position;
+
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    object.ra = d->ra[i];
+    object.dec = d->dec[i];
+    T.get_hrz_from_equ( &object, &site, d->JD[i], &position );
+    d->sink += position.alt;
+  }
+}
+
+static void bench_hrz_from_equ_sidereal_time( bench_data* d )
+{
+  sidereus::transform_coord T;
+  genesis::proto_geo::point_equ_posn object;
+  genesis::proto_geo::point_hrz_posn position;
+
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    object.ra = d->ra[i];
+    object.dec = d->dec[i];
+    T.get_hrz_from_equ_sidereal_time( &object, &site, 8.5823, &position );
+    d->sink += position.alt;
+  }
+}
+
+static void bench_hrz_from_equ_batch( bench_data* d )
+{
+  sidereus::transform_coord T;
+
+  for( size_t i = 0; i + BENCH_BATCH <= d->JD.size(); i += BENCH_BATCH ) {
+    T.get_hrz_from_equ( &d->ra[i], &d->dec[i], BENCH_BATCH, &site,
+                        d->JD[i], &d->out1[0], &d->out2[0] );
+    d->sink += d->out1[0];
+  }
+}
+
+static void bench_hrz_from_equ_observer( bench_data* d )
+{
+  sidereus::observer palomar( &site );
+  genesis::proto_geo::point_equ_posn object;
+  genesis::proto_geo::point_hrz_posn position;
+
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    object.ra = d->ra[i];
+    object.dec = d->dec[i];
+    palomar.get_hrz_from_equ_sidereal_time( &object, 8.5823, &position );
+    d->sink += position.alt;
+  }
+}
+
+static void bench_hrz_from_equ_observer_jd( bench_data* d )
+{
+  sidereus::observer palomar( &site );
+  genesis::proto_geo::point_equ_posn object = { 347.3193375, -6.7198917 };
+  genesis::proto_geo::point_hrz_posn position;
+
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    palomar.get_hrz_from_equ( &object, 2451545.0 + i / 1440.0, &position );
+    d->sink += position.alt;
+  }
+}
+
+static void bench_hrz_track( bench_data* d )
+{
+  sidereus::observer palomar( &site );
+  genesis::proto_geo::point_equ_posn object = { 347.3193375, -6.7198917 };
+
+  for( size_t i = 0; i + BENCH_BATCH <= d->JD.size(); i += BENCH_BATCH ) {
+    palomar.get_hrz_track( &object, 2451545.0 + i / 1440.0, 1.0 / 1440.0, 
+                           BENCH_BATCH, &d->out1[0], &d->out2[0] );
+    d->sink += d->out1[0];
+  }
+}
+
+static void bench_equ_from_hrz( bench_data* d )
+{
+  sidereus::transform_coord T;
+  genesis::proto_geo::point_hrz_posn object;
+  genesis::proto_geo::point_equ_posn position;
+
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    object.az = d->ra[i];
+    object.alt = d->dec[i];
+    T.get_equ_from_hrz( &object, &site, d->JD[i], &position );
+    d->sink += position.ra;
+  }
+}
+
+static void bench_equ_from_hrz_batch( bench_data* d )
+{
+  sidereus::transform_coord T;
+
+  for( size_t i = 0; i + BENCH_BATCH <= d->JD.size(); i += BENCH_BATCH ) {
+    T.get_equ_from_hrz( &d->dec[i], &d->ra[i], BENCH_BATCH, &site,
+                        d->JD[i], &d->out1[0], &d->out2[0] );
+    d->sink += d->out1[0];
+  }
+}
+
+static void bench_equ_from_ecl( bench_data* d )
+{
+  sidereus::transform_coord T;
+  genesis::proto_geo::point_lon_lat_posn object;
+  genesis::proto_geo::point_equ_posn position;
+
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    object.lon = d->ra[i];
+    object.lat = d->dec[i];
+    T.get_equ_from_ecl( &object, d->JD[i], &position );
+    d->sink += position.ra;
+  }
+}
+
+static void bench_ecl_from_equ( bench_data* d )
+{
+  sidereus::transform_coord T;
+  genesis::proto_geo::point_equ_posn object;
+  genesis::proto_geo::point_lon_lat_posn position;
+
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    object.ra = d->ra[i];
+    object.dec = d->dec[i];
+    T.get_ecl_from_equ( &object, d->JD[i], &position );
+    d->sink += position.lon;
+  }
+}
+
+static void bench_ecl_from_rect( bench_data* d )
+{
+  sidereus::transform_coord T;
+  genesis::proto_geo::point_rect_coord object;
+  genesis::proto_geo::point_lon_lat_posn position;
+
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    object.x = d->ra[i];
+    object.y = d->dec[i];
+    object.z = 1.0;
+    T.get_ecl_from_rect( &object, &position );
+    d->sink += position.lon;
+  }
+}
+
+static void bench_equ_from_gal( bench_data* d )
+{
+  sidereus::transform_coord T;
+  genesis::proto_geo::point_gal_posn object;
+  genesis::proto_geo::point_equ_posn position;
+
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    object.lon = d->ra[i];
+    object.lat = d->dec[i];
+    T.get_equ_from_gal( &object, &position );
+    d->sink += position.ra;
+  }
+}
+
+static void bench_equ2000_from_gal( bench_data* d )
+{
+  sidereus::transform_coord T;
+  genesis::proto_geo::point_gal_posn object;
+  genesis::proto_geo::point_equ_posn position;
+
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    object.lon = d->ra[i];
+    object.lat = d->dec[i];
+    T.get_equ2000_from_gal( &object, &position );
+    d->sink += position.ra;
+  }
+}
+
+static void bench_gal_from_equ( bench_data* d )
+{
+  sidereus::transform_coord T;
+  genesis::proto_geo::point_equ_posn object;
+  genesis::proto_geo::point_gal_posn position;
+
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    object.ra = d->ra[i];
+    object.dec = d->dec[i];
+    T.get_gal_from_equ( &object, &position );
+    d->sink += position.lon;
+  }
+}
+
+static void bench_gal_from_equ2000( bench_data* d )
+{
+  sidereus::transform_coord T;
+  genesis::proto_geo::point_equ_posn object;
+  genesis::proto_geo::point_gal_posn position;
+
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    object.ra = d->ra[i];
+    object.dec = d->dec[i];
+    T.get_gal_from_equ2000( &object, &position );
+    d->sink += position.lon;
+  }
+}
+
+static void bench_gal_from_equ2000_batch( bench_data* d )
+{
+  sidereus::transform_coord T;
+
+  for( size_t i = 0; i + BENCH_BATCH <= d->JD.size(); i += BENCH_BATCH ) {
+    T.get_gal_from_equ2000( &d->ra[i], &d->dec[i], BENCH_BATCH,
+                            &d->out1[0], &d->out2[0] );
+    d->sink += d->out1[0];
+  }
+}
+
+static void bench_equ2000_from_gal_batch( bench_data* d )
+{
+  sidereus::transform_coord T;
+
+  for( size_t i = 0; i + BENCH_BATCH <= d->JD.size(); i += BENCH_BATCH ) {
+    T.get_equ2000_from_gal( &d->ra[i], &d->dec[i], BENCH_BATCH,
+                            &d->out1[0], &d->out2[0] );
+    d->sink += d->out1[0];
+  }
+}
+
+// Galactic to horizontal, stage by stage through spherical coordinates.
+static void bench_gal_hrz_spherical( bench_data* d )
+{
+  sidereus::observer palomar( &site );
+  sidereus::precession P;
+  sidereus::transform_coord T;
+
+  double alt[BENCH_BATCH], az[BENCH_BATCH];
+
+  for( size_t i = 0; i + BENCH_BATCH <= d->JD.size(); i += BENCH_BATCH ) {
+    T.get_equ2000_from_gal( &d->ra[i], &d->dec[i], BENCH_BATCH,
+                            &d->out1[0], &d->out2[0] );
+    P.apply( &d->out1[0], &d->out2[0], BENCH_BATCH, JULIAN_DAY_JD2000,
+             d->JD[i], alt, az );
+    palomar.get_hrz_from_equ_sidereal_time( alt, az, BENCH_BATCH,
+      sidereus::sidereal_time::get_mean( d->JD[i] ), &d->out1[0],
+      &d->out2[0] );
+    d->sink += d->out1[0];
+  }
+}
+
+// Galactic to horizontal as one matrix on unit vectors.
+static void bench_gal_hrz_frames( bench_data* d )
+{
+  sidereus::observer palomar( &site );
+
+  double* x = &d->out1[0];
+  double* y = &d->out2[0];
+  double* z = &d->out3[0];
+  double alt[BENCH_BATCH], az[BENCH_BATCH];
+
+  for( size_t i = 0; i + BENCH_BATCH <= d->JD.size(); i += BENCH_BATCH ) {
+    sidereus::rotation chain = sidereus::frames::get_hrz_from_equ( 
+      &palomar, sidereus::sidereal_time::get_mean( d->JD[i] )) *
+      sidereus::frames::get_precession( JULIAN_DAY_JD2000, d->JD[i] ) *
+      sidereus::frames::get_gal_from_equ2000().transpose();
+
+    sidereus::rotation::get_rect( &d->ra[i], &d->dec[i], BENCH_BATCH, 
+                                  x, y, z );
+    chain.apply( x, y, z, BENCH_BATCH );
+    sidereus::rotation::get_spherical( x, y, z, BENCH_BATCH, az, alt );
+    d->sink += alt[0];
+  }
+}
+
+// Galactic to horizontal as a compile time chain.
+static void bench_gal_hrz_chain( bench_data* d )
+{
+  typedef sidereus::transform_chain< sidereus::gal_to_equ2000,
+    sidereus::precess< sidereus::equinox_j2000, sidereus::equinox_date >,
+    sidereus::equ_to_hrz > chain;
+
+  sidereus::observer palomar( &site );
+
+  for( size_t i = 0; i + BENCH_BATCH <= d->JD.size(); i += BENCH_BATCH ) {
+    sidereus::epoch frame( d->JD[i] );
+
+    chain::apply( &d->ra[i], &d->dec[i], BENCH_BATCH, &d->out1[0], 
+                  &d->out2[0], &frame, &palomar );
+    d->sink += d->out2[0];
+  }
+}
+
+// Refraction, formula against table; declinations used as altitudes.
+static void bench_refraction_formula( bench_data* d )
+{
+  for( size_t i = 0; i < d->JD.size(); i++ ) {
+    d->sink += sidereus::refraction::get_saemundsson( d->dec[i] );
+  }
+}
+
+static void bench_refraction_table( bench_data* d )
+{
+  static const sidereus::refraction air;
+
+  for( size_t i = 0; i + BENCH_BATCH <= d->JD.size(); i += BENCH_BATCH ) {
+    air.get_apparent( &d->dec[i], BENCH_BATCH, &d->out1[0] );
+    d->sink += d->out1[0];
+  }
+}
+
+static const bench_case cases[] = {
+  { "julian_day::get_julian_day", bench_julian_day, false, 1 },
+  { "julian_day::get_julian_day[]", bench_julian_day_batch, false, 
+    BENCH_BATCH },
+  { "julian_day::get_date[]", bench_date_batch, false, BENCH_BATCH },
+  { "nutation", bench_nutation, true, 1 },
+  { "nutation::get[]", bench_nutation_batch, false, BENCH_BATCH },
+  { "nutation_table::get", bench_nutation_table, false, 1 },
+  { "sidereal_time::get_mean", bench_sidereal_mean, false, 1 },
+  { "sidereal_time::get_apparent", bench_sidereal_apparent, true, 1 },
+  { "nutation_table::get_apparent_sidereal", bench_sidereal_table,
+    false, 1 },
+  { "epoch", bench_epoch, true, 1 },
+  { "precession::get_equ_prec2", bench_precession, false, 1 },
+  { "precession::apply[]", bench_precession_batch, false, BENCH_BATCH },
+  { "apparent_place::get", bench_apparent_place, true, 1 },
+  { "apparent_place::get[]", bench_apparent_place_batch, true, 
+    BENCH_BATCH },
+  { "parallax::get", bench_parallax, true, 1 },
+  { "parallax::get_ha", bench_parallax_ha, false, 1 },
+  { "parallax::get_ha[]", bench_parallax_ha_batch, false, BENCH_BATCH },
+  { "refraction::get_saemundsson", bench_refraction_formula, false, 1 },
+  { "refraction::get_apparent[]", bench_refraction_table, false, 
+    BENCH_BATCH },
+  { "transform_coord::get_hrz_from_equ", bench_hrz_from_equ, false, 1 },
+  { "transform_coord::get_hrz_from_equ_sidereal_time",
+    bench_hrz_from_equ_sidereal_time, false, 1 },
+  { "transform_coord::get_hrz_from_equ[]", bench_hrz_from_equ_batch,
+    false, BENCH_BATCH },
+  { "observer::get_hrz_from_equ_sidereal_time",
+    bench_hrz_from_equ_observer, false, 1 },
+  { "observer::get_hrz_from_equ", bench_hrz_from_equ_observer_jd, 
+    false, 1 },
+  { "observer::get_hrz_track[]", bench_hrz_track, false, BENCH_BATCH },
+  { "transform_coord::get_equ_from_hrz", bench_equ_from_hrz, true, 1 },
+  { "transform_coord::get_equ_from_hrz[]", bench_equ_from_hrz_batch,
+    true, BENCH_BATCH },
+  { "transform_coord::get_equ_from_ecl", bench_equ_from_ecl, true, 1 },
+  { "transform_coord::get_ecl_from_equ", bench_ecl_from_equ, true, 1 },
+  { "transform_coord::get_ecl_from_rect", bench_ecl_from_rect, false, 1 },
+  { "transform_coord::get_equ_from_gal", bench_equ_from_gal, false, 1 },
+  { "transform_coord::get_equ2000_from_gal", bench_equ2000_from_gal,
+    false, 1 },
+  { "transform_coord::get_gal_from_equ", bench_gal_from_equ, false, 1 },
+  { "transform_coord::get_gal_from_equ2000", bench_gal_from_equ2000,
+    false, 1 },
+  { "transform_coord::get_gal_from_equ2000[]",
+    bench_gal_from_equ2000_batch, false, BENCH_BATCH },
+  { "transform_coord::get_equ2000_from_gal[]",
+    bench_equ2000_from_gal_batch, false, BENCH_BATCH },
+  { "gal->equ2000->equ->hrz[] (spherical)", bench_gal_hrz_spherical, 
+    false, BENCH_BATCH },
+  { "gal->hrz[] (frames)", bench_gal_hrz_frames, false, BENCH_BATCH },
+  { "gal->hrz[] (transform_chain)", bench_gal_hrz_chain, true, 
+    BENCH_BATCH }
+};
+
+/**
+ * One measurement.
+ */
+struct bench_result {
+  std::string name;   ///< Routine.
+  const char* cache;  ///< "cold", "warm" or "-".
+  unsigned threads;   ///< Threads.
+  double ns_per_call; ///< Wall time per object on each thread.
+  double per_second;  ///< Objects per second over all threads.
+};
+
+// Fill the inputs of a thread; warm runs use a single Julian day.
+static void make_data( bench_data* d, size_t calls, bool warm,
+ unsigned thread )
+{
+  d->JD.resize( calls );
+  d->ra.resize( calls );
+  d->dec.resize( calls );
+  d->out1.resize( BENCH_BATCH );
+  d->out2.resize( BENCH_BATCH );
+  d->out3.resize( BENCH_BATCH );
+  d->dates.resize( calls );
+  d->sink = 0.0;
+
+  for( size_t i = 0; i < calls; i++ ) {
+    // Each thread walks its own stretch of the span.
+    d->JD[i] = warm ? 2451545.0 : 2451545.0 + 
+               std::fmod(( thread * calls + i ) * BENCH_STEP, BENCH_SPAN );
+    d->ra[i] = std::fmod( i * 137.508, 360.0 );
+    d->dec[i] = std::fmod( i * 17.3, 170.0 ) - 85.0;
+    d->dates[i].years = 1900 + i % 200;
+    d->dates[i].months = 1 + i % 12;
+    d->dates[i].days = 1 + i % 28;
+    d->dates[i].hours = i % 24;
+    d->dates[i].minutes = i % 60;
+    d->dates[i].seconds = 0.5 * ( i % 120 );
+  }
+}
+
+static double now()
+{
+  return std::chrono::duration< double >(
+          std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+// Workers wait here, warm, until every one is ready.
+struct bench_barrier {
+  std::mutex lock;
+  std::condition_variable ready_changed, go_changed;
+  unsigned ready;
+  bool go;
+};
+
+// One untimed run fills the thread_local nutation and precession caches
+// of this thread, then the timed run starts with the others.
+static void run_thread( const bench_case* c, bench_data* d, 
+ bench_barrier* barrier )
+{
+  c->run( d );
+
+  {
+    std::unique_lock< std::mutex > hold( barrier->lock );
+
+    barrier->ready++;
+    barrier->ready_changed.notify_one();
+
+    while( !barrier->go ) {
+      barrier->go_changed.wait( hold );
+    }
+  }
+
+  c->run( d );
+}
+
+// Time a case on some threads, each warmed by an untimed run of its own.
+static bench_result measure( const bench_case* c, size_t calls,
+ bool warm, unsigned threads )
+{
+  std::vector< bench_data > data( threads );
+  std::vector< std::thread > workers;
+
+  bench_barrier barrier;
+  bench_result result;
+
+  double start = 0.0, wall = 0.0, objects = 0.0;
+
+  barrier.ready = 0;
+  barrier.go = false;
+
+  for( unsigned t = 0; t < threads; t++ ) {
+    make_data( &data[t], calls, warm, t );
+    workers.push_back( std::thread( run_thread, c, &data[t], &barrier ));
+  }
+
+  {
+    std::unique_lock< std::mutex > hold( barrier.lock );
+
+    while( barrier.ready < threads ) {
+      barrier.ready_changed.wait( hold );
+    }
+
+    start = now();
+    barrier.go = true;
+    barrier.go_changed.notify_all();
+  }
+
+  for( unsigned t = 0; t < threads; t++ ) {
+    workers[t].join();
+  }
+
+  wall = now() - start;
+
+  // Array routines process BENCH_BATCH objects per call.
+  objects = c->objects > 1 ? ( double )( calls / c->objects * c->objects )
+                           : ( double )calls;
+
+  result.name = c->name;
+  result.cache = c->nutation ? ( warm ? "warm" : "cold" ) : "-";
+  result.threads = threads;
+  result.ns_per_call = wall * 1e9 / objects;
+  result.per_second = objects * threads / wall;
+
+  return result;
+}
+
+static void print_text( const std::vector< bench_result >& results )
+{
+  std::fprintf( stdout, "%-50s %5s %7s %12s %14s\n", "routine", "cache",
+                "threads", "ns/call", "calls/s" );
+
+  for( size_t i = 0; i < results.size(); i++ ) {
+    const bench_result& r = results[i];
+
+    std::fprintf( stdout, "%-50s %5s %7u %12.1f %14.0f\n", r.name.c_str(),
+                  r.cache, r.threads, r.ns_per_call, r.per_second );
+  }
+}
+
+static void print_csv( const std::vector< bench_result >& results )
+{
+  std::fprintf( stdout, "routine,cache,threads,ns_per_call,calls_per_second\n" );
+
+  for( size_t i = 0; i < results.size(); i++ ) {
+    const bench_result& r = results[i];
+
+    std::fprintf( stdout, "%s,%s,%u,%.3f,%.0f\n", r.name.c_str(), r.cache,
+                  r.threads, r.ns_per_call, r.per_second );
+  }
+}
+
+static void print_json( const std::vector< bench_result >& results )
+{
+  std::fprintf( stdout, "[\n" );
+
+  for( size_t i = 0; i < results.size(); i++ ) {
+    const bench_result& r = results[i];
+
+    std::fprintf( stdout, "  { \"routine\": \"%s\", \"cache\": \"%s\", "
+                  "\"threads\": %u, \"ns_per_call\": %.3f, "
+                  "\"calls_per_second\": %.0f }%s\n", r.name.c_str(),
+                  r.cache, r.threads, r.ns_per_call, r.per_second,
+                  i + 1 < results.size() ? "," : "" );
+  }
+
+  std::fprintf( stdout, "]\n" );
+}
+
+int main( int argc, char* argv[] )
+{
+  std::string format = "text";
+
+  size_t calls = 16 * BENCH_BATCH;
+  unsigned threads = std::max( 1u, std::thread::hardware_concurrency() );
+
+  std::vector< bench_result > results;
+
+  for( int i = 1; i < argc; i++ ) {
+    if( std::strcmp( argv[i], "--csv" ) == 0 ) {
+      format = "csv";
+    } else if( std::strcmp( argv[i], "--json" ) == 0 ) {
+      format = "json";
+    } else if( std::strcmp( argv[i], "--calls" ) == 0 && i + 1 < argc ) {
+      calls = std::max( ( size_t )BENCH_BATCH,
+                        ( size_t )std::strtoul( argv[++i], 0, 10 ));
+    } else if( std::strcmp( argv[i], "--threads" ) == 0 && i + 1 < argc ) {
+      threads = std::max( 1ul, std::strtoul( argv[++i], 0, 10 ));
+    } else {
+      std::fprintf( stderr, "Usage: %s [--csv | --json] [--calls N] "
+                    "[--threads N]\n", argv[0] );
+      return 1;
+    }
+  }
+
+  // Span of the cold Julian days of every thread.
+  table.fit( 2451545.0, 2451545.0 + 
+             std::min( threads * calls * BENCH_STEP, BENCH_SPAN ));
+
+  for( size_t i = 0; i < sizeof( cases ) / sizeof( cases[0] ); i++ ) {
+    const bench_case* c = &cases[i];
+
+    results.push_back( measure( c, calls, false, 1 ));
+
+    if( c->nutation ) {
+      results.push_back( measure( c, calls, true, 1 ));
+    }
+
+    if( threads > 1 ) {
+      results.push_back( measure( c, calls, false, threads ));
+
+      if( c->nutation ) {
+        results.push_back( measure( c, calls, true, threads ));
+      }
+    }
+  }
+
+  if( format == "csv" ) {
+    print_csv( results );
+  } else if( format == "json" ) {
+    print_json( results );
+  } else {
+    print_text( results );
+  }
+
+  return 0;
+}
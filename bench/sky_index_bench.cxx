@@ -0,0 +1,91 @@
+/**
+ * @file
+ *
+ * Benchmark for horizon culling: every object of a catalog through 
+ * the horizontal transform against the visible cells of a sky index, 
+ * over a night of pointing updates.
+ *
+ * Usage: sky_index_bench [count] [level]
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/sky_index.hxx>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Pointing updates, one sidereal hour apart.
+#define BENCH_UPDATES 24
+
+static double now()
+{
+  return std::chrono::duration< double >( 
+          std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+int main( int argc, char* argv[] ) 
+{
+  size_t count = argc > 1 ? std::strtoul( argv[1], 0, 10 ) : 1000000;
+  int level = argc > 2 ? std::atoi( argv[2] ) : SKY_INDEX_LEVEL;
+
+  genesis::proto_geo::point_lon_lat_posn position = { -116.8630, 33.3561 };
+
+  std::vector< double > ra( count ), dec( count ), alt( count ), 
+                        az( count );
+  std::vector< double > visible_alt, visible_az;
+  std::vector< size_t > ids;
+
+  double start = 0.0, build = 0.0, full = 0.0, culled = 0.0;
+
+  size_t visible = 0;
+
+  sidereus::observer palomar( &position );
+  sidereus::sky_index index( level );
+
+  srand( 1 );
+
+  for( size_t i = 0; i < count; i++ ) {
+    ra[i] = 360.0 * rand() / ( RAND_MAX + 1.0 );
+    dec[i] = GEN_GEOMETRY_RADTODEG( std::asin( 2.0 * rand() / RAND_MAX - 
+                                               1.0 ));
+  }
+
+  start = now();
+  index.build( &ra[0], &dec[0], count );
+  build = now() - start;
+
+  for( int u = 0; u < BENCH_UPDATES; u++ ) {
+    start = now();
+    palomar.get_hrz_from_equ_sidereal_time( &ra[0], &dec[0], count, u, 
+                                            &alt[0], &az[0] );
+    full += now() - start;
+
+    start = now();
+    index.get_hrz( &palomar, u, 0.0, &ids, &visible_alt, &visible_az );
+    culled += now() - start;
+
+    visible += ids.size();
+  }
+
+  std::fprintf( stdout, "%zu objects, level %d, build %.1f ms\n", count, 
+                level, build * 1e3 );
+  std::fprintf( stdout, "Visible: %.1f%%\n", 
+                100.0 * visible / count / BENCH_UPDATES );
+  std::fprintf( stdout, "Full transform: %.2f ms per update\n", 
+                full * 1e3 / BENCH_UPDATES );
+  std::fprintf( stdout, "Culled transform: %.2f ms per update\n", 
+                culled * 1e3 / BENCH_UPDATES );
+  std::fprintf( stdout, "Speedup: %.2fx\n", full / culled );
+
+  return 0;
+}
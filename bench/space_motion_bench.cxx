@@ -0,0 +1,117 @@
+/**
+ * @file
+ *
+ * Scaling benchmark for catalog propagation from J2016 to the equator 
+ * and equinox of date, from one thread up to every hardware thread 
+ * (or --threads N).
+ *
+ * Usage: space_motion_bench [--count N] [--threads N]
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/space_motion.hxx>
+#include <sidereus/frames.hxx>
+#include <sidereus/julian_day.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// Runs per thread count, the best one is reported.
+#define BENCH_RUNS 3
+
+static double now()
+{
+  return std::chrono::duration< double >( 
+          std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+int main( int argc, char* argv[] ) 
+{
+  size_t count = 4 << 20;
+  unsigned threads = std::max( 1u, std::thread::hardware_concurrency() );
+
+  for( int i = 1; i < argc; i++ ) {
+    if( std::strcmp( argv[i], "--count" ) == 0 && i + 1 < argc ) {
+      count = std::strtoul( argv[++i], 0, 10 );
+    } else if( std::strcmp( argv[i], "--threads" ) == 0 && i + 1 < argc ) {
+      threads = std::max( 1ul, std::strtoul( argv[++i], 0, 10 ));
+    } else {
+      std::fprintf( stderr, "Usage: %s [--count N] [--threads N]\n", 
+                    argv[0] );
+      return 1;
+    }
+  }
+
+  std::vector< double > ra( count ), dec( count ), pmra( count ), 
+                        pmdec( count ), parallax( count ), rv( count ), 
+                        a( count ), d( count ), pa( count ), pd( count ), 
+                        p( count ), v( count );
+
+  double JD = 2461041.5;
+
+  sidereus::rotation P = sidereus::frames::get_precession( 
+                           JULIAN_DAY_JD2000, JD );
+
+  sidereus::astrometry_columns columns = { &a[0], &d[0], &pa[0], &pd[0], 
+                                           &p[0], &v[0] };
+
+  double single = 0.0;
+
+  for( size_t i = 0; i < count; i++ ) {
+    ra[i] = std::fmod( i * 137.508, 360.0 );
+    dec[i] = std::fmod( i * 17.3, 170.0 ) - 85.0;
+    pmra[i] = std::fmod( i * 7.1, 40.0 ) - 20.0;
+    pmdec[i] = std::fmod( i * 3.7, 40.0 ) - 20.0;
+    parallax[i] = 0.1 + std::fmod( i * 0.37, 5.0 );
+    rv[i] = std::fmod( i * 1.3, 100.0 ) - 50.0;
+  }
+
+  std::fprintf( stdout, "%zu stars\n", count );
+  std::fprintf( stdout, "%7s %10s %14s %8s %10s\n", "threads", "ms", 
+                "stars/s", "speedup", "efficiency" );
+
+  // Powers of two, then the requested count.
+  for( unsigned t = 1; t <= threads; t = t < threads ? 
+       std::min( 2 * t, threads ) : threads + 1 ) {
+    double best = 1e30;
+
+    for( int run = 0; run < BENCH_RUNS; run++ ) {
+      double start = 0.0;
+
+      std::copy( ra.begin(), ra.end(), a.begin() );
+      std::copy( dec.begin(), dec.end(), d.begin() );
+      std::copy( pmra.begin(), pmra.end(), pa.begin() );
+      std::copy( pmdec.begin(), pmdec.end(), pd.begin() );
+      std::copy( parallax.begin(), parallax.end(), p.begin() );
+      std::copy( rv.begin(), rv.end(), v.begin() );
+
+      start = now();
+      sidereus::space_motion::propagate( &columns, count, 
+                                         JULIAN_DAY_JD2016, JD, &P, t );
+      best = std::min( best, now() - start );
+    }
+
+    if( t == 1 ) {
+      single = best;
+    }
+
+    std::fprintf( stdout, "%7u %10.3f %14.0f %8.2f %9.0f%%\n", t, 
+                  best * 1e3, count / best, single / best, 
+                  100.0 * single / best / t );
+  }
+
+  return 0;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file
+ *
+ * Implementation for an apparent_place.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/apparent_place.hxx>
+#include <sidereus/precession.hxx>
+#include <sidereus/vector_math.hxx>
+
+#include <algorithm>
+#include <cmath>
+
+namespace sidereus {
+
+  apparent_place::apparent_place( const epoch* frame, double fromJD )
+  {
+    const nutation::nut& nutation = frame->get_nutation();
+
+    double T = frame->get_t();
+    double kappa = GEN_GEOMETRY_DEGTORAD( APPARENT_PLACE_ABERRATION / 
+                                          3600.0 );
+
+    double L0 = 0.0, M = 0.0, C = 0.0, sun = 0.0, e = 0.0, pi = 0.0,
+           x = 0.0, y = 0.0;
+
+    // Mean equator and equinox of date to true ones: to the mean 
+    // ecliptic, add the nutation in longitude, back to the true 
+    // equator.
+    rotation N = rotation::rotate_x( -nutation.ecliptic ) * 
+                 rotation::rotate_z( -nutation.longitude ) * 
+                 rotation::rotate_x( nutation.ecliptic - 
+                                     nutation.obliquity );
+
+    if( fromJD == JULIAN_DAY_JD2000 ) {
+      matrix_ = N * frame->get_precession();
+    } else {
+      matrix_ = N * precession::local().get( fromJD, frame->get_jd() );
+    }
+
+    // Geometric longitude of the Sun, equ 25.2 - 25.4.
+    L0 = 280.46646 + T * ( 36000.76983 + T * 0.0003032 );
+    M = GEN_GEOMETRY_DEGTORAD( 357.52911 + 
+                               T * ( 35999.05029 - T * 0.0001537 ));
+    C = ( 1.914602 - T * ( 0.004817 + T * 0.000014 )) * std::sin( M ) + 
+        ( 0.019993 - T * 0.000101 ) * std::sin( 2.0 * M ) + 
+        0.000289 * std::sin( 3.0 * M );
+    sun = GEN_GEOMETRY_DEGTORAD( L0 + C );
+
+    // Eccentricity of the Earth's orbit and longitude of perihelion, 
+    // equ 25.4 and page 151.
+    e = 0.016708634 - T * ( 0.000042037 + T * 0.0000001267 );
+    pi = GEN_GEOMETRY_DEGTORAD( 102.93735 + T * ( 1.71946 + T * 0.00046 ));
+
+    // Equ 23.3 is the first order change of a unit vector by this 
+    // velocity, in the ecliptic then turned to the true equator.
+    x = kappa * ( std::sin( sun ) - e * std::sin( pi ));
+    y = -kappa * ( std::cos( sun ) - e * std::cos( pi ));
+
+    vx_ = x;
+    vy_ = y * frame->get_cos_ecliptic();
+    vz_ = y * frame->get_sin_ecliptic();
+  }
+
+  const rotation& apparent_place::get_matrix() const
+  {
+    return matrix_;
+  }
+
+  void apparent_place::get_velocity( 
+   genesis::proto_geo::point_rect_coord* v ) const
+  {
+    v->x = vx_;
+    v->y = vy_;
+    v->z = vz_;
+  }
+
+  void apparent_place::get( genesis::proto_geo::point_equ_posn* mean,
+   genesis::proto_geo::point_equ_posn* position ) const
+  {
+    genesis::proto_geo::point_rect_coord v;
+
+    rotation::get_rect( mean->ra, mean->dec, &v );
+    matrix_.apply( &v, &v );
+
+    v.x += vx_;
+    v.y += vy_;
+    v.z += vz_;
+
+    rotation::get_spherical( &v, &position->ra, &position->dec );
+  }
+
+  void apparent_place::get( const double* ra, const double* dec, 
+   size_t count, double* out_ra, double* out_dec ) const
+  {
+    const double ( *m )[3] = matrix_.m;
+
+    double a[VECTOR_MATH_CHUNK], b[VECTOR_MATH_CHUNK],
+           sin_a[VECTOR_MATH_CHUNK], cos_a[VECTOR_MATH_CHUNK],
+           sin_b[VECTOR_MATH_CHUNK], cos_b[VECTOR_MATH_CHUNK],
+           x[VECTOR_MATH_CHUNK], y[VECTOR_MATH_CHUNK],
+           z[VECTOR_MATH_CHUNK], rho[VECTOR_MATH_CHUNK];
+
+    for( size_t first = 0; first < count; first += VECTOR_MATH_CHUNK ) {
+      size_t n = std::min( count - first, ( size_t )VECTOR_MATH_CHUNK );
+
+      for( size_t i = 0; i < n; i++ ) {
+        a[i] = GEN_GEOMETRY_DEGTORAD( ra[first + i] );
+        b[i] = GEN_GEOMETRY_DEGTORAD( dec[first + i] );
+      }
+
+      vector_math::sincos( a, sin_a, cos_a, n );
+      vector_math::sincos( b, sin_b, cos_b, n );
+
+      // Precession and nutation, then aberration. The sum need not be 
+      // normalized, atan2 only takes ratios.
+      for( size_t i = 0; i < n; i++ ) {
+        double vx = cos_b[i] * cos_a[i];
+        double vy = cos_b[i] * sin_a[i];
+        double vz = sin_b[i];
+
+        x[i] = m[0][0] * vx + m[0][1] * vy + m[0][2] * vz + vx_;
+        y[i] = m[1][0] * vx + m[1][1] * vy + m[1][2] * vz + vy_;
+        z[i] = m[2][0] * vx + m[2][1] * vy + m[2][2] * vz + vz_;
+        rho[i] = std::sqrt( x[i] * x[i] + y[i] * y[i] );
+      }
+
+      vector_math::atan2( y, x, a, n );
+      vector_math::atan2( z, rho, b, n );
+
+      for( size_t i = 0; i < n; i++ ) {
+        double right = GEN_GEOMETRY_RADTODEG( a[i] );
+
+        // Just below zero the sum rounds to 360, which is 0.
+        right += right < 0.0 ? 360.0 : 0.0;
+        out_ra[first + i] = right < 360.0 ? right : 0.0;
+        out_dec[first + i] = GEN_GEOMETRY_RADTODEG( b[i] );
+      }
+    }
+  }
+
+}
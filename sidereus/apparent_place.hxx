@@ -0,0 +1,109 @@
+/**
+ * @file
+ *
+ * Definitions for an apparent_place.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#ifndef SIDEREUS_APPARENT_PLACE_HPP
+#define SIDEREUS_APPARENT_PLACE_HPP
+
+#include <sidereus/epoch.hxx>
+#include <sidereus/julian_day.hxx>
+#include <sidereus/rotation.hxx>
+
+#include <genesis/geometry.hxx>
+
+#include <cstddef>
+
+namespace sidereus {
+  // Constant of aberration (arcsec).
+  #define APPARENT_PLACE_ABERRATION 20.49552
+
+  /**
+   * Sidereus Apparent Place.
+   *
+   * Mean to apparent place of stars at one epoch, Chapter 23: 
+   * precession from the catalog equinox, nutation and annual 
+   * aberration. Precession and nutation are combined into one matrix 
+   * and the aberration into the velocity of the Earth, both once at 
+   * construction, so a position costs a matrix product, a vector sum 
+   * and the conversions to and from rectangular coordinates. Proper 
+   * motion is not applied; positions must be mean places at the 
+   * epoch, referred to the catalog equinox.
+   */
+  class apparent_place {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param frame - Epoch of the apparent places.
+     * @param fromJD - Julian day of the catalog equinox.
+     */
+    explicit apparent_place( const epoch* frame, 
+                             double fromJD = JULIAN_DAY_JD2000 );
+
+    /**
+     * Destructor.
+     */
+    ~apparent_place() {};
+
+    /**
+     * Get the matrix from the mean equator and equinox of the catalog 
+     * to the true equator and equinox of the epoch.
+     *
+     * @return Precession and nutation rotation.
+     */
+    const rotation& get_matrix() const;
+
+    /**
+     * Get the velocity of the Earth, equ 23.3 in vector form.
+     *
+     * @param v - Pointer to store the velocity in units of the speed 
+     * of light, true equator and equinox of the epoch.
+     */
+    void get_velocity( genesis::proto_geo::point_rect_coord* v ) const;
+
+    /**
+     * Calculate the apparent place of a star.
+     *
+     * @param mean - Mean place at the catalog equinox.
+     * @param position - Pointer to store the apparent place.
+     */
+    void get( genesis::proto_geo::point_equ_posn* mean, 
+              genesis::proto_geo::point_equ_posn* position ) const;
+
+    /**
+     * Calculate the apparent places of arrays of stars.
+     *
+     * @param ra - Mean right ascensions (deg).
+     * @param dec - Mean declinations (deg).
+     * @param count - Number of stars.
+     * @param out_ra - Array to store apparent right ascensions (deg), 
+     * may be ra.
+     * @param out_dec - Array to store apparent declinations (deg), may 
+     * be dec.
+     */
+    void get( const double* ra, const double* dec, size_t count, 
+              double* out_ra, double* out_dec ) const;
+
+  private:
+    /// Precession and nutation.
+    rotation matrix_;
+
+    /// Velocity of the Earth (c).
+    double vx_;
+    double vy_;
+    double vz_;
+  };
+
+}
+
+#endif // SIDEREUS_APPARENT_PLACE_HPP
@@ -0,0 +1,120 @@
+/**
+ * @file
+ *
+ * Implementation for an catalog_reader.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/catalog_reader.hxx>
+
+#include <algorithm>
+#include <cstring>
+
+#include <sys/mman.h>
+
+namespace sidereus {
+
+  catalog_reader::catalog_reader()
+   : record_size_( CATALOG_RECORD_SIZE ), ra_offset_( 0 ), 
+     dec_offset_( 8 ), count_( 0 ), position_( 0 ), released_( 0 )
+  {
+  }
+
+  bool catalog_reader::open( const char* path, size_t record_size,
+   size_t ra_offset, size_t dec_offset )
+  {
+    close();
+
+    if( ra_offset + sizeof( double ) > record_size || 
+        dec_offset + sizeof( double ) > record_size ) {
+      return false;
+    }
+
+    if( !file_.open( path )) {
+      return false;
+    }
+
+    // A partial record means a truncated or foreign file.
+    if( file_.size() % record_size != 0 ) {
+      file_.close();
+      return false;
+    }
+
+    record_size_ = record_size;
+    ra_offset_ = ra_offset;
+    dec_offset_ = dec_offset;
+    count_ = file_.size() / record_size;
+
+    // Larger read ahead, and pages behind can go at once.
+    file_.advise( 0, file_.size(), MADV_SEQUENTIAL );
+
+    return true;
+  }
+
+  void catalog_reader::close()
+  {
+    file_.close();
+    count_ = 0;
+    position_ = 0;
+    released_ = 0;
+  }
+
+  bool catalog_reader::is_open() const
+  {
+    return file_.is_open();
+  }
+
+  size_t catalog_reader::get_count() const
+  {
+    return count_;
+  }
+
+  size_t catalog_reader::get_position() const
+  {
+    return position_;
+  }
+
+  const char* catalog_reader::get_record( size_t index ) const
+  {
+    return file_.data() + index * record_size_;
+  }
+
+  size_t catalog_reader::read( double* ra, double* dec, size_t max )
+  {
+    size_t n = std::min( max, count_ - position_ );
+
+    const char* record = get_record( position_ );
+
+    // Records need not be aligned, memcpy compiles to a plain load.
+    for( size_t i = 0; i < n; i++, record += record_size_ ) {
+      std::memcpy( &ra[i], record + ra_offset_, sizeof( double ));
+      std::memcpy( &dec[i], record + dec_offset_, sizeof( double ));
+    }
+
+    position_ += n;
+
+    // Keep the resident set bounded on catalogs larger than memory.
+    if( position_ * record_size_ - released_ >= CATALOG_RELEASE ) {
+      size_t end = position_ * record_size_;
+
+      file_.advise( released_, end - released_, MADV_DONTNEED );
+      released_ = end;
+    }
+
+    return n;
+  }
+
+  void catalog_reader::rewind()
+  {
+    position_ = 0;
+    released_ = 0;
+  }
+
+}
@@ -0,0 +1,143 @@
+/**
+ * @file
+ *
+ * Definitions for an catalog_reader.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#ifndef SIDEREUS_CATALOG_READER_HPP
+#define SIDEREUS_CATALOG_READER_HPP
+
+#include <sidereus/mapped_file.hxx>
+
+#include <cstddef>
+
+namespace sidereus {
+  // Default record: right ascension and declination doubles.
+  #define CATALOG_RECORD_SIZE 16
+
+  // Bytes read before the pages behind the cursor are dropped.
+  #define CATALOG_RELEASE ( 64 << 20 )
+
+  /**
+   * Sidereus Catalog Reader.
+   *
+   * Binary catalog of fixed size records holding right ascension and
+   * declination as native order doubles at fixed offsets, read 
+   * straight from a read only mapping of the file. read() gathers the 
+   * next records into the caller's column arrays, so a catalog of any 
+   * size goes through the transforms in chunks without a heap copy. 
+   * The kernel is told the file is read in order, and pages already 
+   * read are dropped as the cursor moves on.
+   */
+  class catalog_reader {
+  public:
+    /**
+     * Constructor.
+     */
+    catalog_reader();
+
+    /**
+     * Destructor.
+     */
+    ~catalog_reader() {};
+
+    /**
+     * Map a catalog, closing any previous one.
+     *
+     * @param path - File name.
+     * @param record_size - Bytes per record.
+     * @param ra_offset - Offset of the right ascension in a record.
+     * @param dec_offset - Offset of the declination in a record.
+     * @return False if the file can't be mapped, is not a whole 
+     * number of records or the offsets don't fit in a record.
+     */
+    bool open( const char* path, size_t record_size = CATALOG_RECORD_SIZE,
+               size_t ra_offset = 0, size_t dec_offset = 8 );
+
+    /**
+     * Release the mapping.
+     */
+    void close();
+
+    /**
+     * Check whether a catalog is mapped.
+     *
+     * @return True if mapped.
+     */
+    bool is_open() const;
+
+    /**
+     * Get the number of records.
+     *
+     * @return Records in the file.
+     */
+    size_t get_count() const;
+
+    /**
+     * Get the index of the next record read() returns.
+     *
+     * @return Record index.
+     */
+    size_t get_position() const;
+
+    /**
+     * Get a record in place.
+     *
+     * @param index - Record index, less than get_count().
+     * @return First byte of the record, inside the mapping.
+     */
+    const char* get_record( size_t index ) const;
+
+    /**
+     * Read the next records.
+     *
+     * @param ra - Array to store right ascensions (deg).
+     * @param dec - Array to store declinations (deg).
+     * @param max - Size of the arrays.
+     * @return Records read, 0 at the end of the catalog.
+     */
+    size_t read( double* ra, double* dec, size_t max );
+
+    /**
+     * Go back to the first record.
+     */
+    void rewind();
+
+  private:
+    /// Not copyable, the mapping has a single owner.
+    catalog_reader( const catalog_reader& );
+    catalog_reader& operator=( const catalog_reader& );
+
+    /// Mapped catalog.
+    mapped_file file_;
+
+    /// Bytes per record.
+    size_t record_size_;
+
+    /// Offset of the right ascension.
+    size_t ra_offset_;
+
+    /// Offset of the declination.
+    size_t dec_offset_;
+
+    /// Number of records.
+    size_t count_;
+
+    /// Next record.
+    size_t position_;
+
+    /// Bytes before this offset were dropped.
+    size_t released_;
+  };
+
+}
+
+#endif // SIDEREUS_CATALOG_READER_HPP
@@ -0,0 +1,115 @@
+/**
+ * @file
+ *
+ * Implementation for an epoch.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/epoch.hxx>
+#include <sidereus/precession.hxx>
+#include <sidereus/sidereal_time.hxx>
+
+namespace sidereus {
+
+  epoch::epoch( double JD )
+   : JD_( JD ), date_( JD )
+  {
+    compute( &nutation_cache::local() );
+  }
+
+  epoch::epoch( double JD, nutation_cache* cache )
+   : JD_( JD ), date_( JD )
+  {
+    compute( cache );
+  }
+
+  epoch::epoch( julian_date JD )
+   : JD_( JD.get_jd() ), date_( JD )
+  {
+    compute( &nutation_cache::local() );
+  }
+
+  epoch::epoch( julian_date JD, nutation_cache* cache )
+   : JD_( JD.get_jd() ), date_( JD )
+  {
+    compute( cache );
+  }
+
+  void epoch::compute( nutation_cache* cache )
+  {
+    double ecliptic = 0.0;
+
+    JDE_ = genesis::dynamical_time().get_jde( JD_ );
+    T_ = ( JDE_ - JULIAN_DAY_JD2000 ) / 36525.0;
+
+    // Nutation is stored in the cache, so the apparent sidereal time 
+    // does not run the series again.
+    sidereus::nutation( JD_, &nutation_, cache );
+    mean_sidereal_ = sidereal_time::get_mean( date_ );
+    apparent_sidereal_ = sidereal_time::get_apparent( date_, cache );
+
+    ecliptic = GEN_GEOMETRY_DEGTORAD( nutation_.ecliptic );
+    sin_ecliptic_ = std::sin( ecliptic );
+    cos_ecliptic_ = std::cos( ecliptic );
+
+    precession::get_matrix( JULIAN_DAY_JD2000, JD_, &precession_ );
+  }
+
+  double epoch::get_jd() const
+  {
+    return JD_;
+  }
+
+  julian_date epoch::get_date() const
+  {
+    return date_;
+  }
+
+  double epoch::get_jde() const
+  {
+    return JDE_;
+  }
+
+  double epoch::get_t() const
+  {
+    return T_;
+  }
+
+  double epoch::get_mean_sidereal() const
+  {
+    return mean_sidereal_;
+  }
+
+  double epoch::get_apparent_sidereal() const
+  {
+    return apparent_sidereal_;
+  }
+
+  const nutation::nut& epoch::get_nutation() const
+  {
+    return nutation_;
+  }
+
+  double epoch::get_sin_ecliptic() const
+  {
+    return sin_ecliptic_;
+  }
+
+  double epoch::get_cos_ecliptic() const
+  {
+    return cos_ecliptic_;
+  }
+
+  const rotation& epoch::get_precession() const
+  {
+    return precession_;
+  }
+
+}
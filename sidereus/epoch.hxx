@@ -0,0 +1,187 @@
+/**
+ * @file
+ *
+ * Definitions for an epoch.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#ifndef SIDEREUS_EPOCH_HPP
+#define SIDEREUS_EPOCH_HPP
+
+#include <sidereus/nutation.hxx>
+#include <sidereus/rotation.hxx>
+
+namespace sidereus {
+  /**
+   * Sidereus Epoch.
+   *
+   * Everything the transforms need that only depends on the instant:
+   * Julian ephemeris day, sidereal times, nutation, true obliquity and
+   * the precession matrix from J2000. It is computed once at 
+   * construction and never changes, so a frame can be shared between 
+   * threads and passed to every transform at that instant in place 
+   * of a Julian day.
+   */
+  class epoch {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param JD - Julian day.
+     */
+    explicit epoch( double JD );
+
+    /**
+     * Constructor.
+     *
+     * Same as above, but takes nutation from a caller owned cache.
+     *
+     * @param JD - Julian day.
+     * @param cache - Nutation cache.
+     */
+    epoch( double JD, nutation_cache* cache );
+
+    /**
+     * Constructor.
+     *
+     * Same as above for a two part Julian date, the sidereal times 
+     * keep its precision.
+     *
+     * @param JD - Julian date.
+     */
+    explicit epoch( julian_date JD );
+
+    /**
+     * Constructor.
+     *
+     * @param JD - Julian date.
+     * @param cache - Nutation cache.
+     */
+    epoch( julian_date JD, nutation_cache* cache );
+
+    /**
+     * Destructor.
+     */
+    ~epoch() {};
+
+    /**
+     * Get the Julian day.
+     *
+     * @return Julian day.
+     */
+    double get_jd() const;
+
+    /**
+     * Get the two part Julian date.
+     *
+     * @return Julian date.
+     */
+    julian_date get_date() const;
+
+    /**
+     * Get the Julian ephemeris day.
+     *
+     * @return Julian ephemeris day.
+     */
+    double get_jde() const;
+
+    /**
+     * Get the time from J2000.
+     *
+     * @return Julian centuries of ephemeris time.
+     */
+    double get_t() const;
+
+    /**
+     * Get the mean sidereal time at Greenwich.
+     *
+     * @return Mean sidereal time (hours).
+     */
+    double get_mean_sidereal() const;
+
+    /**
+     * Get the apparent sidereal time at Greenwich.
+     *
+     * @return Apparent sidereal time (hours).
+     */
+    double get_apparent_sidereal() const;
+
+    /**
+     * Get nutation in longitude, obliquity and the true obliquity
+     * of the ecliptic.
+     *
+     * @return Nutation (deg).
+     */
+    const nutation::nut& get_nutation() const;
+
+    /**
+     * Get sine of the true obliquity of the ecliptic.
+     *
+     * @return Sine.
+     */
+    double get_sin_ecliptic() const;
+
+    /**
+     * Get cosine of the true obliquity of the ecliptic.
+     *
+     * @return Cosine.
+     */
+    double get_cos_ecliptic() const;
+
+    /**
+     * Get the matrix that precesses J2000 equatorial coordinates to 
+     * this epoch.
+     *
+     * @return Precession rotation.
+     */
+    const rotation& get_precession() const;
+
+  private:
+    /**
+     * Compute every quantity.
+     *
+     * @param cache - Nutation cache.
+     */
+    void compute( nutation_cache* cache );
+
+    /// Julian day.
+    double JD_;
+
+    /// Julian day in two parts.
+    julian_date date_;
+
+    /// Julian ephemeris day.
+    double JDE_;
+
+    /// Julian centuries from J2000.
+    double T_;
+
+    /// Mean sidereal time (hours).
+    double mean_sidereal_;
+
+    /// Apparent sidereal time (hours).
+    double apparent_sidereal_;
+
+    /// Nutation.
+    nutation::nut nutation_;
+
+    /// Sine of true obliquity.
+    double sin_ecliptic_;
+
+    /// Cosine of true obliquity.
+    double cos_ecliptic_;
+
+    /// Precession from J2000.
+    rotation precession_;
+  };
+
+}
+
+#endif // SIDEREUS_EPOCH_HPP
@@ -0,0 +1,94 @@
+/**
+ * @file
+ *
+ * Implementation for an frames.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/frames.hxx>
+#include <sidereus/julian_day.hxx>
+#include <sidereus/precession.hxx>
+
+namespace sidereus {
+
+/**
+ * This namespace works as if anything inside it were declared
+ * staticaly in each source file.
+ */
+namespace {
+
+  // Galactic from B1950 equatorial coordinates: galactic pole at 
+  // ra 192.25, dec 27.4 and celestial pole at galactic longitude 123,
+  // i.e. frame rotations z( 192.25 ), y( 90 - 27.4 ), z( 57 ).
+  constexpr rotation GAL_FROM_B1950( 
+    -0.06698873941515085, -0.87275576585199266, -0.48353891463218424,
+    0.49272846607532361, -0.45034695801996133, 0.74458463328303115,
+    -0.86760081115143484, -0.18837460172292037, 0.46019978478385171 );
+
+  // Hour angle frame from the frame of the local sidereal time: y 
+  // turns to the west, the way hour angles grow.
+  constexpr rotation FLIP_Y( 1.0, 0.0, 0.0, 
+                             0.0, -1.0, 0.0, 
+                             0.0, 0.0, 1.0 );
+
+  rotation make_gal_from_equ2000()
+  {
+    rotation matrix;
+
+    sidereus::precession::get_matrix( JULIAN_DAY_JD2000, JULIAN_DAY_B1950,
+                                      &matrix );
+
+    return GAL_FROM_B1950 * matrix;
+  }
+}
+
+  const rotation& frames::get_gal_from_b1950()
+  {
+    return GAL_FROM_B1950;
+  }
+
+  const rotation& frames::get_gal_from_equ2000()
+  {
+    // Built once.
+    static const rotation matrix = make_gal_from_equ2000();
+
+    return matrix;
+  }
+
+  rotation frames::get_precession( double fromJD, double toJD )
+  {
+    return precession::local().get( fromJD, toJD );
+  }
+
+  rotation frames::get_ecl_from_equ( const epoch* frame )
+  {
+    return rotation::rotate_x( frame->get_nutation().ecliptic );
+  }
+
+  rotation frames::get_hrz_from_equ( const observer* site, 
+   double sidereal )
+  {
+    genesis::proto_geo::point_lon_lat_posn position;
+
+    site->get_position( &position );
+
+    // x to the meridian at the local sidereal time, y west, then tilt 
+    // the pole down to the zenith; TC 6.8d.
+    return rotation::rotate_y( 90.0 - position.lat ) * FLIP_Y * 
+           rotation::rotate_z( sidereal * 15.0 + position.lon );
+  }
+
+  rotation frames::get_hrz_from_equ( const observer* site, 
+   const epoch* frame )
+  {
+    return get_hrz_from_equ( site, frame->get_mean_sidereal() );
+  }
+
+}
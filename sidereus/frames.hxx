@@ -0,0 +1,97 @@
+/**
+ * @file
+ *
+ * Definitions for an frames.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#ifndef SIDEREUS_FRAMES_HPP
+#define SIDEREUS_FRAMES_HPP
+
+#include <sidereus/epoch.hxx>
+#include <sidereus/observer.hxx>
+#include <sidereus/rotation.hxx>
+
+namespace sidereus {
+  /**
+   * Sidereus Frames.
+   *
+   * Matrices between the coordinate frames of the library, for work 
+   * on rectangular unit vectors: compose the matrices of a chain of 
+   * transforms once with rotation::operator*, then apply the product 
+   * to each point, and only convert back to angles at the end. A 
+   * chain costs one matrix product per point instead of trigonometry 
+   * at every stage.
+   *
+   * The horizontal frame has azimuth west from south, so it is left 
+   * handed and its matrices hold a reflection; they compose and apply 
+   * like the others, but their inverse is still the transpose.
+   */
+  class frames {
+  public:
+    /**
+     * Get the galactic from B1950 equatorial matrix.
+     *
+     * @return Matrix.
+     */
+    static const rotation& get_gal_from_b1950();
+
+    /**
+     * Get the galactic from J2000 equatorial matrix, with the 
+     * precession from J2000 to B1950 included.
+     *
+     * @return Matrix.
+     */
+    static const rotation& get_gal_from_equ2000();
+
+    /**
+     * Get the precession matrix between two equinoxes.
+     *
+     * @param fromJD - Julian Day of the equinox of the input.
+     * @param toJD - Julian Day of the equinox of the output.
+     * @return Matrix.
+     */
+    static rotation get_precession( double fromJD, double toJD );
+
+    /**
+     * Get the ecliptical from equatorial matrix of an epoch, using 
+     * the true obliquity.
+     *
+     * @param frame - Epoch.
+     * @return Matrix.
+     */
+    static rotation get_ecl_from_equ( const epoch* frame );
+
+    /**
+     * Get the horizontal from equatorial matrix of an observer.
+     *
+     * @param site - Observer.
+     * @param sidereal - Sidereal Time (hours).
+     * @return Matrix, azimuth west from south.
+     */
+    static rotation get_hrz_from_equ( const observer* site, 
+                                      double sidereal );
+
+    /**
+     * Get the horizontal from equatorial matrix of an observer at the 
+     * instant of an epoch, using mean sidereal time like 
+     * observer::get_hrz_from_equ().
+     *
+     * @param site - Observer.
+     * @param frame - Epoch.
+     * @return Matrix, azimuth west from south.
+     */
+    static rotation get_hrz_from_equ( const observer* site, 
+                                      const epoch* frame );
+  };
+
+}
+
+#endif // SIDEREUS_FRAMES_HPP
@@ -0,0 +1,81 @@
+/**
+ * @file
+ *
+ * Implementation for an julian_date.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/julian_date.hxx>
+
+#include <cmath>
+
+namespace sidereus {
+
+  julian_date::julian_date()
+   : day_( 0.0 ), fraction_( 0.0 )
+  {
+  }
+
+  julian_date::julian_date( double JD )
+  {
+    // Both the floor and the difference are exact.
+    day_ = std::floor( JD );
+    fraction_ = JD - day_;
+  }
+
+  julian_date::julian_date( double day, double fraction )
+  {
+    double whole = std::floor( day );
+    double rest = 0.0;
+
+    // day - whole is exact, so only the sum with the fraction rounds,
+    // at the precision of the fraction.
+    fraction += day - whole;
+    rest = std::floor( fraction );
+
+    day_ = whole + rest;
+    fraction_ = fraction - rest;
+
+    // A tiny negative fraction can round up to 1.
+    if( fraction_ >= 1.0 ) {
+      day_ += 1.0;
+      fraction_ -= 1.0;
+    }
+  }
+
+  double julian_date::get_day() const
+  {
+    return day_;
+  }
+
+  double julian_date::get_fraction() const
+  {
+    return fraction_;
+  }
+
+  double julian_date::get_jd() const
+  {
+    return day_ + fraction_;
+  }
+
+  julian_date julian_date::operator+( double days ) const
+  {
+    double whole = std::floor( days );
+
+    // Whole days add exactly, the fraction keeps its precision.
+    return julian_date( day_ + whole, fraction_ + ( days - whole ));
+  }
+
+  double julian_date::operator-( const julian_date& JD ) const
+  {
+    return ( day_ - JD.day_ ) + ( fraction_ - JD.fraction_ );
+  }
+
+}
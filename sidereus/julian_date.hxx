@@ -0,0 +1,99 @@
+/**
+ * @file
+ *
+ * Definitions for an julian_date.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#ifndef SIDEREUS_JULIAN_DATE_HPP
+#define SIDEREUS_JULIAN_DATE_HPP
+
+namespace sidereus {
+  /**
+   * Sidereus Julian Date.
+   *
+   * Julian day in two parts, a whole number of days (noon to noon) 
+   * and the fraction of the day in [0, 1). A single double resolves 
+   * about 40 microseconds near the present Julian day; the fraction 
+   * alone resolves picoseconds, and differences of whole days are 
+   * exact, so time arguments keep their precision in plain doubles.
+   */
+  class julian_date {
+  public:
+    /**
+     * Constructor.
+     *
+     * Julian day 0.
+     */
+    julian_date();
+
+    /**
+     * Constructor.
+     *
+     * @param JD - Julian day, split exactly.
+     */
+    explicit julian_date( double JD );
+
+    /**
+     * Constructor.
+     *
+     * @param day - Days, need not be whole.
+     * @param fraction - Fraction of a day, may be any size or sign.
+     */
+    julian_date( double day, double fraction );
+
+    /**
+     * Get the whole days.
+     *
+     * @return Days, a whole number.
+     */
+    double get_day() const;
+
+    /**
+     * Get the fraction of the day.
+     *
+     * @return Fraction in [0, 1).
+     */
+    double get_fraction() const;
+
+    /**
+     * Get the Julian day as a single number, rounded.
+     *
+     * @return Julian day.
+     */
+    double get_jd() const;
+
+    /**
+     * Add a time.
+     *
+     * @param days - Days, e.g. seconds / 86400.
+     * @return Julian date.
+     */
+    julian_date operator+( double days ) const;
+
+    /**
+     * Get the time from another date.
+     *
+     * @param JD - Julian date.
+     * @return Days from JD to this date.
+     */
+    double operator-( const julian_date& JD ) const;
+
+  private:
+    /// Whole days.
+    double day_;
+
+    /// Fraction of the day.
+    double fraction_;
+  };
+
+}
+
+#endif // SIDEREUS_JULIAN_DATE_HPP
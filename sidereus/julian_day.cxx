@@ -13,55 +13,127 @@
  */
 
 #include <sidereus/julian_day.hxx>
- 
-#include <cstring>
+#include <sidereus/vector_math.hxx>
+
+#include <algorithm>
 
 namespace sidereus {
 
+  // This namespace works as if anything inside it were declared
+  // staticaly in each source file.
+  namespace {
+    // First day of the Gregorian calendar, 15 October 1582, as 
+    // years * 512 + months * 32 + days.
+    const int GREGORIAN_START = 1582 * 512 + 10 * 32 + 15;
+
+    // Julian Day Number of the noon of a calendar day. Comparisons 
+    // give 0 or 1 instead of branching, and the divisions by 
+    // constants become multiplies, so the batch loop vectorizes.
+    inline int get_day_number( int years, int months, int days )
+    {
+      // January and February count as months 13 and 14 of the year 
+      // before.
+      int shift = months < 3;
+      int year = years - shift;
+      int month = months + 12 * shift;
+
+      int gregorian = years * 512 + months * 32 + days >= GREGORIAN_START;
+      int century = year / 100;
+
+      // 1461 / 4 = 365.25 days a year and 153 / 5 = 30.6 days a 
+      // month, exact where Meeus truncates floating point products.
+      return ( 1461 * ( year + 4716 )) / 4 + ( 153 * ( month + 1 )) / 5 + 
+             days + gregorian * ( 2 - century + century / 4 ) - 1524;
+    }
+
+    // Fraction of a day of the time of a date.
+    inline double get_day_fraction( const genesis::proto_datetime::date* 
+     date )
+    {
+      return date->hours / 24.0 + date->minutes / 1440.0 + 
+             date->seconds / 86400.0;
+    }
+
+    // Calendar date of a Julian Day, Meeus chapter 7 in integers.
+    inline void get_calendar( double JD, genesis::proto_datetime::date* 
+     date )
+    {
+      double shifted = JD + 0.5;
+
+      int number = ( int )shifted;
+      int gregorian = number >= 2299161;
+
+      // Gregorian correction, ( Z - 1867216.25 ) / 36524.25.
+      int alpha = ( 4 * number - 7468865 ) / 146097;
+      int b = number + gregorian * ( 1 + alpha - alpha / 4 ) + 1524;
+
+      // ( B - 122.1 ) / 365.25 and ( B - D ) / 30.6001.
+      int c = ( 20 * b - 2442 ) / 7305;
+      int d = ( 1461 * c ) / 4;
+      int e = ( 10000 * ( b - d )) / 306001;
+
+      double fraction = shifted - number;
+
+      date->days = b - d - ( 306001 * e ) / 10000;
+      date->months = e - 1 - 12 * ( e >= 14 );
+      date->years = c - 4715 - ( date->months > 2 );
+
+      date->hours = ( int )( fraction * 24 );
+      fraction -= date->hours / 24.0;
+      date->minutes = ( int )( fraction * 1440 );
+      fraction -= date->minutes / 1440.0;
+      date->seconds = fraction * 86400;
+    }
+  }
+
   double julian_day::get_julian_day( genesis::proto_datetime::date* date )
   {
     double JD = 0.0;
-    double days = 0.0;
-    
-    volatile register int a asm ("eax");
-    volatile register int b asm ("eax");
-    a = 0; b= 0; 
 
-    // Ruct date local_date.
-    genesis::proto_datetime::date local_date;
-		
-    // Create local copy.
-    std::memcpy( &local_date, date, sizeof( genesis::proto_datetime::date ) );
-		
-    // Check for month = January or February.
-    if( local_date.months < 3 ) {
-      local_date.years--;
-      local_date.months += 12;
+    get_julian_day( date, 1, &JD );
+
+    return JD;
+  }
+
+  julian_date julian_day::get_julian_date( 
+   genesis::proto_datetime::date* date )
+  {
+    // The Julian Day of midnight is exact, the time of day is added 
+    // as a fraction.
+    return julian_date( get_day_number( date->years, date->months, 
+                                        date->days ) - 0.5, 
+                        get_day_fraction( date ));
+  }
+
+  void julian_day::get_julian_day( const genesis::proto_datetime::date* 
+   dates, size_t count, double* JD )
+  {
+    int number[VECTOR_MATH_CHUNK];
+
+    // Integer and floating point parts in separate loops, each one 
+    // vectorizes on its own.
+    for( size_t first = 0; first < count; first += VECTOR_MATH_CHUNK ) {
+      size_t n = std::min( count - first, ( size_t )VECTOR_MATH_CHUNK );
+
+      const genesis::proto_datetime::date* date = dates + first;
+
+      for( size_t i = 0; i < n; i++ ) {
+        number[i] = get_day_number( date[i].years, date[i].months, 
+                                    date[i].days );
+      }
+
+      for( size_t i = 0; i < n; i++ ) {
+        JD[first + i] = number[i] - 0.5 + get_day_fraction( &date[i] );
+      }
     }
-	
-    a = local_date.years / 100;
-	
-    // Check for Julian or Gregorian calendar (starts Oct 4th 1582).
-    if( local_date.years > 1582 || 
-         ( local_date.years == 1582 && ( local_date.months > 10 || 
-         ( local_date.months == 10 && local_date.days >= 4 )) )) {
-      // Gregorian calendar.
-      b = 2 - a + (a / 4);
-    } else {
-      // Julian calendar.
-      b = 0;
+  }
+
+  void julian_day::get_date( const double* JD, size_t count, 
+   genesis::proto_datetime::date* dates )
+  {
+    for( size_t i = 0; i < count; i++ ) {
+      get_calendar( JD[i], &dates[i] );
     }
-	
-    // Add a fraction of hours, minutes and secs to days.
-    days = local_date.days + ( double )( local_date.hours / 24.0 ) + 
-                             ( double )( local_date.minutes / 1440.0 ) + 
-                             ( double )( local_date.seconds / 86400.0 );
-
-    // Now get the JD.
-    JD = ( int )( 365.25 * ( local_date.years + 4716 )) + 
-         ( int )( 30.6001 * ( local_date.months + 1 )) + days + b - 1524.5;
-	
-    return JD;
   }
 
   size_t julian_day::get_day_of_week( genesis::proto_datetime::date* date )
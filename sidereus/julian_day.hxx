@@ -15,6 +15,8 @@
 #ifndef SIDEREUS_JULIAN_DAY_HPP
 #define SIDEREUS_JULIAN_DAY_HPP
 
+#include <sidereus/julian_date.hxx>
+
 #include <genesis/calendar.hxx>
 #include <genesis/datetime.hxx>
 
@@ -34,15 +36,52 @@ namespace sidereus {
      */ 
     ~julian_day() {};
 
+    /// Single date version, not hidden by the array one below.
+    using genesis::datetime::get_date;
+
     /**
      * Calculate the Julian Day from a calendar day.
      * Valid for positive and negative years but not for negative JD.
+     * Gregorian calendar from 15 October 1582, Julian before.
      *
      * @param date - Date required.
      * @return Julian date.
      */ 
     double get_julian_day( genesis::proto_datetime::date* date );
 
+    /**
+     * Calculate the Julian Day from a calendar day, keeping the time 
+     * of day apart from the day so seconds keep their precision.
+     *
+     * @param date - Date required.
+     * @return Two part Julian date.
+     */ 
+    julian_date get_julian_date( genesis::proto_datetime::date* date );
+
+    /**
+     * Calculate the Julian Days of an array of calendar dates.
+     *
+     * Integer arithmetic without branches, so the loop vectorizes; 
+     * same results and range as the single date version.
+     *
+     * @param dates - Dates.
+     * @param count - Number of dates.
+     * @param JD - Array to store Julian Days.
+     */ 
+    static void get_julian_day( const genesis::proto_datetime::date* dates,
+                                size_t count, double* JD );
+
+    /**
+     * Calculate the calendar dates of an array of Julian Days, the 
+     * inverse of the above. Not valid for negative JD.
+     *
+     * @param JD - Julian Days.
+     * @param count - Number of days.
+     * @param dates - Array to store dates.
+     */ 
+    static void get_date( const double* JD, size_t count, 
+                          genesis::proto_datetime::date* dates );
+
     /**
      * Calculate the day of the week. 
      * Returns 0 = Sunday .. 6 = Saturday.
@@ -109,6 +148,7 @@ namespace sidereus {
 
 // 1.1.2000 Julian Day & others.
 #define JULIAN_DAY_JD2000 2451545.0
+#define JULIAN_DAY_JD2016 2457389.0
 #define JULIAN_DAY_JD2050 2469807.50
 
 #define JULIAN_DAY_B1900 2415020.3135
@@ -0,0 +1,117 @@
+/**
+ * @file
+ *
+ * Implementation for an mapped_file.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/mapped_file.hxx>
+
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sidereus {
+
+  mapped_file::mapped_file()
+   : data_( NULL ), size_( 0 ), open_( false )
+  {
+  }
+
+  mapped_file::~mapped_file()
+  {
+    close();
+  }
+
+  bool mapped_file::open( const char* path )
+  {
+    struct stat info;
+
+    close();
+
+    int fd = ::open( path, O_RDONLY );
+
+    if( fd < 0 ) {
+      return false;
+    }
+
+    if( fstat( fd, &info ) != 0 || info.st_size < 0 ) {
+      ::close( fd );
+      return false;
+    }
+
+    // Nothing to map, but the file is open all the same.
+    if( info.st_size == 0 ) {
+      ::close( fd );
+      open_ = true;
+      return true;
+    }
+
+    void* data = mmap( NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+
+    // The mapping keeps its own reference to the file.
+    ::close( fd );
+
+    if( data == MAP_FAILED ) {
+      return false;
+    }
+
+    data_ = data;
+    size_ = info.st_size;
+    open_ = true;
+
+    return true;
+  }
+
+  void mapped_file::close()
+  {
+    if( data_ != NULL ) {
+      munmap( data_, size_ );
+    }
+
+    data_ = NULL;
+    size_ = 0;
+    open_ = false;
+  }
+
+  bool mapped_file::is_open() const
+  {
+    return open_;
+  }
+
+  const char* mapped_file::data() const
+  {
+    return static_cast< const char* >( data_ );
+  }
+
+  size_t mapped_file::size() const
+  {
+    return size_;
+  }
+
+  bool mapped_file::advise( size_t offset, size_t length, int advice ) const
+  {
+    size_t page = ( size_t )sysconf( _SC_PAGESIZE );
+    size_t first = offset - offset % page;
+
+    if( data_ == NULL || offset >= size_ ) {
+      return false;
+    }
+
+    length = std::min( length + offset - first, size_ - first );
+
+    return madvise( static_cast< char* >( data_ ) + first, length, 
+                    advice ) == 0;
+  }
+
+}
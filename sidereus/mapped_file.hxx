@@ -0,0 +1,104 @@
+/**
+ * @file
+ *
+ * Definitions for an mapped_file.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#ifndef SIDEREUS_MAPPED_FILE_HPP
+#define SIDEREUS_MAPPED_FILE_HPP
+
+#include <cstddef>
+
+namespace sidereus {
+  /**
+   * Sidereus Mapped File.
+   *
+   * Read only, shared memory mapping of a whole file. Pages come 
+   * straight from the page cache, so every process mapping the same 
+   * file shares them and nothing is parsed or copied. The mapping is 
+   * released by close() or the destructor. An empty file opens with 
+   * no memory mapped and a size of 0.
+   */
+  class mapped_file {
+  public:
+    /**
+     * Constructor.
+     */
+    mapped_file();
+
+    /**
+     * Destructor.
+     */
+    ~mapped_file();
+
+    /**
+     * Map a file, closing any previous mapping.
+     *
+     * @param path - File name.
+     * @return False if the file could not be opened or mapped.
+     */
+    bool open( const char* path );
+
+    /**
+     * Release the mapping.
+     */
+    void close();
+
+    /**
+     * Check whether a file is mapped.
+     *
+     * @return True if mapped.
+     */
+    bool is_open() const;
+
+    /**
+     * Get the first byte of the file.
+     *
+     * @return Mapped memory, NULL if nothing is mapped or the file is 
+     * empty.
+     */
+    const char* data() const;
+
+    /**
+     * Get the file size.
+     *
+     * @return Size in bytes.
+     */
+    size_t size() const;
+
+    /**
+     * Tell the kernel how a range of the file will be used.
+     *
+     * @param offset - First byte, rounded down to a page.
+     * @param length - Number of bytes.
+     * @param advice - madvise() advice, e.g. MADV_SEQUENTIAL.
+     * @return False if nothing is mapped or the advice was refused.
+     */
+    bool advise( size_t offset, size_t length, int advice ) const;
+
+  private:
+    /// Not copyable, the mapping has a single owner.
+    mapped_file( const mapped_file& );
+    mapped_file& operator=( const mapped_file& );
+
+    /// Mapped memory.
+    void* data_;
+
+    /// Size in bytes.
+    size_t size_;
+
+    /// True between a successful open() and close().
+    bool open_;
+  };
+
+}
+
+#endif // SIDEREUS_MAPPED_FILE_HPP
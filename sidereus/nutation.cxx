@@ -13,11 +13,12 @@
  */
 
 #include <sidereus/nutation.hxx>
+#include <sidereus/vector_math.hxx>
 
+#include <algorithm>
 #include <cmath>
 
 static const int NUTATION_TERMS = 63;
-static const double NUTATION_EPOCH_THRESHOLD = 0.1;
 
 namespace sidereus {
 
@@ -168,102 +169,247 @@ namespace sidereus {
     {-3.0,	0.0,	0.0,	0.0}
   };
 
-  // Cache values.
-  static long double c_JD = 0.0, c_longitude = 0.0, 
-                     c_obliquity = 0.0, c_ecliptic = 0.0;
+  // Table 21A as separate arrays, one per column, for the batch 
+  // series.
+  struct nutation_terms {
+    double D[NUTATION_TERMS];
+    double M[NUTATION_TERMS];
+    double MM[NUTATION_TERMS];
+    double F[NUTATION_TERMS];
+    double O[NUTATION_TERMS];
+    double longitude1[NUTATION_TERMS];
+    double longitude2[NUTATION_TERMS];
+    double obliquity1[NUTATION_TERMS];
+    double obliquity2[NUTATION_TERMS];
+  };
+
+  static nutation_terms make_terms()
+  {
+    nutation_terms terms;
+
+    for( int i = 0; i < NUTATION_TERMS; i++ ) {
+      terms.D[i] = arguments[i].D;
+      terms.M[i] = arguments[i].M;
+      terms.MM[i] = arguments[i].MM;
+      terms.F[i] = arguments[i].F;
+      terms.O[i] = arguments[i].O;
+      terms.longitude1[i] = coefficients[i].longitude1;
+      terms.longitude2[i] = coefficients[i].longitude2;
+      terms.obliquity1[i] = coefficients[i].obliquity1;
+      terms.obliquity2[i] = coefficients[i].obliquity2;
+    }
+
+    return terms;
+  }
+
+  // D, M, M', F and Omega for T, reduced to one turn and in radians 
+  // so the combined arguments stay small.
+  static void get_arguments( double T, double* D, double* M, 
+   double* MM, double* F, double* O )
+  {
+    double T2 = T * T, T3 = T2 * T;
+
+    *D = 297.85036 + 445267.111480 * T - 0.0019142 * T2 + T3 / 189474.0;
+    *M = 357.52772 + 35999.050340 * T - 0.0001603 * T2 - T3 / 300000.0;
+    *MM = 134.96298 + 477198.867398 * T + 0.0086972 * T2 + T3 / 56250.0;
+    *F = 93.2719100 + 483202.017538 * T - 0.0036825 * T2 + T3 / 327270.0;
+    *O = 125.04452 - 1934.136261 * T + 0.0020708 * T2 + T3 / 450000.0;
+
+    *D = GEN_GEOMETRY_DEGTORAD( std::fmod( *D, 360.0 ) );
+    *M = GEN_GEOMETRY_DEGTORAD( std::fmod( *M, 360.0 ) );
+    *MM = GEN_GEOMETRY_DEGTORAD( std::fmod( *MM, 360.0 ) );
+    *F = GEN_GEOMETRY_DEGTORAD( std::fmod( *F, 360.0 ) );
+    *O = GEN_GEOMETRY_DEGTORAD( std::fmod( *O, 360.0 ) );
+  }
+
+  // Mean obliquity of the ecliptic in degrees, equ 22.3.
+  static double get_mean_obliquity( double T )
+  {
+    double U = T / 100.0;
+
+    return 23.0 + 26.0 / 60.0 + 21.448 / 3600.0 + 
+           U * ( -4680.93 + U * ( -1.55 + U * ( 1999.25 + U * ( -51.38 + 
+           U * ( -249.67 + U * ( -39.05 + U * ( 7.12 + U * ( 27.87 + 
+           U * ( 5.79 + U * 2.45 ))))))))) / 3600.0;
+  }
 
   nutation::nutation( double JD, nut* n )
+  {
+    nutation_cache* cache = &nutation_cache::local();
+
+    // Should we bother recalculating nutation.
+    if( !cache->lookup( JD, n ) ) {
+      compute( JD, n );
+      cache->store( JD, n );
+    }
+  }
+
+  nutation::nutation( double JD, nut* n, nutation_cache* cache )
+  {
+    // Should we bother recalculating nutation.
+    if( !cache->lookup( JD, n ) ) {
+      compute( JD, n );
+      cache->store( JD, n );
+    }
+  }
+
+  nutation::nutation( julian_date JD, nut* n, nutation_cache* cache )
+   : nutation( JD.get_jd(), n, cache ? cache : &nutation_cache::local() )
+  {
+  }
+
+  void nutation::compute( double JD, nut* n )
   {  
-    long double D = 0.0, M = 0.0, MM = 0.0, 
-                F = 0.0, O = 0.0, T = 0.0, 
-                T2 = 0.0, T3 = 0.0, JDE = 0.0;
+    double D = 0.0, M = 0.0, MM = 0.0, 
+           F = 0.0, O = 0.0, T = 0.0, 
+           argument = 0.0, JDE = 0.0;
 
-    long double coeff_sine = 0.0,
-                coeff_cos = 0.0;
+    double coeff_sine = 0.0,
+           coeff_cos = 0.0;
 
-    volatile register int i asm ("eax");
-    i = 0;
+    double longitude = 0.0, obliquity = 0.0;
 
-    // Should we bother recalculating nutation.
-    if( std::fabs( JD - c_JD ) > NUTATION_EPOCH_THRESHOLD ) {
-      // Set the new epoch.
-      c_JD = JD;
-
-      // Set ecliptic.
-      c_ecliptic = 23.0 + 26.0 / 60.0 + 27.407 / 3600.0;
-
-      // Get julian ephemeris day.
-      JDE = dynamical_time::get_jde( JD );
-
-      // Calc T.
-      T = ( JDE - 2451545.0 ) / 36525;
-      T2 = T * T;
-      T3 = T2 * T;
-
-      // Calculate D,M,M',F and Omega.
-      D = 297.85036 + 445267.111480 * T - 0.0019142 * T2 + T3 / 189474.0;
-      M = 357.52772 + 35999.050340 * T - 0.0001603 * T2 - T3 / 300000.0;
-      MM = 134.96298 + 477198.867398 * T + 0.0086972 * T2 + T3 / 56250.0;
-      F = 93.2719100 + 483202.017538 * T - 0.0036825 * T2 + T3 / 327270.0;
-      O = 125.04452 - 1934.136261 * T + 0.0020708 * T2 + T3 / 450000.0;
-	
-      // Convert to radians.
-      D = GEN_GEOMETRY_DEGTORAD( D );
-      M = GEN_GEOMETRY_DEGTORAD( M );
-      MM = GEN_GEOMETRY_DEGTORAD( MM );
-      F = GEN_GEOMETRY_DEGTORAD( F );
-      O = GEN_GEOMETRY_DEGTORAD( O );
-
-      // Calc sum of terms in table 21A.
-      for( i = 0; i < NUTATION_TERMS; i++ ) {
-        // Calc coefficients of sine and cosine.
-        coeff_sine = ( coefficients[i].longitude1 + 
-                     ( coefficients[i].longitude2 * T ) );
-	coeff_cos = ( coefficients[i].obliquity1 + 
-                    ( coefficients[i].obliquity2 * T ) );
-			
-	// Sum the arguments.
-	if( arguments[i].D != 0 ) {
-          c_longitude += coeff_sine * ( std::sin( arguments[i].D * D ) );
-	  c_obliquity += coeff_cos * ( std::cos( arguments[i].D * D ) );
+    // Get julian ephemeris day.
+    JDE = dynamical_time::get_jde( JD );
+
+    // Calc T.
+    T = ( JDE - 2451545.0 ) / 36525;
+
+    // Calculate D,M,M',F and Omega in radians.
+    get_arguments( T, &D, &M, &MM, &F, &O );
+
+    // Calc sum of terms in table 21A, each one is the sine and cosine
+    // of a single combined argument.
+    for( int i = 0; i < NUTATION_TERMS; i++ ) {
+      // Calc coefficients of sine and cosine.
+      coeff_sine = ( coefficients[i].longitude1 + 
+                   ( coefficients[i].longitude2 * T ) );
+      coeff_cos = ( coefficients[i].obliquity1 + 
+                  ( coefficients[i].obliquity2 * T ) );
+
+      argument = arguments[i].D * D + arguments[i].M * M + 
+                 arguments[i].MM * MM + arguments[i].F * F + 
+                 arguments[i].O * O;
+
+      longitude += coeff_sine * std::sin( argument );
+      obliquity += coeff_cos * std::cos( argument );
+    }    
+
+    // Change to arcsecs.
+    longitude /= 10000;
+    obliquity /= 10000;
+
+    // Change to degrees.
+    longitude /= ( 60 * 60 );
+    obliquity /= ( 60 * 60 );
+
+    // Return results.
+    n->longitude = longitude;
+    n->obliquity = obliquity;
+    n->ecliptic = get_mean_obliquity( T ) + obliquity;
+  }
+
+  void nutation::get( const double* JD, size_t count, double* longitude,
+   double* obliquity, double* ecliptic )
+  {
+    static const nutation_terms terms = make_terms();
+
+    double T[VECTOR_MATH_CHUNK], D[VECTOR_MATH_CHUNK], 
+           M[VECTOR_MATH_CHUNK], MM[VECTOR_MATH_CHUNK], 
+           F[VECTOR_MATH_CHUNK], O[VECTOR_MATH_CHUNK], 
+           argument[VECTOR_MATH_CHUNK], sine[VECTOR_MATH_CHUNK], 
+           cosine[VECTOR_MATH_CHUNK], sum_sine[VECTOR_MATH_CHUNK], 
+           sum_cos[VECTOR_MATH_CHUNK];
+
+    genesis::dynamical_time time;
+
+    for( size_t first = 0; first < count; first += VECTOR_MATH_CHUNK ) {
+      size_t n = std::min( count - first, ( size_t )VECTOR_MATH_CHUNK );
+
+      for( size_t j = 0; j < n; j++ ) {
+        T[j] = ( time.get_jde( JD[first + j] ) - 2451545.0 ) / 36525;
+        get_arguments( T[j], &D[j], &M[j], &MM[j], &F[j], &O[j] );
+
+        sum_sine[j] = 0.0;
+        sum_cos[j] = 0.0;
+      }
+
+      // One term at a time for the whole chunk, so every loop runs 
+      // across Julian days.
+      for( int i = 0; i < NUTATION_TERMS; i++ ) {
+        for( size_t j = 0; j < n; j++ ) {
+          argument[j] = terms.D[i] * D[j] + terms.M[i] * M[j] + 
+                        terms.MM[i] * MM[j] + terms.F[i] * F[j] + 
+                        terms.O[i] * O[j];
         }
 
-	if( arguments[i].M != 0 ) {
-          c_longitude += coeff_sine * ( std::sin( arguments[i].M * M ) );
-	  c_obliquity += coeff_cos * ( std::cos( arguments[i].M * M ) );
-	}
+        vector_math::sincos( argument, sine, cosine, n );
 
-        if( arguments[i].MM != 0 ) {
-          c_longitude += coeff_sine * ( std::sin( arguments[i].MM * MM ) );
-	  c_obliquity += coeff_cos * ( std::cos( arguments[i].MM * MM ) );
+        for( size_t j = 0; j < n; j++ ) {
+          sum_sine[j] += ( terms.longitude1[i] + 
+                           terms.longitude2[i] * T[j] ) * sine[j];
+          sum_cos[j] += ( terms.obliquity1[i] + 
+                          terms.obliquity2[i] * T[j] ) * cosine[j];
         }
+      }
 
-        if( arguments[i].F != 0 ) {
-          c_longitude += coeff_sine * ( std::sin( arguments[i].F * F ) );
-	  c_obliquity += coeff_cos * ( std::cos( arguments[i].F * F ) );
-	}
+      // From 0.0001 arcsecs to degrees.
+      for( size_t j = 0; j < n; j++ ) {
+        longitude[first + j] = sum_sine[j] / ( 10000.0 * 60 * 60 );
+        obliquity[first + j] = sum_cos[j] / ( 10000.0 * 60 * 60 );
+        ecliptic[first + j] = get_mean_obliquity( T[j] ) + 
+                              obliquity[first + j];
+      }
+    }
+  }
 
-        if( arguments[i].O != 0 ) {
-          c_longitude += coeff_sine * ( std::sin( arguments[i].O * O ) );
-	  c_obliquity += coeff_cos * ( std::cos( arguments[i].O * O ) );
-	}
-      }    
+  nutation_cache::nutation_cache( double tolerance ) 
+   : tolerance_( tolerance ), JD_( 0.0 ), valid_( false )
+  {
+    value_.longitude = 0.0;
+    value_.obliquity = 0.0;
+    value_.ecliptic = 0.0;
+  }
 
-      // Change to arcsecs.
-      c_longitude /= 10000;
-      c_obliquity /= 10000;
+  void nutation_cache::set_tolerance( double tolerance )
+  {
+    tolerance_ = tolerance;
+  }
 
-      // Change to degrees.
-      c_longitude /= ( 60 * 60 );
-      c_obliquity /= ( 60 * 60 );
-      c_ecliptic += c_obliquity;
+  double nutation_cache::get_tolerance() const
+  {
+    return tolerance_;
+  }
+
+  void nutation_cache::clear()
+  {
+    valid_ = false;
+  }
 
+  bool nutation_cache::lookup( double JD, nutation::nut* n ) const
+  {
+    if( !valid_ || std::fabs( JD - JD_ ) > tolerance_ ) {
+      return false;
     }
 
-    // Return results.
-    n->longitude = c_longitude;
-    n->obliquity = c_obliquity;
-    n->ecliptic = c_ecliptic;
+    *n = value_;
+
+    return true;
+  }
+
+  void nutation_cache::store( double JD, const nutation::nut* n )
+  {
+    JD_ = JD;
+    value_ = *n;
+    valid_ = true;
+  }
+
+  nutation_cache& nutation_cache::local()
+  {
+    // One cache per thread, so the implicit cache never needs a lock.
+    static thread_local nutation_cache cache;
+
+    return cache;
   }
 
 }
@@ -15,10 +15,20 @@
 #ifndef SIDEREUS_NUTATION_HPP
 #define SIDEREUS_NUTATION_HPP
 
+#include <sidereus/julian_date.hxx>
+
 #include <genesis/datetime.hxx>
 #include <genesis/geometry.hxx>
 
+#include <cstddef>
+
 namespace sidereus {
+
+// Default nutation cache tolerance in days.
+#define NUTATION_CACHE_TOLERANCE 0.1
+
+  class nutation_cache;
+
   /**
    * Sidereus Nutation.
    */
@@ -47,6 +57,30 @@ namespace sidereus {
      */ 
     explicit nutation( double JD, nut* n );
 
+    /**
+     * Constructor.
+     *
+     * Same as above, but looks up and stores the result in a caller 
+     * owned cache instead of the calling thread cache.
+     *
+     * @param JD - Julian day.
+     * @param n - Pointer to store nutation.
+     * @param cache - Nutation cache.
+     */ 
+    nutation( double JD, nut* n, nutation_cache* cache );
+
+    /**
+     * Constructor.
+     *
+     * Same as above for a two part Julian date. Nutation changes 
+     * slowly, the series runs on the date as a single number.
+     *
+     * @param JD - Julian date.
+     * @param n - Pointer to store nutation.
+     * @param cache - Nutation cache, NULL for the calling thread cache.
+     */ 
+    nutation( julian_date JD, nut* n, nutation_cache* cache = 0 );
+
     /**
      * Constructor.
      */ 
@@ -57,6 +91,111 @@ namespace sidereus {
      */ 
     ~nutation() {};
 
+    /**
+     * Calculate nutation for an array of Julian days.
+     *
+     * Evaluates table 21A one term at a time across all the days, 
+     * using the vector math kernels, for building tables of many 
+     * epochs. The cache is not used.
+     *
+     * @param JD - Julian days.
+     * @param count - Number of days.
+     * @param longitude - Array to store nutation in longitude (deg).
+     * @param obliquity - Array to store nutation in obliquity (deg).
+     * @param ecliptic - Array to store true obliquity (deg).
+     */
+    static void get( const double* JD, size_t count, double* longitude, 
+                     double* obliquity, double* ecliptic );
+
+  private:
+    /**
+     * Evaluate the nutation series (table 21A) for a Julian day.
+     *
+     * @param JD - Julian day.
+     * @param n - Pointer to store nutation.
+     */
+    void compute( double JD, nut* n );
+  };
+
+  /**
+   * Sidereus Nutation Cache.
+   *
+   * Keeps the last nutation computed and returns it again while the 
+   * requested Julian day stays within tolerance of the cached one.
+   * A cache belongs to a single thread or caller and is never shared,
+   * so it needs no locking.
+   */
+  class nutation_cache {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param tolerance - Maximum distance in days between the requested
+     * and the cached Julian day for the cached value to be reused.
+     */
+    explicit nutation_cache( double tolerance = NUTATION_CACHE_TOLERANCE );
+
+    /**
+     * Destructor.
+     */
+    ~nutation_cache() {};
+
+    /**
+     * Set the tolerance in days. Zero only reuses exact matches.
+     *
+     * @param tolerance - Tolerance in days.
+     */
+    void set_tolerance( double tolerance );
+
+    /**
+     * Get the tolerance in days.
+     *
+     * @return Tolerance in days.
+     */
+    double get_tolerance() const;
+
+    /**
+     * Drop the cached value.
+     */
+    void clear();
+
+    /**
+     * Look up nutation for a Julian day.
+     *
+     * @param JD - Julian day.
+     * @param n - Pointer to store nutation.
+     * @return True if the cached value was used.
+     */
+    bool lookup( double JD, nutation::nut* n ) const;
+
+    /**
+     * Store nutation computed for a Julian day.
+     *
+     * @param JD - Julian day.
+     * @param n - Nutation to keep.
+     */
+    void store( double JD, const nutation::nut* n );
+
+    /**
+     * Get the cache of the calling thread, used by every routine
+     * that is not handed a cache explicitly.
+     *
+     * @return Thread local nutation cache.
+     */
+    static nutation_cache& local();
+
+  private:
+    /// Tolerance in days.
+    double tolerance_;
+
+    /// Julian day of the cached value.
+    double JD_;
+
+    /// Cached nutation.
+    nutation::nut value_;
+
+    /// True once a value has been stored.
+    bool valid_;
   };
 
 }
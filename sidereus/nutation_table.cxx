@@ -0,0 +1,405 @@
+/**
+ * @file
+ *
+ * Implementation for an nutation_table.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/nutation_table.hxx>
+#include <sidereus/sidereal_time.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+
+namespace sidereus {
+
+// Version of the table file layout.
+#define NUTATION_TABLE_VERSION 1
+
+/**
+ * This namespace works as if anything inside it were declared
+ * staticaly in each source file.
+ */
+namespace {
+
+  // Start of a table file, followed by the coefficients.
+  struct table_header {
+    char magic[8];          ///< "SIDNUTT" and a null.
+    uint32_t version;       ///< NUTATION_TABLE_VERSION.
+    uint32_t order;         ///< 0x01020304 in the writer byte order.
+    uint32_t series;        ///< NUTATION_TABLE_SERIES.
+    int32_t degree;         ///< Degree of the polynomials.
+    uint64_t segments;      ///< Number of segments.
+    double start;           ///< First Julian day.
+    double segment;         ///< Length of a segment in days.
+    double error[NUTATION_TABLE_SERIES]; ///< Largest errors.
+  };
+
+  static_assert( sizeof( table_header ) % sizeof( double ) == 0,
+                 "coefficients must follow the header aligned" );
+
+  const char TABLE_MAGIC[8] = { 'S', 'I', 'D', 'N', 'U', 'T', 'T', 0 };
+
+  // Check that a header belongs to a table this version can read
+  // and that its coefficients fit in the bytes after it, and get 
+  // their number. Every field comes from the file, so nothing is 
+  // multiplied before it is bounded.
+  bool check_header( const table_header* header, size_t bytes, 
+                     size_t* count )
+  {
+    size_t per_segment = 0;
+
+    if( std::memcmp( header->magic, TABLE_MAGIC, sizeof( header->magic )) ||
+        header->version != NUTATION_TABLE_VERSION || 
+        header->order != 0x01020304 ||
+        header->series != NUTATION_TABLE_SERIES || header->degree < 0 ||
+        header->degree > NUTATION_TABLE_MAX_DEGREE ) {
+      return false;
+    }
+
+    // find() divides by the segment length and casts to an index.
+    if( !std::isfinite( header->start ) || 
+        !std::isfinite( header->segment ) || !( header->segment > 0.0 ) ||
+        !std::isfinite( header->start + 
+                        header->segments * header->segment )) {
+      return false;
+    }
+
+    per_segment = NUTATION_TABLE_SERIES * ( header->degree + 1 ) * 
+                  sizeof( double );
+
+    if( header->segments > bytes / per_segment ) {
+      return false;
+    }
+
+    *count = header->segments * NUTATION_TABLE_SERIES * 
+             ( header->degree + 1 );
+
+    return true;
+  }
+
+  // Nutation and equation of the equinoxes of an array of days, one 
+  // array per series.
+  void get_series( const std::vector< double >& JD, 
+   std::vector< double >* values )
+  {
+    size_t count = JD.size();
+
+    for( int s = 0; s < NUTATION_TABLE_SERIES; s++ ) {
+      values[s].resize( count );
+    }
+
+    if( count == 0 ) {
+      return;
+    }
+
+    nutation::get( &JD[0], count, &values[0][0], &values[1][0], 
+                   &values[2][0] );
+
+    for( size_t i = 0; i < count; i++ ) {
+      nutation::nut n;
+
+      n.longitude = values[0][i];
+      n.obliquity = values[1][i];
+      n.ecliptic = values[2][i];
+      values[3][i] = sidereal_time::get_equinoxes( &n );
+    }
+  }
+
+}
+
+  nutation_table::nutation_table()
+   : start_( 0.0 ), segment_( NUTATION_TABLE_SEGMENT ), segments_( 0 ),
+     degree_( NUTATION_TABLE_DEGREE ), data_( NULL )
+  {
+    std::fill( error_, error_ + NUTATION_TABLE_SERIES, 0.0 );
+  }
+
+  bool nutation_table::fit( double startJD, double endJD, double segment,
+   int degree )
+  {
+    // The same bounds load() and map() check in the header.
+    if( !std::isfinite( startJD ) || !std::isfinite( endJD ) ||
+        !std::isfinite( segment ) || !( segment > 0.0 ) || degree < 0 || 
+        degree > NUTATION_TABLE_MAX_DEGREE ) {
+      return false;
+    }
+
+    int N = degree + 1;
+
+    std::vector< double > JD, values[NUTATION_TABLE_SERIES];
+
+    start_ = startJD;
+    segment_ = segment;
+    degree_ = degree;
+    segments_ = ( size_t )std::max( 1.0, 
+                 std::ceil(( endJD - startJD ) / segment ));
+
+    // Chebyshev nodes of every segment.
+    JD.resize( segments_ * N );
+
+    for( size_t s = 0; s < segments_; s++ ) {
+      for( int k = 0; k < N; k++ ) {
+        double x = std::cos( M_PI * ( k + 0.5 ) / N );
+
+        JD[s * N + k] = start_ + segment_ * ( s + ( x + 1.0 ) / 2.0 );
+      }
+    }
+
+    get_series( JD, values );
+
+    // c_j = 2 / N sum f( x_k ) T_j( x_k ), first one halved.
+    file_.close();
+    coefficients_.assign( segments_ * NUTATION_TABLE_SERIES * N, 0.0 );
+    data_ = coefficients_.data();
+
+    for( size_t s = 0; s < segments_; s++ ) {
+      for( int series = 0; series < NUTATION_TABLE_SERIES; series++ ) {
+        double* c = &coefficients_[( s * NUTATION_TABLE_SERIES + series ) * N];
+
+        for( int j = 0; j < N; j++ ) {
+          double sum = 0.0;
+
+          for( int k = 0; k < N; k++ ) {
+            sum += values[series][s * N + k] * 
+                   std::cos( M_PI * j * ( k + 0.5 ) / N );
+          }
+
+          c[j] = 2.0 * sum / N;
+        }
+
+        c[0] /= 2.0;
+      }
+    }
+
+    // Error half way between the nodes, twice as many points.
+    JD.resize( segments_ * 2 * N );
+
+    for( size_t s = 0; s < segments_; s++ ) {
+      for( int k = 0; k < 2 * N; k++ ) {
+        JD[s * 2 * N + k] = start_ + segment_ * ( s + ( k + 0.5 ) / 
+                            ( 2 * N ));
+      }
+    }
+
+    get_series( JD, values );
+    std::fill( error_, error_ + NUTATION_TABLE_SERIES, 0.0 );
+
+    for( size_t i = 0; i < JD.size(); i++ ) {
+      double x = 0.0;
+      const double* c = find( JD[i], &x );
+
+      for( int series = 0; series < NUTATION_TABLE_SERIES; series++ ) {
+        error_[series] = std::max( error_[series], 
+                          std::fabs( evaluate( c + series * N, x ) - 
+                                     values[series][i] ));
+      }
+    }
+
+    return true;
+  }
+
+  bool nutation_table::save( const char* path ) const
+  {
+    table_header header;
+
+    size_t N = degree_ + 1;
+
+    std::memset( &header, 0, sizeof( header ));
+    std::memcpy( header.magic, TABLE_MAGIC, sizeof( header.magic ));
+    header.version = NUTATION_TABLE_VERSION;
+    header.order = 0x01020304;
+    header.series = NUTATION_TABLE_SERIES;
+    header.degree = degree_;
+    header.segments = segments_;
+    header.start = start_;
+    header.segment = segment_;
+    std::copy( error_, error_ + NUTATION_TABLE_SERIES, header.error );
+
+    FILE* file = std::fopen( path, "wb" );
+
+    if( file == NULL ) {
+      return false;
+    }
+
+    bool ok = std::fwrite( &header, sizeof( header ), 1, file ) == 1 &&
+              std::fwrite( data_, sizeof( double ), 
+                           segments_ * NUTATION_TABLE_SERIES * N, file ) == 
+              segments_ * NUTATION_TABLE_SERIES * N;
+
+    return std::fclose( file ) == 0 && ok;
+  }
+
+  bool nutation_table::load( const char* path )
+  {
+    table_header header;
+
+    size_t count = 0;
+    long size = 0;
+
+    // Leave an empty table on any error.
+    segments_ = 0;
+    data_ = NULL;
+    coefficients_.clear();
+    file_.close();
+
+    FILE* file = std::fopen( path, "rb" );
+
+    if( file == NULL ) {
+      return false;
+    }
+
+    // File size, so a header can not ask for more than the file has.
+    if( std::fseek( file, 0, SEEK_END ) != 0 || 
+        ( size = std::ftell( file )) < ( long )sizeof( header ) ||
+        std::fseek( file, 0, SEEK_SET ) != 0 ) {
+      std::fclose( file );
+      return false;
+    }
+
+    if( std::fread( &header, sizeof( header ), 1, file ) != 1 ||
+        !check_header( &header, size - sizeof( header ), &count )) {
+      std::fclose( file );
+      return false;
+    }
+
+    coefficients_.resize( count );
+
+    if( std::fread( coefficients_.data(), sizeof( double ), count, file ) != 
+        count ) {
+      coefficients_.clear();
+      std::fclose( file );
+      return false;
+    }
+
+    std::fclose( file );
+
+    start_ = header.start;
+    segment_ = header.segment;
+    degree_ = header.degree;
+    segments_ = header.segments;
+    data_ = coefficients_.data();
+    std::copy( header.error, header.error + NUTATION_TABLE_SERIES, error_ );
+
+    return true;
+  }
+
+  bool nutation_table::map( const char* path )
+  {
+    const table_header* header = NULL;
+
+    size_t count = 0;
+
+    // Leave an empty table on any error.
+    segments_ = 0;
+    data_ = NULL;
+    coefficients_.clear();
+
+    if( !file_.open( path )) {
+      return false;
+    }
+
+    header = reinterpret_cast< const table_header* >( file_.data() );
+
+    if( file_.size() < sizeof( table_header ) || 
+        !check_header( header, file_.size() - sizeof( table_header ), 
+                       &count )) {
+      file_.close();
+      return false;
+    }
+
+    // The header size is a multiple of 8, so the coefficients are 
+    // aligned in the page aligned mapping.
+    start_ = header->start;
+    segment_ = header->segment;
+    degree_ = header->degree;
+    segments_ = header->segments;
+    data_ = reinterpret_cast< const double* >( file_.data() + 
+                                               sizeof( table_header ));
+    std::copy( header->error, header->error + NUTATION_TABLE_SERIES, 
+               error_ );
+
+    return true;
+  }
+
+  bool nutation_table::contains( double JD ) const
+  {
+    return segments_ > 0 && JD >= start_ && 
+           JD <= start_ + segments_ * segment_;
+  }
+
+  void nutation_table::get( double JD, nutation::nut* n ) const
+  {
+    double x = 0.0;
+    int N = degree_ + 1;
+
+    if( !contains( JD ) ) {
+      sidereus::nutation( JD, n );
+      return;
+    }
+
+    const double* c = find( JD, &x );
+
+    n->longitude = evaluate( c, x );
+    n->obliquity = evaluate( c + N, x );
+    n->ecliptic = evaluate( c + 2 * N, x );
+  }
+
+  double nutation_table::get_apparent_sidereal( double JD ) const
+  {
+    double x = 0.0;
+
+    if( !contains( JD ) ) {
+      return sidereal_time::get_apparent( JD );
+    }
+
+    const double* c = find( JD, &x );
+
+    return sidereal_time::get_mean( JD ) + 
+           evaluate( c + 3 * ( degree_ + 1 ), x );
+  }
+
+  void nutation_table::get_max_error( nutation::nut* error, 
+   double* sidereal ) const
+  {
+    error->longitude = error_[0];
+    error->obliquity = error_[1];
+    error->ecliptic = error_[2];
+    *sidereal = error_[3];
+  }
+
+  double nutation_table::evaluate( const double* c, double x ) const
+  {
+    double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+
+    // Clenshaw recurrence.
+    for( int j = degree_; j > 0; j-- ) {
+      b0 = 2.0 * x * b1 - b2 + c[j];
+      b2 = b1;
+      b1 = b0;
+    }
+
+    return x * b1 - b2 + c[0];
+  }
+
+  const double* nutation_table::find( double JD, double* x ) const
+  {
+    size_t s = std::min(( size_t )(( JD - start_ ) / segment_ ), 
+                        segments_ - 1 );
+
+    *x = 2.0 * ( JD - start_ - s * segment_ ) / segment_ - 1.0;
+
+    return data_ + s * NUTATION_TABLE_SERIES * ( degree_ + 1 );
+  }
+
+}
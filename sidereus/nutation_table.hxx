@@ -0,0 +1,195 @@
+/**
+ * @file
+ *
+ * Definitions for an nutation_table.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#ifndef SIDEREUS_NUTATION_TABLE_HPP
+#define SIDEREUS_NUTATION_TABLE_HPP
+
+#include <sidereus/mapped_file.hxx>
+#include <sidereus/nutation.hxx>
+
+#include <cstddef>
+#include <vector>
+
+namespace sidereus {
+
+// Default length of a Chebyshev segment in days.
+#define NUTATION_TABLE_SEGMENT 8.0
+
+// Default degree of the Chebyshev polynomials.
+#define NUTATION_TABLE_DEGREE 12
+
+// Highest degree accepted from a table file.
+#define NUTATION_TABLE_MAX_DEGREE 64
+
+// Series kept per segment: nutation in longitude, nutation in 
+// obliquity, true obliquity and equation of the equinoxes.
+#define NUTATION_TABLE_SERIES 4
+
+  /**
+   * Sidereus Nutation Table.
+   *
+   * Piecewise Chebyshev approximation of nutation and of the equation 
+   * of the equinoxes over a span of Julian days. Each query is a 
+   * Clenshaw sum of a few terms instead of the 63 term series; days 
+   * outside the span fall back to the series. The table is fitted 
+   * once, or loaded from a file written by save(), and is read only 
+   * afterwards, so it can be shared between threads.
+   *
+   * Coefficients are stored as [segment][series][degree + 1]. The 
+   * file is a fixed header followed by the coefficients in the same
+   * layout, so map() uses them in place: processes mapping the same 
+   * file share one copy in the page cache and pay no parse cost.
+   */
+  class nutation_table {
+  public:
+    /**
+     * Constructor.
+     *
+     * Empty table, every query uses the series.
+     */
+    nutation_table();
+
+    /**
+     * Destructor.
+     */
+    ~nutation_table() {};
+
+    /**
+     * Fit the table from the nutation series.
+     *
+     * @param startJD - First Julian day of the span.
+     * @param endJD - Last Julian day of the span.
+     * @param segment - Length of each segment in days.
+     * @param degree - Degree of the polynomials.
+     * @return False if a day or the segment is not finite, the segment 
+     * is not positive or the degree is outside 0 to 
+     * NUTATION_TABLE_MAX_DEGREE; the table is left unchanged.
+     */
+    bool fit( double startJD, double endJD, 
+              double segment = NUTATION_TABLE_SEGMENT, 
+              int degree = NUTATION_TABLE_DEGREE );
+
+    /**
+     * Write the table to a file.
+     *
+     * @param path - File name.
+     * @return False if the file could not be written.
+     */
+    bool save( const char* path ) const;
+
+    /**
+     * Read a table written by save().
+     *
+     * @param path - File name.
+     * @return False if the file could not be read or is not a table
+     * of this version; the table is left empty.
+     */
+    bool load( const char* path );
+
+    /**
+     * Map a table written by save() read only, using the coefficients 
+     * in place.
+     *
+     * @param path - File name.
+     * @return False if the file could not be mapped or is not a table
+     * of this version; the table is left empty.
+     */
+    bool map( const char* path );
+
+    /**
+     * Check whether a Julian day is covered by the table.
+     *
+     * @param JD - Julian day.
+     * @return True if inside the span.
+     */
+    bool contains( double JD ) const;
+
+    /**
+     * Get nutation for a Julian day.
+     *
+     * @param JD - Julian day.
+     * @param n - Pointer to store nutation.
+     */
+    void get( double JD, nutation::nut* n ) const;
+
+    /**
+     * Get the apparent sidereal time at Greenwich for a Julian day.
+     *
+     * @param JD - Julian day.
+     * @return Apparent sidereal time (hours).
+     */
+    double get_apparent_sidereal( double JD ) const;
+
+    /**
+     * Get the largest difference between the table and the series, 
+     * measured between the fitting nodes when the table was fitted.
+     *
+     * @param error - Pointer to store the error of each nutation 
+     * member (deg).
+     * @param sidereal - Pointer to store the error of the apparent
+     * sidereal time (hours).
+     */
+    void get_max_error( nutation::nut* error, double* sidereal ) const;
+
+  private:
+    /// Not copyable, data_ may point into the mapping.
+    nutation_table( const nutation_table& );
+    nutation_table& operator=( const nutation_table& );
+
+    /**
+     * Evaluate one series.
+     *
+     * @param c - Coefficients of the series.
+     * @param x - Time in the segment scaled to [-1, 1].
+     * @return Value.
+     */
+    double evaluate( const double* c, double x ) const;
+
+    /**
+     * Get the coefficients of a segment and the scaled time.
+     *
+     * @param JD - Julian day, inside the span.
+     * @param x - Pointer to store the scaled time.
+     * @return Coefficients of the first series of the segment.
+     */
+    const double* find( double JD, double* x ) const;
+
+    /// First Julian day.
+    double start_;
+
+    /// Length of a segment in days.
+    double segment_;
+
+    /// Number of segments.
+    size_t segments_;
+
+    /// Degree of the polynomials.
+    int degree_;
+
+    /// Coefficients of fitted and loaded tables.
+    std::vector< double > coefficients_;
+
+    /// Mapped table file.
+    mapped_file file_;
+
+    /// Coefficients in use, in coefficients_ or in file_.
+    const double* data_;
+
+    /// Largest errors found by fit().
+    double error_[NUTATION_TABLE_SERIES];
+  };
+
+}
+
+#endif // SIDEREUS_NUTATION_TABLE_HPP
@@ -0,0 +1,591 @@
+/**
+ * @file
+ *
+ * Implementation for an observer.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/observer.hxx>
+#include <sidereus/sidereal_time.hxx>
+#include <sidereus/vector_math.hxx>
+
+#include <algorithm>
+
+namespace sidereus {
+
+  observer::observer( genesis::proto_geo::point_lon_lat_posn* position,
+   double height, const refraction* air )
+   : observer( position, air, no_parallax() )
+  {
+    double u = 0.;
+    double lat_rad = GEN_GEOMETRY_DEGTORAD( lat_ );
+
+    height_ = height;
+
+    // Equ 11.3.
+    u = std::atan( 0.99664719 * std::tan( lat_rad ) );
+    ro_sin_ = 0.99664719 * std::sin( u ) + ( height / 6378140 ) * sin_lat_;
+    ro_cos_ = std::cos( u ) + ( height / 6378140 ) * cos_lat_;
+
+    // The quantity ro_sin is positive in the northern hemisphere, 
+    // negative in the southern one.
+    if( lat_ > 0 ) {
+      ro_sin_ = std::fabs( ro_sin_ );
+    } else {
+      ro_sin_ = std::fabs( ro_sin_ ) * -1;
+    }
+
+    // ro_cos is always positive.
+    ro_cos_ = std::fabs( ro_cos_ );
+  }
+
+  observer::observer( genesis::proto_geo::point_lon_lat_posn* position,
+   const refraction* air, no_parallax )
+   : lon_( position->lon ), lat_( position->lat ), height_( 0.0 ),
+     air_( air ), ro_sin_( 0.0 ), ro_cos_( 0.0 )
+  {
+    double lat_rad = GEN_GEOMETRY_DEGTORAD( lat_ );
+
+    lon_rad_ = GEN_GEOMETRY_DEGTORAD( lon_ );
+    sin_lat_ = std::sin( lat_rad );
+    cos_lat_ = std::cos( lat_rad );
+  }
+
+  void observer::get_position( 
+   genesis::proto_geo::point_lon_lat_posn* position ) const
+  {
+    position->lon = lon_;
+    position->lat = lat_;
+  }
+
+  double observer::get_height() const
+  {
+    return height_;
+  }
+
+  const refraction* observer::get_refraction() const
+  {
+    return air_;
+  }
+
+  double observer::get_ro_sin() const
+  {
+    return ro_sin_;
+  }
+
+  double observer::get_ro_cos() const
+  {
+    return ro_cos_;
+  }
+
+  void observer::get_hrz_from_equ( 
+   genesis::proto_geo::point_equ_posn* object, double JD,
+   genesis::proto_geo::point_hrz_posn* position ) const
+  {
+    get_hrz_from_equ_sidereal_time( object, 
+                                    sidereal_time::get_mean( JD ), 
+                                    position );
+  }
+
+  void observer::get_hrz_from_equ( 
+   genesis::proto_geo::point_equ_posn* object, const epoch* frame,
+   genesis::proto_geo::point_hrz_posn* position ) const
+  {
+    get_hrz_from_equ_sidereal_time( object, frame->get_mean_sidereal(), 
+                                    position );
+  }
+
+  void observer::get_hrz_from_equ_sidereal_time( 
+   genesis::proto_geo::point_equ_posn* object, double sidereal,
+   genesis::proto_geo::point_hrz_posn* position ) const
+  {
+    double H = 0.0, declination = 0.0, sin_dec = 0.0, cos_dec = 0.0, 
+           cos_H = 0.0, A = 0.0, Ac = 0.0, As = 0.0, Zs = 0.0;
+
+    // Calculate hour angle of object at observers position, sidereal
+    // time from hours to radians.
+    H = sidereal * 2.0 * M_PI / 24.0 + lon_rad_ - 
+        GEN_GEOMETRY_DEGTORAD( object->ra );
+    cos_H = std::cos( H );
+
+    declination = GEN_GEOMETRY_DEGTORAD( object->dec );
+    sin_dec = std::sin( declination );
+    cos_dec = std::cos( declination );
+
+    // Missuse of A (you have been warned).
+    A = sin_lat_ * sin_dec + cos_lat_ * cos_dec * cos_H;
+    A = std::max( -1.0, std::min( 1.0, A ) );
+
+    // Convert back to degrees. Refraction is 0 at the poles below.
+    position->alt = GEN_GEOMETRY_RADTODEG( std::asin( A ) );
+
+    if( air_ ) {
+      position->alt = air_->get_apparent( position->alt );
+    }
+
+    // Sine of zenith distance, Telescope Control 6.8a.
+    Zs = std::sqrt( 1.0 - A * A );
+
+    // Sane check for zenith distance. Don't try to divide by 0.
+    if( Zs < 1e-5 ) {
+      if( object->dec > 0 ) {
+        position->az = 180;
+      } else {
+        position->az = 0;
+      }
+
+      if(( object->dec > 0 && lat_ > 0 ) || 
+           ( object->dec < 0 && lat_ < 0 )) {
+        position->alt = 90;
+      } else {
+        position->alt = -90;
+      }
+
+      return;
+    }
+
+    // Formulas TC 6.8d Taff 1991, pp. 2 and 13 - vector transformations.
+    As = ( cos_dec * std::sin( H ) ) / Zs;
+    Ac = ( sin_lat_ * cos_dec * cos_H - cos_lat_ * sin_dec ) / Zs;
+
+    // Don't blom at atan2.
+    if( Ac == 0 && As == 0 ) {
+      if( object->dec > 0 ) {
+        position->az = 180.0;
+      } else {
+        position->az = 0.0;
+      }
+      return;
+    }
+
+    // Convert back to degrees.
+    position->az = genesis::geometry::range_degrees( 
+                    GEN_GEOMETRY_RADTODEG( std::atan2( As, Ac ) ));
+
+    // range_degrees() takes just below zero to 360; that is 0.
+    if( position->az >= 360.0 ) {
+      position->az = 0.0;
+    }
+  }
+
+  void observer::get_hrz_from_equ( const double* ra, const double* dec, 
+   size_t count, double JD, double* alt, double* az ) const
+  {
+    // Get mean sidereal time in hours, once for every object.
+    get_hrz_from_equ_sidereal_time( ra, dec, count, 
+                                    sidereal_time::get_mean( JD ), 
+                                    alt, az );
+  }
+
+  void observer::get_hrz_from_equ( const double* ra, const double* dec, 
+   size_t count, const epoch* frame, double* alt, double* az ) const
+  {
+    get_hrz_from_equ_sidereal_time( ra, dec, count, 
+                                    frame->get_mean_sidereal(), alt, az );
+  }
+
+  void observer::get_hrz_from_equ_sidereal_time( const double* ra,
+   const double* dec, size_t count, double sidereal,
+   double* alt, double* az ) const
+  {
+    double H0 = 0.0;
+
+    double H[VECTOR_MATH_CHUNK], declination[VECTOR_MATH_CHUNK],
+           sin_H[VECTOR_MATH_CHUNK], cos_H[VECTOR_MATH_CHUNK],
+           sin_dec[VECTOR_MATH_CHUNK], cos_dec[VECTOR_MATH_CHUNK],
+           A[VECTOR_MATH_CHUNK], As[VECTOR_MATH_CHUNK], 
+           Ac[VECTOR_MATH_CHUNK], h[VECTOR_MATH_CHUNK], 
+           Z[VECTOR_MATH_CHUNK];
+
+    // Hour angle of ra = 0.
+    H0 = sidereal * 2.0 * M_PI / 24.0 + lon_rad_;
+
+    for( size_t first = 0; first < count; first += VECTOR_MATH_CHUNK ) {
+      size_t n = std::min( count - first, ( size_t )VECTOR_MATH_CHUNK );
+
+      for( size_t i = 0; i < n; i++ ) {
+        H[i] = H0 - GEN_GEOMETRY_DEGTORAD( ra[first + i] );
+        declination[i] = GEN_GEOMETRY_DEGTORAD( dec[first + i] );
+      }
+
+      vector_math::sincos( H, sin_H, cos_H, n );
+      vector_math::sincos( declination, sin_dec, cos_dec, n );
+
+      // Sine of altitude and, TC 6.8d, azimuth terms. atan2 does not 
+      // need the division by the sine of zenith distance.
+      for( size_t i = 0; i < n; i++ ) {
+        A[i] = sin_lat_ * sin_dec[i] + cos_lat_ * cos_dec[i] * cos_H[i];
+        A[i] = std::max( -1.0, std::min( 1.0, A[i] ) );
+        As[i] = cos_dec[i] * sin_H[i];
+        Ac[i] = sin_lat_ * cos_dec[i] * cos_H[i] - cos_lat_ * sin_dec[i];
+      }
+
+      vector_math::asin( A, h, n );
+      vector_math::atan2( As, Ac, Z, n );
+
+      for( size_t i = 0; i < n; i++ ) {
+        double azimuth = GEN_GEOMETRY_RADTODEG( Z[i] );
+
+        alt[first + i] = GEN_GEOMETRY_RADTODEG( h[i] );
+        // Just below zero the sum rounds to 360, which is 0.
+        azimuth += azimuth < 0.0 ? 360.0 : 0.0;
+        az[first + i] = azimuth < 360.0 ? azimuth : 0.0;
+      }
+
+      // Same pole handling as the scalar transform.
+      for( size_t i = 0; i < n; i++ ) {
+        double d = dec[first + i];
+
+        if( std::sqrt( 1.0 - A[i] * A[i] ) < 1e-5 ) {
+          az[first + i] = d > 0 ? 180.0 : 0.0;
+
+          if(( d > 0 && lat_ > 0 ) || ( d < 0 && lat_ < 0 )) {
+            alt[first + i] = 90.0;
+          } else {
+            alt[first + i] = -90.0;
+          }
+        } else if( Ac[i] == 0 && As[i] == 0 ) {
+          az[first + i] = d > 0 ? 180.0 : 0.0;
+        }
+      }
+
+      if( air_ ) {
+        air_->get_apparent( alt + first, n, alt + first );
+      }
+    }
+  }
+
+  void observer::get_hrz_track( genesis::proto_geo::point_equ_posn* object,
+   double JD, double step, size_t count, double* alt, double* az ) const
+  {
+    double declination = 0.0, sin_dec = 0.0, cos_dec = 0.0;
+
+    double A[VECTOR_MATH_CHUNK], As[VECTOR_MATH_CHUNK], 
+           Ac[VECTOR_MATH_CHUNK], h[VECTOR_MATH_CHUNK], 
+           Z[VECTOR_MATH_CHUNK];
+
+    declination = GEN_GEOMETRY_DEGTORAD( object->dec );
+    sin_dec = std::sin( declination );
+    cos_dec = std::cos( declination );
+
+    for( size_t first = 0; first < count; first += VECTOR_MATH_CHUNK ) {
+      size_t n = std::min( count - first, ( size_t )VECTOR_MATH_CHUNK );
+
+      double start = JD + first * step;
+      double sidereal = sidereal_time::get_mean( start );
+
+      // Hour angle at the first step and its change per step, from 
+      // the terms of the mean sidereal time rather than a difference 
+      // of two of them, which would lose the digits of the Julian Day.
+      double T0 = ( start - 2451545.0 ) / 36525.0;
+      double dT = step / 36525.0;
+      double T1 = T0 + dT;
+
+      double H = sidereal * 2.0 * M_PI / 24.0 + lon_rad_ - 
+                 GEN_GEOMETRY_DEGTORAD( object->ra );
+      double dH = GEN_GEOMETRY_DEGTORAD( 
+                   std::fmod( 360.98564736629 * step, 360.0 ) + 
+                   0.000387933 * dT * ( T0 + T1 ) - 
+                   dT * ( T1 * T1 + T1 * T0 + T0 * T0 ) / 38710000.0 );
+
+      double sin_H = std::sin( H ), cos_H = std::cos( H );
+      double sin_dH = std::sin( dH ), cos_dH = std::cos( dH );
+
+      for( size_t i = 0; i < n; i++ ) {
+        double s = 0.0;
+
+        A[i] = sin_lat_ * sin_dec + cos_lat_ * cos_dec * cos_H;
+        A[i] = std::max( -1.0, std::min( 1.0, A[i] ) );
+        As[i] = cos_dec * sin_H;
+        Ac[i] = sin_lat_ * cos_dec * cos_H - cos_lat_ * sin_dec;
+
+        // sin( H + dH ) and cos( H + dH ).
+        s = sin_H * cos_dH + cos_H * sin_dH;
+        cos_H = cos_H * cos_dH - sin_H * sin_dH;
+        sin_H = s;
+      }
+
+      vector_math::asin( A, h, n );
+      vector_math::atan2( As, Ac, Z, n );
+
+      for( size_t i = 0; i < n; i++ ) {
+        double azimuth = GEN_GEOMETRY_RADTODEG( Z[i] );
+
+        alt[first + i] = GEN_GEOMETRY_RADTODEG( h[i] );
+        azimuth += azimuth < 0.0 ? 360.0 : 0.0;
+        az[first + i] = azimuth < 360.0 ? azimuth : 0.0;
+
+        // Same pole handling as the scalar transform.
+        if( std::sqrt( 1.0 - A[i] * A[i] ) < 1e-5 ) {
+          az[first + i] = object->dec > 0 ? 180.0 : 0.0;
+
+          if(( object->dec > 0 && lat_ > 0 ) || 
+               ( object->dec < 0 && lat_ < 0 )) {
+            alt[first + i] = 90.0;
+          } else {
+            alt[first + i] = -90.0;
+          }
+        } else if( Ac[i] == 0 && As[i] == 0 ) {
+          az[first + i] = object->dec > 0 ? 180.0 : 0.0;
+        }
+      }
+
+      if( air_ ) {
+        air_->get_apparent( alt + first, n, alt + first );
+      }
+    }
+  }
+
+  void observer::get_equ_from_hrz( 
+   genesis::proto_geo::point_hrz_posn* object, double JD,
+   genesis::proto_geo::point_equ_posn* position ) const
+  {
+    get_equ_from_hrz_sidereal_time( object, 
+                                    sidereal_time::get_apparent( JD ), 
+                                    position );
+  }
+
+  void observer::get_equ_from_hrz( 
+   genesis::proto_geo::point_hrz_posn* object, const epoch* frame,
+   genesis::proto_geo::point_equ_posn* position ) const
+  {
+    get_equ_from_hrz_sidereal_time( object, frame->get_apparent_sidereal(), 
+                                    position );
+  }
+
+  void observer::get_equ_from_hrz_sidereal_time( 
+   genesis::proto_geo::point_hrz_posn* object, double sidereal,
+   genesis::proto_geo::point_equ_posn* position ) const
+  {
+    double H = 0.0, declination = 0.0, A = 0.0, h = 0.0, 
+           sin_A = 0.0, cos_A = 0.0;
+
+    // Change object position into radians, true altitude.
+    A = GEN_GEOMETRY_DEGTORAD( object->az );
+    h = GEN_GEOMETRY_DEGTORAD( air_ ? air_->get_true( object->alt ) : 
+                                      object->alt );
+    sin_A = std::sin( A );
+    cos_A = std::cos( A );
+
+    // Equ on pg89!
+    H = std::atan2( sin_A, ( cos_A * sin_lat_ + 
+        std::tan( h ) * cos_lat_ ));
+    declination = sin_lat_ * std::sin( h ) - 
+                  cos_lat_ * std::cos( h ) * cos_A;
+    declination = std::asin( declination );
+
+    // Get ra = sidereal - longitude + H and change sidereal to radians.
+    sidereal *= 2.0 * M_PI / 24.0;
+
+    // Store in position.
+    position->ra = genesis::geometry::range_degrees( 
+                    GEN_GEOMETRY_RADTODEG( sidereal - H + lon_rad_ ) );
+
+    if( position->ra >= 360.0 ) {
+      position->ra = 0.0;
+    }
+
+    position->dec = GEN_GEOMETRY_RADTODEG( declination );
+  }
+
+  void observer::get_equ_from_hrz( const double* alt, const double* az, 
+   size_t count, double JD, double* ra, double* dec ) const
+  {
+    get_equ_from_hrz_sidereal_time( alt, az, count, 
+                                    sidereal_time::get_apparent( JD ), 
+                                    ra, dec );
+  }
+
+  void observer::get_equ_from_hrz( const double* alt, const double* az, 
+   size_t count, const epoch* frame, double* ra, double* dec ) const
+  {
+    get_equ_from_hrz_sidereal_time( alt, az, count, 
+                                    frame->get_apparent_sidereal(), ra, dec );
+  }
+
+  void observer::get_equ_from_hrz_sidereal_time( const double* alt, 
+   const double* az, size_t count, double sidereal, 
+   double* ra, double* dec ) const
+  {
+    double A[VECTOR_MATH_CHUNK], h[VECTOR_MATH_CHUNK],
+           sin_A[VECTOR_MATH_CHUNK], cos_A[VECTOR_MATH_CHUNK],
+           sin_h[VECTOR_MATH_CHUNK], cos_h[VECTOR_MATH_CHUNK],
+           Hs[VECTOR_MATH_CHUNK], Hc[VECTOR_MATH_CHUNK],
+           H[VECTOR_MATH_CHUNK], D[VECTOR_MATH_CHUNK],
+           declination[VECTOR_MATH_CHUNK];
+
+    // ra = sidereal - H + longitude, sidereal time in radians.
+    sidereal = sidereal * 2.0 * M_PI / 24.0 + lon_rad_;
+
+    for( size_t first = 0; first < count; first += VECTOR_MATH_CHUNK ) {
+      size_t n = std::min( count - first, ( size_t )VECTOR_MATH_CHUNK );
+
+      // True altitudes.
+      if( air_ ) {
+        air_->get_true( alt + first, n, h );
+      } else {
+        std::copy( alt + first, alt + first + n, h );
+      }
+
+      for( size_t i = 0; i < n; i++ ) {
+        A[i] = GEN_GEOMETRY_DEGTORAD( az[first + i] );
+        h[i] = GEN_GEOMETRY_DEGTORAD( h[i] );
+      }
+
+      vector_math::sincos( A, sin_A, cos_A, n );
+      vector_math::sincos( h, sin_h, cos_h, n );
+
+      // Equ on pg89, both atan2 terms multiplied by cos( h ) >= 0 
+      // instead of using tan( h ).
+      for( size_t i = 0; i < n; i++ ) {
+        Hs[i] = sin_A[i] * cos_h[i];
+        Hc[i] = cos_A[i] * sin_lat_ * cos_h[i] + sin_h[i] * cos_lat_;
+        D[i] = sin_lat_ * sin_h[i] - cos_lat_ * cos_h[i] * cos_A[i];
+      }
+
+      vector_math::atan2( Hs, Hc, H, n );
+      vector_math::asin( D, declination, n );
+
+      for( size_t i = 0; i < n; i++ ) {
+        double right = std::fmod( GEN_GEOMETRY_RADTODEG( sidereal - H[i] ),
+                                  360.0 );
+
+        right += right < 0.0 ? 360.0 : 0.0;
+        ra[first + i] = right < 360.0 ? right : 0.0;
+        dec[first + i] = GEN_GEOMETRY_RADTODEG( declination[i] );
+      }
+    }
+  }
+
+  void observer::get_parallax( genesis::proto_geo::point_equ_posn* object,
+   double au_distance, double JD,
+   genesis::proto_geo::point_equ_posn* parallax ) const
+  {
+    double H = 0.;
+
+    H = sidereal_time::get_apparent( JD ) + ( lon_ - object->ra ) / 15.0;
+
+    get_parallax_ha( object, au_distance, H, parallax );
+  }
+
+  void observer::get_parallax( genesis::proto_geo::point_equ_posn* object,
+   double au_distance, const epoch* frame,
+   genesis::proto_geo::point_equ_posn* parallax ) const
+  {
+    double H = 0.;
+
+    H = frame->get_apparent_sidereal() + ( lon_ - object->ra ) / 15.0;
+
+    get_parallax_ha( object, au_distance, H, parallax );
+  }
+
+  void observer::get_parallax_ha( genesis::proto_geo::point_equ_posn* object,
+   double au_distance, double H,
+   genesis::proto_geo::point_equ_posn* parallax ) const
+  {
+    double sin_pi, sin_H, cos_H, dec_rad, cos_dec;
+
+    sin_pi = std::sin( GEN_GEOMETRY_DEGTORAD( ( 8.794 / au_distance ) / 
+                                              3600.0 ) ); 
+
+    // Change hour angle from hours to radians.
+    H *= M_PI / 12.0;
+
+    sin_H = std::sin( H );
+    cos_H = std::cos( H );
+
+    dec_rad = GEN_GEOMETRY_DEGTORAD( object->dec );
+    cos_dec = std::cos( dec_rad );
+
+    parallax->ra = std::atan2( -ro_cos_ * sin_pi * sin_H, cos_dec - 
+                   ro_cos_ * sin_pi * cos_H );
+    parallax->dec = std::atan2(( std::sin( dec_rad ) - ro_sin_ * sin_pi ) * 
+                    std::cos( parallax->ra ), cos_dec - 
+                    ro_cos_ * sin_pi * cos_H );
+
+    parallax->ra = GEN_GEOMETRY_RADTODEG( parallax->ra );
+    parallax->dec = GEN_GEOMETRY_RADTODEG( parallax->dec ) - object->dec;
+  }
+
+  void observer::get_parallax_ha( const double* dec, 
+   const double* au_distance, const double* H, size_t count,
+   double* ra_parallax, double* dec_parallax ) const
+  {
+    compute_parallax( 0, dec, au_distance, H, 0.0, count, 
+                      ra_parallax, dec_parallax );
+  }
+
+  void observer::get_parallax_sidereal_time( const double* ra, 
+   const double* dec, const double* au_distance, size_t count, 
+   double sidereal, double* ra_parallax, double* dec_parallax ) const
+  {
+    compute_parallax( ra, dec, au_distance, 0, sidereal, count, 
+                      ra_parallax, dec_parallax );
+  }
+
+  void observer::compute_parallax( const double* ra, const double* dec, 
+   const double* au_distance, const double* H, double sidereal, 
+   size_t count, double* ra_parallax, double* dec_parallax ) const
+  {
+    double pi[VECTOR_MATH_CHUNK], Hr[VECTOR_MATH_CHUNK], 
+           dec_rad[VECTOR_MATH_CHUNK], sin_pi[VECTOR_MATH_CHUNK], 
+           cos_pi[VECTOR_MATH_CHUNK], sin_H[VECTOR_MATH_CHUNK], 
+           cos_H[VECTOR_MATH_CHUNK], sin_dec[VECTOR_MATH_CHUNK], 
+           cos_dec[VECTOR_MATH_CHUNK], y[VECTOR_MATH_CHUNK], 
+           x[VECTOR_MATH_CHUNK], yd[VECTOR_MATH_CHUNK], 
+           ra_p[VECTOR_MATH_CHUNK], dec_p[VECTOR_MATH_CHUNK];
+
+    for( size_t first = 0; first < count; first += VECTOR_MATH_CHUNK ) {
+      size_t n = std::min( count - first, ( size_t )VECTOR_MATH_CHUNK );
+
+      for( size_t i = 0; i < n; i++ ) {
+        pi[i] = GEN_GEOMETRY_DEGTORAD( ( 8.794 / au_distance[first + i] ) / 
+                                       3600.0 );
+        dec_rad[i] = GEN_GEOMETRY_DEGTORAD( dec[first + i] );
+      }
+
+      // Change hour angle from hours to radians.
+      if( H ) {
+        for( size_t i = 0; i < n; i++ ) {
+          Hr[i] = H[first + i] * M_PI / 12.0;
+        }
+      } else {
+        // As get_parallax().
+        for( size_t i = 0; i < n; i++ ) {
+          Hr[i] = ( sidereal + ( lon_ - ra[first + i] ) / 15.0 ) * 
+                  M_PI / 12.0;
+        }
+      }
+
+      vector_math::sincos( pi, sin_pi, cos_pi, n );
+      vector_math::sincos( Hr, sin_H, cos_H, n );
+      vector_math::sincos( dec_rad, sin_dec, cos_dec, n );
+
+      for( size_t i = 0; i < n; i++ ) {
+        y[i] = -ro_cos_ * sin_pi[i] * sin_H[i];
+        x[i] = cos_dec[i] - ro_cos_ * sin_pi[i] * cos_H[i];
+
+        // cos( atan2( y, x ) ) without another cosine.
+        yd[i] = ( sin_dec[i] - ro_sin_ * sin_pi[i] ) * x[i] / 
+                std::sqrt( x[i] * x[i] + y[i] * y[i] );
+      }
+
+      vector_math::atan2( y, x, ra_p, n );
+      vector_math::atan2( yd, x, dec_p, n );
+
+      for( size_t i = 0; i < n; i++ ) {
+        ra_parallax[first + i] = GEN_GEOMETRY_RADTODEG( ra_p[i] );
+        dec_parallax[first + i] = GEN_GEOMETRY_RADTODEG( dec_p[i] ) - 
+                                  dec[first + i];
+      }
+    }
+  }
+
+}
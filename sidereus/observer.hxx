@@ -0,0 +1,412 @@
+/**
+ * @file
+ *
+ * Definitions for an observer.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#ifndef SIDEREUS_OBSERVER_HPP
+#define SIDEREUS_OBSERVER_HPP
+
+#include <sidereus/epoch.hxx>
+#include <sidereus/refraction.hxx>
+
+#include <genesis/geometry.hxx>
+
+#include <cstddef>
+
+namespace sidereus {
+  /**
+   * Sidereus Observer.
+   *
+   * Observing site with the terms that only depend on its position 
+   * (longitude in radians, sine and cosine of latitude, ro sin phi' 
+   * and ro cos phi') computed once at construction, so the 
+   * transforms below only pay for the object terms. A site is 
+   * immutable and can be shared between threads.
+   *
+   * A site built with a refraction table works in apparent altitudes: 
+   * the horizontal transforms refract the altitudes they return and 
+   * the inverse transforms unrefract the altitudes they take.
+   */
+  class observer {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param position - Geographics observer position, longitude 
+     * positive east.
+     * @param height - Observer height in m.
+     * @param air - Refraction of the site, or NULL for true altitudes. 
+     * Owned by the caller, it must outlive the observer.
+     */
+    explicit observer( genesis::proto_geo::point_lon_lat_posn* position,
+                       double height = 0.0, const refraction* air = 0 );
+
+    /**
+     * Destructor.
+     */
+    ~observer() {};
+
+    /**
+     * Get the observer position.
+     *
+     * @param position - Pointer to store the position.
+     */
+    void get_position( genesis::proto_geo::point_lon_lat_posn* position ) 
+     const;
+
+    /**
+     * Get the observer height.
+     *
+     * @return Height in m.
+     */
+    double get_height() const;
+
+    /**
+     * Get the refraction of the site.
+     *
+     * @return Refraction table, NULL if altitudes are true.
+     */
+    const refraction* get_refraction() const;
+
+    /**
+     * Get ro sin phi', equ 11.3.
+     *
+     * @return Positive in the northern hemisphere.
+     */
+    double get_ro_sin() const;
+
+    /**
+     * Get ro cos phi', equ 11.3.
+     *
+     * @return Always positive.
+     */
+    double get_ro_cos() const;
+
+    /**
+     * Transform an objects equatorial coordinates into horizontal 
+     * coordinates for the given julian day, using mean sidereal time.
+     *
+     * 0 deg azimuth = south, 90 deg = west.
+     *
+     * @param object - Object coordinates.
+     * @param JD - Julian Day.
+     * @param position - Pointer to store new positions.
+     */
+    void get_hrz_from_equ( genesis::proto_geo::point_equ_posn* object, 
+                           double JD,
+                           genesis::proto_geo::point_hrz_posn* position ) 
+     const;
+
+    /**
+     * Transform an objects equatorial coordinates into horizontal 
+     * coordinates at the instant of an epoch frame.
+     *
+     * @param object - Object coordinates.
+     * @param frame - Epoch.
+     * @param position - Pointer to store new positions.
+     */
+    void get_hrz_from_equ( genesis::proto_geo::point_equ_posn* object, 
+                           const epoch* frame,
+                           genesis::proto_geo::point_hrz_posn* position ) 
+     const;
+
+    /**
+     * Calculate horizontal coordinates from equatorial coordinates.
+     *
+     * @param object - Object coordinates.
+     * @param sidereal - Sidereal Time (hours).
+     * @param position - Pointer to store new positions.
+     */
+    void get_hrz_from_equ_sidereal_time( 
+      genesis::proto_geo::point_equ_posn* object, 
+      double sidereal,
+      genesis::proto_geo::point_hrz_posn* position ) const;
+
+    /**
+     * Transform arrays of equatorial coordinates into horizontal 
+     * coordinates for the given julian day, using mean sidereal time.
+     *
+     * @param ra - Right ascensions (deg).
+     * @param dec - Declinations (deg).
+     * @param count - Number of objects.
+     * @param JD - Julian Day.
+     * @param alt - Array to store altitudes (deg).
+     * @param az - Array to store azimuths (deg).
+     */
+    void get_hrz_from_equ( const double* ra, const double* dec, 
+                           size_t count, double JD, 
+                           double* alt, double* az ) const;
+
+    /**
+     * Transform arrays of equatorial coordinates into horizontal 
+     * coordinates at the instant of an epoch frame.
+     *
+     * @param ra - Right ascensions (deg).
+     * @param dec - Declinations (deg).
+     * @param count - Number of objects.
+     * @param frame - Epoch.
+     * @param alt - Array to store altitudes (deg).
+     * @param az - Array to store azimuths (deg).
+     */
+    void get_hrz_from_equ( const double* ra, const double* dec, 
+                           size_t count, const epoch* frame, 
+                           double* alt, double* az ) const;
+
+    /**
+     * Transform arrays of equatorial coordinates into horizontal 
+     * coordinates.
+     *
+     * @param ra - Right ascensions (deg).
+     * @param dec - Declinations (deg).
+     * @param count - Number of objects.
+     * @param sidereal - Sidereal Time (hours).
+     * @param alt - Array to store altitudes (deg).
+     * @param az - Array to store azimuths (deg).
+     */
+    void get_hrz_from_equ_sidereal_time( 
+      const double* ra, const double* dec, size_t count,
+      double sidereal, double* alt, double* az ) const;
+
+    /**
+     * Track an object in horizontal coordinates over evenly spaced 
+     * Julian days, using mean sidereal time.
+     *
+     * The hour angle advances by the same angle at every step, so its 
+     * sine and cosine follow from the previous ones by the angle 
+     * addition formulas instead of new sidereal times and 
+     * trigonometry. Sidereal time is computed again every 
+     * VECTOR_MATH_CHUNK steps to keep rounding from building up.
+     *
+     * @param object - Object coordinates.
+     * @param JD - Julian Day of the first position.
+     * @param step - Days between positions, may be negative.
+     * @param count - Number of positions.
+     * @param alt - Array to store altitudes (deg).
+     * @param az - Array to store azimuths (deg).
+     */
+    void get_hrz_track( genesis::proto_geo::point_equ_posn* object, 
+                        double JD, double step, size_t count, 
+                        double* alt, double* az ) const;
+
+    /**
+     * Transform an objects horizontal coordinates into equatorial 
+     * coordinates for the given Julian Day, using apparent sidereal 
+     * time.
+     *
+     * @param object - Object coordinates.
+     * @param JD - Julian Day.
+     * @param position - Pointer to store new position.
+     */
+    void get_equ_from_hrz( genesis::proto_geo::point_hrz_posn* object, 
+                           double JD,
+                           genesis::proto_geo::point_equ_posn* position ) 
+     const;
+
+    /**
+     * Transform an objects horizontal coordinates into equatorial 
+     * coordinates at the instant of an epoch frame.
+     *
+     * @param object - Object coordinates.
+     * @param frame - Epoch.
+     * @param position - Pointer to store new position.
+     */
+    void get_equ_from_hrz( genesis::proto_geo::point_hrz_posn* object, 
+                           const epoch* frame,
+                           genesis::proto_geo::point_equ_posn* position ) 
+     const;
+
+    /**
+     * Calculate equatorial coordinates from horizontal coordinates.
+     *
+     * @param object - Object coordinates.
+     * @param sidereal - Sidereal Time (hours).
+     * @param position - Pointer to store new position.
+     */
+    void get_equ_from_hrz_sidereal_time( 
+      genesis::proto_geo::point_hrz_posn* object, 
+      double sidereal,
+      genesis::proto_geo::point_equ_posn* position ) const;
+
+    /**
+     * Transform arrays of horizontal coordinates into equatorial 
+     * coordinates for the given Julian Day, using apparent sidereal 
+     * time.
+     *
+     * @param alt - Altitudes (deg).
+     * @param az - Azimuths (deg).
+     * @param count - Number of objects.
+     * @param JD - Julian Day.
+     * @param ra - Array to store right ascensions (deg).
+     * @param dec - Array to store declinations (deg).
+     */
+    void get_equ_from_hrz( const double* alt, const double* az, 
+                           size_t count, double JD, 
+                           double* ra, double* dec ) const;
+
+    /**
+     * Transform arrays of horizontal coordinates into equatorial 
+     * coordinates at the instant of an epoch frame.
+     *
+     * @param alt - Altitudes (deg).
+     * @param az - Azimuths (deg).
+     * @param count - Number of objects.
+     * @param frame - Epoch.
+     * @param ra - Array to store right ascensions (deg).
+     * @param dec - Array to store declinations (deg).
+     */
+    void get_equ_from_hrz( const double* alt, const double* az, 
+                           size_t count, const epoch* frame, 
+                           double* ra, double* dec ) const;
+
+    /**
+     * Transform arrays of horizontal coordinates into equatorial 
+     * coordinates.
+     *
+     * @param alt - Altitudes (deg).
+     * @param az - Azimuths (deg).
+     * @param count - Number of objects.
+     * @param sidereal - Sidereal Time (hours).
+     * @param ra - Array to store right ascensions (deg).
+     * @param dec - Array to store declinations (deg).
+     */
+    void get_equ_from_hrz_sidereal_time( 
+      const double* alt, const double* az, size_t count,
+      double sidereal, double* ra, double* dec ) const;
+
+    /**
+     * Calculate body parallax for the given Julian Day, using 
+     * apparent sidereal time.
+     *
+     * @param object - Object geocentric coordinates.
+     * @param au_distance - Distance of object from Earth in AU.
+     * @param JD - Julian day of observation.
+     * @param parallax - RA and DEC parallax.
+     */
+    void get_parallax( genesis::proto_geo::point_equ_posn* object, 
+                       double au_distance, double JD, 
+                       genesis::proto_geo::point_equ_posn* parallax ) const;
+
+    /**
+     * Calculate body parallax at the instant of an epoch frame.
+     *
+     * @param object - Object geocentric coordinates.
+     * @param au_distance - Distance of object from Earth in AU.
+     * @param frame - Epoch.
+     * @param parallax - RA and DEC parallax.
+     */
+    void get_parallax( genesis::proto_geo::point_equ_posn* object, 
+                       double au_distance, const epoch* frame, 
+                       genesis::proto_geo::point_equ_posn* parallax ) const;
+
+    /**
+     * Calculate body parallax from its hour angle.
+     *
+     * @param object - Object geocentric coordinates.
+     * @param au_distance - Distance of object from Earth in AU.
+     * @param H - Hour angle of object in hours.
+     * @param parallax - RA and DEC parallax.
+     */
+    void get_parallax_ha( genesis::proto_geo::point_equ_posn* object, 
+                          double au_distance, double H,
+                          genesis::proto_geo::point_equ_posn* parallax ) 
+     const;
+
+    /**
+     * Calculate parallax of arrays of bodies from their hour angles.
+     *
+     * @param dec - Object geocentric declinations (deg).
+     * @param au_distance - Distances of objects from Earth in AU.
+     * @param H - Hour angles of objects in hours.
+     * @param count - Number of objects.
+     * @param ra_parallax - Array to store RA parallax (deg).
+     * @param dec_parallax - Array to store DEC parallax (deg).
+     */
+    void get_parallax_ha( const double* dec, const double* au_distance, 
+                          const double* H, size_t count,
+                          double* ra_parallax, double* dec_parallax ) const;
+
+    /**
+     * Calculate parallax of arrays of bodies for a sidereal time, the 
+     * hour angles are taken from the site longitude.
+     *
+     * @param ra - Object geocentric right ascensions (deg).
+     * @param dec - Object geocentric declinations (deg).
+     * @param au_distance - Distances of objects from Earth in AU.
+     * @param count - Number of objects.
+     * @param sidereal - Apparent sidereal time (hours).
+     * @param ra_parallax - Array to store RA parallax (deg).
+     * @param dec_parallax - Array to store DEC parallax (deg).
+     */
+    void get_parallax_sidereal_time( const double* ra, const double* dec, 
+                                     const double* au_distance, 
+                                     size_t count, double sidereal,
+                                     double* ra_parallax, 
+                                     double* dec_parallax ) const;
+
+  private:
+    /// The one site wrappers build one observer per call and only 
+    /// transform, so they skip the parallax terms.
+    friend class transform_coord;
+
+    /// Tag of the constructor below.
+    struct no_parallax {};
+
+    /**
+     * Constructor without ro sin phi' and ro cos phi', left at 0 
+     * (geocentric), for the horizontal transforms only.
+     *
+     * @param position - Geographics observer position.
+     * @param air - Refraction of the site, or NULL.
+     * @param tag - no_parallax().
+     */
+    observer( genesis::proto_geo::point_lon_lat_posn* position,
+              const refraction* air, no_parallax tag );
+
+    /// Batch parallax, hour angles from H if given, else from the 
+    /// sidereal time and ra.
+    void compute_parallax( const double* ra, const double* dec, 
+                           const double* au_distance, const double* H, 
+                           double sidereal, size_t count,
+                           double* ra_parallax, double* dec_parallax ) 
+     const;
+
+    /// Longitude (deg).
+    double lon_;
+
+    /// Latitude (deg).
+    double lat_;
+
+    /// Height (m).
+    double height_;
+
+    /// Refraction, NULL for true altitudes.
+    const refraction* air_;
+
+    /// Longitude (rad).
+    double lon_rad_;
+
+    /// Sine of latitude.
+    double sin_lat_;
+
+    /// Cosine of latitude.
+    double cos_lat_;
+
+    /// ro sin phi'.
+    double ro_sin_;
+
+    /// ro cos phi'.
+    double ro_cos_;
+  };
+
+}
+
+#endif // SIDEREUS_OBSERVER_HPP
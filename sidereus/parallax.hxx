@@ -15,11 +15,19 @@
 #ifndef SIDEREUS_PARALLAX_HPP
 #define SIDEREUS_PARALLAX_HPP
 
+#include <sidereus/epoch.hxx>
+#include <sidereus/nutation.hxx>
+
 #include <genesis/geometry.hxx>
 
+#include <cstddef>
+
 namespace sidereus {
   /**
    * Astro Parallax.
+   *
+   * Each call rebuilds the observer terms; for repeated calls from 
+   * the same site use sidereus::observer.
    */
   class parallax {
   public:
@@ -41,6 +49,44 @@ namespace sidereus {
           double height, double JD, 
           genesis::proto_geo::point_equ_posn* parallax );
 
+    /**
+     * Calculate body parallax, which is need to calculate topocentric
+     * position of the body, taking nutation from a caller owned cache.
+     *
+     * @param object - Object geocentric coordinates.
+     * @param au_distance - Distance of object from Earth in AU.
+     * @param observer - Geographics observer positions.
+     * @param height - Observer height in m.
+     * @param JD - Julian day of observation.
+     * @param cache - Nutation cache.
+     * @param parallax - RA and DEC parallax.
+     */
+    static void 
+     get( genesis::proto_geo::point_equ_posn* object, 
+          double au_distance,
+          genesis::proto_geo::point_lon_lat_posn* observer,
+          double height, double JD, 
+          nutation_cache* cache,
+          genesis::proto_geo::point_equ_posn* parallax );
+
+    /**
+     * Calculate body parallax, which is need to calculate topocentric
+     * position of the body, at the instant of an epoch frame.
+     *
+     * @param object - Object geocentric coordinates.
+     * @param au_distance - Distance of object from Earth in AU.
+     * @param observer - Geographics observer positions.
+     * @param height - Observer height in m.
+     * @param frame - Epoch of observation.
+     * @param parallax - RA and DEC parallax.
+     */
+    static void 
+     get( genesis::proto_geo::point_equ_posn* object, 
+          double au_distance,
+          genesis::proto_geo::point_lon_lat_posn* observer,
+          double height, const epoch* frame, 
+          genesis::proto_geo::point_equ_posn* parallax );
+
     /**
      * Calculate body parallax, which is need to calculate topocentric 
      * position of the body.
@@ -62,13 +108,24 @@ namespace sidereus {
              double H,
              genesis::proto_geo::point_equ_posn* parallax );
 
-  private:
     /**
+     * Calculate parallax of arrays of bodies from their hour angles.
      *
+     * @param dec - Object geocentric declinations (deg).
+     * @param au_distance - Distances of objects from Earth in AU.
+     * @param H - Hour angles of objects in hours.
+     * @param count - Number of objects.
+     * @param observer - Geographics observer positions.
+     * @param height - Observer height in m.
+     * @param ra_parallax - Array to store RA parallax (deg).
+     * @param dec_parallax - Array to store DEC parallax (deg).
      */
-    static void 
-     get_topocentric( genesis::proto_geo::point_lon_lat_posn* observer, 
-                      double height, double* ro_sin, double* ro_cos );
+    static void
+     get_ha( const double* dec, const double* au_distance, 
+             const double* H, size_t count,
+             genesis::proto_geo::point_lon_lat_posn* observer,
+             double height,
+             double* ra_parallax, double* dec_parallax );
   };
 
 }
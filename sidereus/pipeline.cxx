@@ -0,0 +1,251 @@
+/**
+ * @file
+ *
+ * Implementation for an pipeline.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/pipeline.hxx>
+
+#include <algorithm>
+
+namespace sidereus {
+
+  // This namespace works as if anything inside it were declared
+  // staticaly in each source file.
+  namespace {
+    unsigned long long pack( size_t first, size_t end )
+    {
+      return (( unsigned long long )first << 32 ) | end;
+    }
+
+    size_t get_first( unsigned long long range )
+    {
+      return ( size_t )( range >> 32 );
+    }
+
+    size_t get_end( unsigned long long range )
+    {
+      return ( size_t )( range & 0xffffffffULL );
+    }
+  }
+
+  pipeline::pipeline( unsigned threads )
+   : queues_( threads > 0 ? threads :
+              std::max( 1u, std::thread::hardware_concurrency() )),
+     generation_( 0 ), running_( 0 ), stop_( false ), steals_( 0 ),
+     site_( 0 ), mean_sidereal_( 0.0 ),
+     apparent_sidereal_( 0.0 ), ra_( 0 ), dec_( 0 ), distance_( 0 ),
+     count_( 0 )
+  {
+    for( size_t t = 0; t < queues_.size(); t++ ) {
+      queues_[t].range.store( 0 );
+    }
+
+    for( unsigned t = 1; t < queues_.size(); t++ ) {
+      threads_.push_back( std::thread( &pipeline::work, this, t ));
+    }
+  }
+
+  pipeline::~pipeline()
+  {
+    {
+      std::lock_guard< std::mutex > lock( mutex_ );
+      stop_ = true;
+    }
+
+    start_.notify_all();
+
+    for( size_t t = 0; t < threads_.size(); t++ ) {
+      threads_[t].join();
+    }
+  }
+
+  unsigned pipeline::get_threads() const
+  {
+    return ( unsigned )queues_.size();
+  }
+
+  size_t pipeline::get_steals() const
+  {
+    return steals_.load();
+  }
+
+  void pipeline::run( const observer* site, const epoch* frame,
+   double* ra, double* dec, size_t count, const double* au_distance )
+  {
+    size_t chunks = ( count + PIPELINE_CHUNK - 1 ) / PIPELINE_CHUNK;
+    size_t threads = queues_.size();
+
+    if( count == 0 ) {
+      return;
+    }
+
+    site_ = site;
+    mean_sidereal_ = frame->get_mean_sidereal();
+    apparent_sidereal_ = frame->get_apparent_sidereal();
+    ra_ = ra;
+    dec_ = dec;
+    distance_ = au_distance;
+    count_ = count;
+    steals_.store( 0 );
+
+    // Contiguous shares, so each thread walks memory in order until
+    // it has to steal.
+    for( size_t t = 0; t < threads; t++ ) {
+      queues_[t].range.store( pack( chunks * t / threads,
+                                    chunks * ( t + 1 ) / threads ));
+    }
+
+    if( threads == 1 || chunks == 1 ) {
+      process( 0 );
+      return;
+    }
+
+    {
+      std::lock_guard< std::mutex > lock( mutex_ );
+      running_ = ( unsigned )threads_.size();
+      generation_++;
+    }
+
+    start_.notify_all();
+
+    process( 0 );
+
+    std::unique_lock< std::mutex > lock( mutex_ );
+
+    while( running_ > 0 ) {
+      done_.wait( lock );
+    }
+  }
+
+  void pipeline::work( unsigned id )
+  {
+    unsigned long seen = 0;
+
+    for( ;; ) {
+      {
+        std::unique_lock< std::mutex > lock( mutex_ );
+
+        while( !stop_ && generation_ == seen ) {
+          start_.wait( lock );
+        }
+
+        if( stop_ ) {
+          return;
+        }
+
+        seen = generation_;
+      }
+
+      process( id );
+
+      {
+        std::lock_guard< std::mutex > lock( mutex_ );
+
+        if( --running_ == 0 ) {
+          done_.notify_one();
+        }
+      }
+    }
+  }
+
+  void pipeline::process( unsigned id )
+  {
+    size_t chunk = 0;
+
+    // A thread leaves once every queue looked empty; chunks moved by
+    // a thief after that are run by the thief itself.
+    while( pop( id, &chunk ) || steal( id, &chunk )) {
+      transform( chunk );
+    }
+  }
+
+  bool pipeline::pop( unsigned id, size_t* chunk )
+  {
+    std::atomic< unsigned long long >& range = queues_[id].range;
+
+    unsigned long long current = range.load();
+
+    while( get_first( current ) < get_end( current )) {
+      if( range.compare_exchange_weak( current,
+           pack( get_first( current ) + 1, get_end( current )))) {
+        *chunk = get_first( current );
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  bool pipeline::steal( unsigned id, size_t* chunk )
+  {
+    size_t threads = queues_.size();
+
+    for( size_t k = 1; k < threads; k++ ) {
+      std::atomic< unsigned long long >& range =
+       queues_[( id + k ) % threads].range;
+
+      unsigned long long current = range.load();
+
+      while( get_first( current ) < get_end( current )) {
+        size_t first = get_first( current ), end = get_end( current );
+        size_t split = end - ( end - first + 1 ) / 2;
+
+        // Take the upper half, the victim keeps walking from the
+        // front of its share.
+        if( range.compare_exchange_weak( current, pack( first, split ))) {
+          // Own queue is empty, no thief can be working on it, and a
+          // chunk is only ever in one queue, so the store is safe.
+          queues_[id].range.store( pack( split + 1, end ));
+          steals_++;
+
+          *chunk = split;
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  void pipeline::transform( size_t chunk )
+  {
+    size_t first = chunk * PIPELINE_CHUNK;
+    size_t n = std::min( count_ - first, ( size_t )PIPELINE_CHUNK );
+
+    double* ra = ra_ + first;
+    double* dec = dec_ + first;
+
+    double alt[PIPELINE_CHUNK], az[PIPELINE_CHUNK];
+
+    if( distance_ ) {
+      double ra_parallax[PIPELINE_CHUNK], dec_parallax[PIPELINE_CHUNK];
+
+      site_->get_parallax_sidereal_time( ra, dec, distance_ + first, n,
+                                         apparent_sidereal_, ra_parallax,
+                                         dec_parallax );
+
+      for( size_t i = 0; i < n; i++ ) {
+        ra[i] += ra_parallax[i];
+        dec[i] += dec_parallax[i];
+      }
+    }
+
+    // The transform reads the declinations after writing, so it can
+    // not write over its inputs.
+    site_->get_hrz_from_equ_sidereal_time( ra, dec, n, mean_sidereal_,
+                                           alt, az );
+
+    std::copy( az, az + n, ra );
+    std::copy( alt, alt + n, dec );
+  }
+
+}
@@ -0,0 +1,158 @@
+/**
+ * @file
+ *
+ * Definitions for an pipeline.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#ifndef SIDEREUS_PIPELINE_HPP
+#define SIDEREUS_PIPELINE_HPP
+
+#include <sidereus/epoch.hxx>
+#include <sidereus/observer.hxx>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sidereus {
+  // Objects per work item: inputs, outputs and scratch of a chunk
+  // stay in the L2 cache of the thread running it.
+  #define PIPELINE_CHUNK 1024
+
+  /**
+   * Sidereus Pipeline.
+   *
+   * Parallel equatorial to horizontal transform of large catalogs for
+   * one observer and one epoch. The catalog is cut into chunks of
+   * PIPELINE_CHUNK objects, each thread starts with a contiguous share
+   * of them and, once it runs out, steals half of what is left in
+   * another thread's share. Claiming and stealing chunks is lock free;
+   * the threads only meet on a mutex to start and finish a run.
+   *
+   * Threads never touch the nutation caches: the sidereal times are
+   * read from the epoch before the run starts.
+   */
+  class pipeline {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param threads - Number of threads, including the caller of
+     * run(); 0 for one per hardware thread.
+     */
+    explicit pipeline( unsigned threads = 0 );
+
+    /**
+     * Destructor.
+     */
+    ~pipeline();
+
+    /**
+     * Get the number of threads.
+     *
+     * @return Threads, including the caller of run().
+     */
+    unsigned get_threads() const;
+
+    /**
+     * Get the number of steals during the last run.
+     *
+     * @return Successful steals.
+     */
+    size_t get_steals() const;
+
+    /**
+     * Transform arrays of equatorial coordinates into horizontal
+     * coordinates in place, using mean sidereal time like
+     * observer::get_hrz_from_equ(). With distances the positions are
+     * first made topocentric, using apparent sidereal time like
+     * observer::get_parallax(). Altitudes are refracted if the site 
+     * has a refraction table. Only one run at a time per pipeline.
+     *
+     * 0 deg azimuth = south, 90 deg = west.
+     *
+     * @param site - Observer.
+     * @param frame - Epoch.
+     * @param ra - Right ascensions (deg), replaced by azimuths (deg).
+     * @param dec - Declinations (deg), replaced by altitudes (deg).
+     * @param count - Number of objects.
+     * @param au_distance - Distances of objects from Earth in AU, or
+     * NULL to skip the parallax.
+     */
+    void run( const observer* site, const epoch* frame, double* ra,
+              double* dec, size_t count, const double* au_distance = 0 );
+
+  private:
+    /// Not copyable, the threads belong to this pipeline.
+    pipeline( const pipeline& );
+    pipeline& operator=( const pipeline& );
+
+    /// Chunks of one thread, first and end index packed in one word
+    /// so the owner and thieves claim them with a single CAS.
+    struct work_queue {
+      std::atomic< unsigned long long > range;
+      char pad[64 - sizeof( std::atomic< unsigned long long > )];
+    };
+
+    /// Thread loop, waits for runs.
+    void work( unsigned id );
+
+    /// Run chunks until no thread has any left.
+    void process( unsigned id );
+
+    /// Claim the first chunk of a thread's own queue.
+    bool pop( unsigned id, size_t* chunk );
+
+    /// Move half the chunks of another queue to this one.
+    bool steal( unsigned id, size_t* chunk );
+
+    /// Transform one chunk.
+    void transform( size_t chunk );
+
+    /// One queue per thread.
+    std::vector< work_queue > queues_;
+
+    /// Worker threads, the caller of run() is thread 0.
+    std::vector< std::thread > threads_;
+
+    /// Guards the fields below.
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+
+    /// Incremented to start a run.
+    unsigned long generation_;
+
+    /// Worker threads still busy.
+    unsigned running_;
+
+    /// Set to stop the threads.
+    bool stop_;
+
+    /// Successful steals.
+    std::atomic< size_t > steals_;
+
+    /// The run in progress.
+    const observer* site_;
+    double mean_sidereal_;
+    double apparent_sidereal_;
+    double* ra_;
+    double* dec_;
+    const double* distance_;
+    size_t count_;
+  };
+
+}
+
+#endif // SIDEREUS_PIPELINE_HPP
@@ -17,28 +17,33 @@
 
 namespace sidereus {
 
+  precession::precession()
+  {
+    clear();
+  }
+
   void precession::get_equ_prec2( genesis::proto_geo::point_equ_posn* mean_pos,
    double fromJD, double toJD,
    genesis::proto_geo::point_equ_posn* position )
   {
-    long double t = 0.0, t2 = 0.0, t3 = 0.0, A = 0.0, B = 0.0, 
-                C = 0.0, zeta = 0.0, eta = 0.0, theta = 0.0, ra = 0.0, 
-                dec = 0.0, mean_ra = 0.0, mean_dec = 0.0, T = 0.0, T2 = 0.0;
+    local().apply( mean_pos, fromJD, toJD, position );
+  }
 
-    // Change original ra and dec to radians.
-    mean_ra = GEN_GEOMETRY_DEGTORAD( mean_pos->ra );
-    mean_dec = GEN_GEOMETRY_DEGTORAD( mean_pos->dec );
+  void precession::get_matrix( double fromJD, double toJD, 
+   rotation* matrix )
+  {
+    double t = 0.0, t2 = 0.0, t3 = 0.0, T = 0.0, T2 = 0.0, 
+           zeta = 0.0, eta = 0.0, theta = 0.0;
 
-    // Calc t, T, zeta, eta and theta Equ 20.2.
-    T = (( long double )( fromJD - JULIAN_DAY_JD2000 )) / 36525.0;
-    T *= 1.0 / 3600.0;
-    t = (( long double )( toJD - fromJD )) / 36525.0;
-    t *= 1.0 / 3600.0;
+    // Calc t, T equ 20.2, centuries.
+    T = ( fromJD - JULIAN_DAY_JD2000 ) / 36525.0;
+    t = ( toJD - fromJD ) / 36525.0;
 
     T2 = T * T;
     t2 = t * t;
-    t3 = t2 *t;
+    t3 = t2 * t;
 
+    // Zeta, eta (z) and theta in arcsecs.
     zeta = ( 2306.2181 + 1.39656 * T - 0.000139 * T2 ) * t + 
            ( 0.30188 - 0.000344 * T ) * t2 + 0.017998 * t3;
     eta = ( 2306.2181 + 1.39656 * T - 0.000139 * T2 ) * t + 
@@ -46,37 +51,74 @@ namespace sidereus {
     theta = ( 2004.3109 - 0.85330 * T - 0.000217 * T2 ) * t - 
             ( 0.42665 + 0.000217 * T ) * t2 - 0.041833 * t3;
 
-    zeta = GEN_GEOMETRY_DEGTORAD( zeta );
-    eta = GEN_GEOMETRY_DEGTORAD( eta );
-    theta = GEN_GEOMETRY_DEGTORAD( theta );
-
-    // Calc A,B,C equ 20.4.
-    A = std::cos( mean_dec ) * std::sin( mean_ra + zeta );
-    B = std::cos( theta ) * std::cos( mean_dec ) * 
-        std::cos( mean_ra + zeta ) - std::sin( theta ) * 
-        std::sin( mean_dec );
-    C = std::sin( theta ) * std::cos( mean_dec ) * 
-        std::cos( mean_ra + zeta ) + 
-        std::cos( theta ) * std::sin( mean_dec );
-
-    ra = std::atan2( A, B ) + eta;
-
-    // Check for object near celestial pole.
-    if( mean_dec > ( 0.4 * M_PI ) || mean_dec < ( -0.4 * M_PI ) ) {
-      // Close to pole.
-      dec = std::acos( std::sqrt( A * A + B * B ) );
-
-      if( mean_dec < 0. ) {
-        dec *= -1; // 0 <= acos() <= PI.
-      } else {
-        dec = std::asin( C ); // Not close to pole.
+    // ra + zeta, then theta towards the new pole, then + eta.
+    *matrix = rotation::rotate_z( -eta / 3600.0 ) * 
+              rotation::rotate_y( theta / 3600.0 ) *
+              rotation::rotate_z( -zeta / 3600.0 );
+  }
+
+  rotation precession::get( double fromJD, double toJD )
+  {
+    entry* oldest = &entries_[0];
+
+    clock_++;
+
+    for( int i = 0; i < PRECESSION_CACHE_SIZE; i++ ) {
+      entry* e = &entries_[i];
+
+      if( e->used != 0 && e->fromJD == fromJD && e->toJD == toJD ) {
+        e->used = clock_;
+        return e->matrix;
+      }
+
+      if( e->used < oldest->used ) {
+        oldest = e;
       }
     }
 
-    // Change to degrees.
-    position->ra = genesis::geometry::range_degrees( 
-                    GEN_GEOMETRY_RADTODEG( ra ) );
-    position->dec = GEN_GEOMETRY_RADTODEG( dec );
+    // Not cached, replace the least recently used pair.
+    get_matrix( fromJD, toJD, &oldest->matrix );
+    oldest->fromJD = fromJD;
+    oldest->toJD = toJD;
+    oldest->used = clock_;
+
+    return oldest->matrix;
+  }
+
+  void precession::apply( genesis::proto_geo::point_equ_posn* mean_pos,
+   double fromJD, double toJD, 
+   genesis::proto_geo::point_equ_posn* position )
+  {
+    genesis::proto_geo::point_rect_coord v;
+
+    // The rotation keeps full precision close to the poles.
+    rotation::get_rect( mean_pos->ra, mean_pos->dec, &v );
+    get( fromJD, toJD ).apply( &v, &v );
+    rotation::get_spherical( &v, &position->ra, &position->dec );
+  }
+
+  void precession::apply( const double* ra, const double* dec, 
+   size_t count, double fromJD, double toJD, 
+   double* out_ra, double* out_dec )
+  {
+    get( fromJD, toJD ).apply( ra, dec, count, out_ra, out_dec );
+  }
+
+  void precession::clear()
+  {
+    for( int i = 0; i < PRECESSION_CACHE_SIZE; i++ ) {
+      entries_[i].used = 0;
+    }
+
+    clock_ = 0;
+  }
+
+  precession& precession::local()
+  {
+    // One object per thread, so get_equ_prec2 never needs a lock.
+    static thread_local precession p;
+
+    return p;
   }
 
 }
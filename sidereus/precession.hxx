@@ -15,18 +15,33 @@
 #ifndef SIDEREUS_PRECESSION_HPP
 #define SIDEREUS_PRECESSION_HPP
 
+#include <sidereus/rotation.hxx>
+
 #include <genesis/geometry.hxx>
 
+#include <cstddef>
+
 namespace sidereus {
+
+// Number of epoch pairs a precession object keeps matrices for.
+#define PRECESSION_CACHE_SIZE 8
+
   /**
    * Astro Precession.
+   *
+   * A precession object keeps the rotation matrices of the last 
+   * PRECESSION_CACHE_SIZE epoch pairs it was asked for, dropping the 
+   * least recently used one when full, so precessing a whole catalog 
+   * between the same two epochs costs one matrix-vector product per 
+   * object. An object belongs to a single thread or caller and is 
+   * never shared, so it needs no locking.
    */
   class precession {
   public:
     /**
      * Constructor.
      */ 
-    precession() {};
+    precession();
 
     /**
      * Destructor.
@@ -46,6 +61,85 @@ namespace sidereus {
     static void get_equ_prec2( genesis::proto_geo::point_equ_posn* mean_pos, 
                                double fromJD, double toJD, 
                                genesis::proto_geo::point_equ_posn* position );
+
+    /**
+     * Calculate the rotation matrix that precesses equatorial 
+     * rectangular coordinates between two Jxxxx epochs (equ 20.2, 
+     * 20.4 as a product of three frame rotations).
+     *
+     * @param fromJD - Julian day (start).
+     * @param toJD - Julian day (end).
+     * @param matrix - Pointer to store the rotation.
+     */
+    static void get_matrix( double fromJD, double toJD, rotation* matrix );
+
+    /**
+     * Get the precession matrix between two epochs, computing it only 
+     * if the pair is not cached.
+     *
+     * @param fromJD - Julian day (start).
+     * @param toJD - Julian day (end).
+     * @return Rotation from fromJD to toJD.
+     */
+    rotation get( double fromJD, double toJD );
+
+    /**
+     * Precess equatorial coordinates between two epochs.
+     *
+     * @param mean_pos - Mean object position.
+     * @param fromJD - Julian day (start).
+     * @param toJD - Julian day (end).
+     * @param position - Pointer to store new object position, may be 
+     * mean_pos.
+     */
+    void apply( genesis::proto_geo::point_equ_posn* mean_pos, 
+                double fromJD, double toJD, 
+                genesis::proto_geo::point_equ_posn* position );
+
+    /**
+     * Precess arrays of equatorial coordinates between two epochs.
+     *
+     * @param ra - Mean right ascensions (deg).
+     * @param dec - Mean declinations (deg).
+     * @param count - Number of objects.
+     * @param fromJD - Julian day (start).
+     * @param toJD - Julian day (end).
+     * @param out_ra - Array to store right ascensions (deg).
+     * @param out_dec - Array to store declinations (deg).
+     */
+    void apply( const double* ra, const double* dec, size_t count, 
+                double fromJD, double toJD, 
+                double* out_ra, double* out_dec );
+
+    /**
+     * Drop every cached matrix.
+     */
+    void clear();
+
+    /**
+     * Get the precession object of the calling thread, used by 
+     * get_equ_prec2.
+     *
+     * @return Thread local precession object.
+     */
+    static precession& local();
+
+  private:
+    /**
+     * Cached matrix of an epoch pair.
+     */
+    typedef struct entry_ {
+      double fromJD;      ///< Julian day (start).
+      double toJD;        ///< Julian day (end).
+      rotation matrix;    ///< Precession matrix.
+      unsigned long used; ///< Last use, zero if empty.
+    } entry;
+
+    /// Cached matrices.
+    entry entries_[PRECESSION_CACHE_SIZE];
+
+    /// Use counter.
+    unsigned long clock_;
   };
 
 }
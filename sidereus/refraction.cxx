@@ -0,0 +1,148 @@
+/**
+ * @file
+ *
+ * Implementation for an refraction.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/refraction.hxx>
+
+#include <genesis/geometry.hxx>
+
+#include <algorithm>
+#include <cmath>
+
+namespace sidereus {
+
+/**
+ * This namespace works as if anything inside it were declared
+ * staticaly in each source file.
+ */
+namespace {
+
+  // Lowest altitude of the tables (deg).
+  const double TABLE_ALTITUDE = REFRACTION_MIN_ALTITUDE - REFRACTION_FADE;
+
+  // Pressure and temperature correction of equ 16.3 and 16.4.
+  double get_factor( double pressure, double temperature )
+  {
+    return ( pressure / 1010.0 ) * ( 283.0 / ( 273.0 + temperature ));
+  }
+
+  // Tabulate a formula from the lowest faded altitude to the zenith,
+  // with one entry past it so every lookup has two neighbours.
+  void build( double ( *formula )( double, double, double ), 
+   double pressure, double temperature, std::vector< double >* table )
+  {
+    size_t size = ( size_t )(( 90.0 - TABLE_ALTITUDE ) / 
+                             REFRACTION_STEP + 0.5 ) + 2;
+
+    double lowest = formula( REFRACTION_MIN_ALTITUDE, pressure, 
+                             temperature );
+
+    table->resize( size );
+
+    for( size_t i = 0; i < size; i++ ) {
+      double altitude = std::min( 90.0, TABLE_ALTITUDE + 
+                                        i * REFRACTION_STEP );
+
+      if( altitude < REFRACTION_MIN_ALTITUDE ) {
+        ( *table )[i] = lowest * ( altitude - TABLE_ALTITUDE ) / 
+                        REFRACTION_FADE;
+      } else {
+        ( *table )[i] = formula( altitude, pressure, temperature );
+      }
+    }
+  }
+
+  // Interpolated refraction of an altitude. Altitudes under the table
+  // get its first entry, which is 0.
+  double lookup( const double* table, size_t size, double altitude )
+  {
+    double u = std::max( 0.0, std::min(( double )( size - 2 ), 
+                ( altitude - TABLE_ALTITUDE ) / REFRACTION_STEP ));
+
+    size_t i = ( size_t )u;
+
+    return table[i] + ( u - i ) * ( table[i + 1] - table[i] );
+  }
+}
+
+  refraction::refraction( double pressure, double temperature )
+   : pressure_( pressure ), temperature_( temperature )
+  {
+    build( get_saemundsson, pressure, temperature, &to_apparent_ );
+    build( get_bennett, pressure, temperature, &to_true_ );
+  }
+
+  double refraction::get_pressure() const
+  {
+    return pressure_;
+  }
+
+  double refraction::get_temperature() const
+  {
+    return temperature_;
+  }
+
+  double refraction::get_bennett( double apparent, double pressure,
+   double temperature )
+  {
+    // Equ 16.3 in minutes of arc, 0.0013515 makes it 0 at 90 deg.
+    double R = 1.0 / std::tan( GEN_GEOMETRY_DEGTORAD( 
+                apparent + 7.31 / ( apparent + 4.4 ))) + 0.0013515;
+
+    return R * get_factor( pressure, temperature ) / 60.0;
+  }
+
+  double refraction::get_saemundsson( double altitude, double pressure,
+   double temperature )
+  {
+    // Equ 16.4 in minutes of arc, 0.0019279 makes it 0 at 90 deg.
+    double R = 1.02 / std::tan( GEN_GEOMETRY_DEGTORAD( 
+                altitude + 10.3 / ( altitude + 5.11 ))) + 0.0019279;
+
+    return R * get_factor( pressure, temperature ) / 60.0;
+  }
+
+  double refraction::get_apparent( double altitude ) const
+  {
+    return altitude + lookup( &to_apparent_[0], to_apparent_.size(), 
+                              altitude );
+  }
+
+  double refraction::get_true( double apparent ) const
+  {
+    return apparent - lookup( &to_true_[0], to_true_.size(), apparent );
+  }
+
+  void refraction::get_apparent( const double* altitude, size_t count,
+   double* apparent ) const
+  {
+    const double* table = &to_apparent_[0];
+    size_t size = to_apparent_.size();
+
+    for( size_t i = 0; i < count; i++ ) {
+      apparent[i] = altitude[i] + lookup( table, size, altitude[i] );
+    }
+  }
+
+  void refraction::get_true( const double* apparent, size_t count,
+   double* altitude ) const
+  {
+    const double* table = &to_true_[0];
+    size_t size = to_true_.size();
+
+    for( size_t i = 0; i < count; i++ ) {
+      altitude[i] = apparent[i] - lookup( table, size, apparent[i] );
+    }
+  }
+
+}
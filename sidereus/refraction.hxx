@@ -0,0 +1,160 @@
+/**
+ * @file
+ *
+ * Definitions for an refraction.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#ifndef SIDEREUS_REFRACTION_HPP
+#define SIDEREUS_REFRACTION_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace sidereus {
+  // Pressure (millibars) and temperature (C) of the formulas.
+  #define REFRACTION_PRESSURE 1010.0
+  #define REFRACTION_TEMPERATURE 10.0
+
+  // Lowest altitude of the formulas (deg). Below it the refraction 
+  // fades out linearly over REFRACTION_FADE deg and is 0 further down,
+  // the formulas diverge a few degrees below the horizon.
+  #define REFRACTION_MIN_ALTITUDE -1.0
+  #define REFRACTION_FADE 1.0
+
+  // Altitude step of the tables (deg); linear interpolation stays 
+  // within about 0.1 arcsec of the formulas.
+  #define REFRACTION_STEP 0.05
+
+  /**
+   * Sidereus Refraction.
+   *
+   * Atmospheric refraction for one site, Chapter 16: Saemundsson's 
+   * formula from true to apparent altitude and Bennett's from 
+   * apparent to true altitude, both corrected for pressure and 
+   * temperature. Both are tabulated at construction, so correcting an 
+   * altitude is a table lookup and an interpolation. A table is 
+   * immutable and can be shared between threads.
+   *
+   * Give it to an observer to have the horizontal transforms return 
+   * apparent altitudes and take them back.
+   */
+  class refraction {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param pressure - Atmospheric pressure (millibars).
+     * @param temperature - Air temperature (C).
+     */
+    explicit refraction( double pressure = REFRACTION_PRESSURE, 
+                         double temperature = REFRACTION_TEMPERATURE );
+
+    /**
+     * Destructor.
+     */
+    ~refraction() {};
+
+    /**
+     * Get the atmospheric pressure.
+     *
+     * @return Pressure (millibars).
+     */
+    double get_pressure() const;
+
+    /**
+     * Get the air temperature.
+     *
+     * @return Temperature (C).
+     */
+    double get_temperature() const;
+
+    /**
+     * Calculate the refraction of an apparent altitude, equ 16.3 
+     * made 0 at the zenith.
+     *
+     * @param apparent - Apparent altitude (deg).
+     * @param pressure - Atmospheric pressure (millibars).
+     * @param temperature - Air temperature (C).
+     * @return Apparent less true altitude (deg).
+     */
+    static double get_bennett( double apparent, 
+                               double pressure = REFRACTION_PRESSURE,
+                               double temperature = REFRACTION_TEMPERATURE );
+
+    /**
+     * Calculate the refraction of a true altitude, equ 16.4 made 0 
+     * at the zenith.
+     *
+     * @param altitude - True altitude (deg).
+     * @param pressure - Atmospheric pressure (millibars).
+     * @param temperature - Air temperature (C).
+     * @return Apparent less true altitude (deg).
+     */
+    static double get_saemundsson( double altitude, 
+                                   double pressure = REFRACTION_PRESSURE,
+                                   double temperature = 
+                                    REFRACTION_TEMPERATURE );
+
+    /**
+     * Get the apparent altitude of a true altitude.
+     *
+     * @param altitude - True altitude (deg).
+     * @return Apparent altitude (deg).
+     */
+    double get_apparent( double altitude ) const;
+
+    /**
+     * Get the true altitude of an apparent altitude.
+     *
+     * @param apparent - Apparent altitude (deg).
+     * @return True altitude (deg).
+     */
+    double get_true( double apparent ) const;
+
+    /**
+     * Get the apparent altitudes of arrays of true altitudes.
+     *
+     * @param altitude - True altitudes (deg).
+     * @param count - Number of altitudes.
+     * @param apparent - Array to store apparent altitudes (deg), may 
+     * be altitude.
+     */
+    void get_apparent( const double* altitude, size_t count, 
+                       double* apparent ) const;
+
+    /**
+     * Get the true altitudes of arrays of apparent altitudes.
+     *
+     * @param apparent - Apparent altitudes (deg).
+     * @param count - Number of altitudes.
+     * @param altitude - Array to store true altitudes (deg), may be 
+     * apparent.
+     */
+    void get_true( const double* apparent, size_t count, 
+                   double* altitude ) const;
+
+  private:
+    /// Atmospheric pressure (millibars).
+    double pressure_;
+
+    /// Air temperature (C).
+    double temperature_;
+
+    /// Refraction by true altitude, from the lowest faded altitude.
+    std::vector< double > to_apparent_;
+
+    /// Refraction by apparent altitude, from the lowest faded altitude.
+    std::vector< double > to_true_;
+  };
+
+}
+
+#endif // SIDEREUS_REFRACTION_HPP
@@ -0,0 +1,221 @@
+/**
+ * @file
+ *
+ * Implementation for an rise_set.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/rise_set.hxx>
+#include <sidereus/sidereal_time.hxx>
+
+#include <cmath>
+
+namespace sidereus {
+
+/**
+ * This namespace works as if anything inside it were declared
+ * staticaly in each source file.
+ */
+namespace {
+
+  /// Terms shared by every object of a day.
+  struct rst_day {
+    double JD0;      ///< 0h UT (JD).
+    double theta0;   ///< Apparent sidereal time at 0h UT (deg).
+    double lon;      ///< Longitude, positive east (deg).
+    double sin_lat;  ///< Sine of latitude.
+    double cos_lat;  ///< Cosine of latitude.
+    double horizon;  ///< Altitude of rising and setting (deg).
+    double sin_h0;   ///< Its sine.
+  };
+
+  void make_day( const observer* site, double JD, double horizon,
+   rst_day* day )
+  {
+    genesis::proto_geo::point_lon_lat_posn position;
+
+    site->get_position( &position );
+
+    day->JD0 = std::floor( JD - 0.5 ) + 0.5;
+    day->theta0 = sidereal_time::get_apparent( day->JD0 ) * 15.0;
+    day->lon = position.lon;
+    day->sin_lat = std::sin( GEN_GEOMETRY_DEGTORAD( position.lat ));
+    day->cos_lat = std::cos( GEN_GEOMETRY_DEGTORAD( position.lat ));
+    day->horizon = horizon;
+    day->sin_h0 = std::sin( GEN_GEOMETRY_DEGTORAD( horizon ));
+  }
+
+  // Angle in [-180, 180).
+  double range_180( double angle )
+  {
+    return angle - 360.0 * std::floor(( angle + 180.0 ) / 360.0 );
+  }
+
+  // Fraction of a day in [0, 1).
+  double range_day( double m )
+  {
+    return m - std::floor( m );
+  }
+
+  // Three point interpolation at n days from the middle one, 
+  // equ 3.3.
+  double interpolate( const double* y, double n )
+  {
+    double a = y[1] - y[0];
+    double b = y[2] - y[1];
+
+    return y[1] + n / 2.0 * ( a + b + n * ( b - a ));
+  }
+
+  // Rise, transit and set of an object at 0h UT of the day before, the
+  // day and the day after (equal values for fixed objects).
+  int solve( const rst_day* day, const double* ra, const double* dec,
+   rise_set::rst* time )
+  {
+    double alpha[3], m[3], sin_dec = 0.0, cos_dec = 0.0, cos_H0 = 0.0, 
+           H0 = 0.0, m0 = 0.0, numerator = 0.0, denominator = 0.0;
+
+    int status = 0;
+
+    // Right ascensions around the middle one, so 359 to 1 deg 
+    // interpolates through 0.
+    alpha[1] = ra[1];
+    alpha[0] = ra[1] + range_180( ra[0] - ra[1] );
+    alpha[2] = ra[1] + range_180( ra[2] - ra[1] );
+
+    sin_dec = std::sin( GEN_GEOMETRY_DEGTORAD( dec[1] ));
+    cos_dec = std::cos( GEN_GEOMETRY_DEGTORAD( dec[1] ));
+
+    // Equ 15.1 and 15.2, longitude positive east.
+    numerator = day->sin_h0 - day->sin_lat * sin_dec;
+    denominator = day->cos_lat * cos_dec;
+    m0 = range_day(( alpha[1] - day->lon - day->theta0 ) / 360.0 );
+
+    m[0] = m0;
+
+    // At a pole, or for an object at a celestial pole, the altitude 
+    // is the same all day and the cosines are only rounding left 
+    // from 90 deg, so cos_H0 would be noise or NaN. An object that 
+    // stays on the horizon counts as circumpolar.
+    if( std::fabs( denominator ) < 1e-12 ) {
+      status = numerator > 0.0 ? -1 : 1;
+    } else {
+      cos_H0 = numerator / denominator;
+
+      if( cos_H0 > 1.0 ) {
+        status = -1;
+      } else if( cos_H0 < -1.0 ) {
+        status = 1;
+      } else {
+        H0 = GEN_GEOMETRY_RADTODEG( std::acos( cos_H0 ));
+        m[1] = range_day( m0 - H0 / 360.0 );
+        m[2] = range_day( m0 + H0 / 360.0 );
+      }
+    }
+
+    for( int k = 0; k < ( status == 0 ? 3 : 1 ); k++ ) {
+      for( int i = 0; i < RISE_SET_ITERATIONS; i++ ) {
+        double theta = day->theta0 + 360.985647 * m[k];
+        double a = interpolate( alpha, m[k] );
+        double d = GEN_GEOMETRY_DEGTORAD( interpolate( dec, m[k] ));
+        double H = range_180( theta + day->lon - a );
+        double dm = 0.0;
+
+        if( k == 0 ) {
+          // Transit: hour angle to zero.
+          dm = -H / 360.0;
+        } else {
+          // Newton step on the altitude, equ 13.6 and 15 corrections.
+          double Hr = GEN_GEOMETRY_DEGTORAD( H );
+          double h = GEN_GEOMETRY_RADTODEG( std::asin( 
+                      day->sin_lat * std::sin( d ) + 
+                      day->cos_lat * std::cos( d ) * std::cos( Hr )));
+          double slope = 360.0 * std::cos( d ) * day->cos_lat * 
+                         std::sin( Hr );
+
+          if( slope == 0.0 ) {
+            break;
+          }
+
+          dm = ( h - day->horizon ) / slope;
+        }
+
+        m[k] += dm;
+
+        // 0.01 s.
+        if( std::fabs( dm ) < 1e-7 ) {
+          break;
+        }
+      }
+    }
+
+    time->transit = day->JD0 + m[0];
+
+    if( status == 0 ) {
+      time->rise = day->JD0 + m[1];
+      time->set = day->JD0 + m[2];
+    }
+
+    return status;
+  }
+
+}
+
+  int rise_set::get( genesis::proto_geo::point_equ_posn* object, 
+   const observer* site, double JD, double horizon, rst* time )
+  {
+    double ra[3] = { object->ra, object->ra, object->ra };
+    double dec[3] = { object->dec, object->dec, object->dec };
+
+    rst_day day;
+
+    make_day( site, JD, horizon, &day );
+
+    return solve( &day, ra, dec, time );
+  }
+
+  int rise_set::get( genesis::proto_geo::point_equ_posn* before,
+   genesis::proto_geo::point_equ_posn* object,
+   genesis::proto_geo::point_equ_posn* after, const observer* site, 
+   double JD, double horizon, rst* time )
+  {
+    double ra[3] = { before->ra, object->ra, after->ra };
+    double dec[3] = { before->dec, object->dec, after->dec };
+
+    rst_day day;
+
+    make_day( site, JD, horizon, &day );
+
+    return solve( &day, ra, dec, time );
+  }
+
+  void rise_set::get( const double* ra, const double* dec, size_t count,
+   const observer* site, double JD, double horizon, double* rise, 
+   double* transit, double* set, int* status )
+  {
+    rst_day day;
+
+    // Sidereal time and site terms once for every object.
+    make_day( site, JD, horizon, &day );
+
+    for( size_t i = 0; i < count; i++ ) {
+      double a[3] = { ra[i], ra[i], ra[i] };
+      double d[3] = { dec[i], dec[i], dec[i] };
+
+      rst time = { 0.0, 0.0, 0.0 };
+
+      status[i] = solve( &day, a, d, &time );
+      rise[i] = time.rise;
+      transit[i] = time.transit;
+      set[i] = time.set;
+    }
+  }
+
+}
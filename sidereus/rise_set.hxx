@@ -0,0 +1,115 @@
+/**
+ * @file
+ *
+ * Definitions for an rise_set.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#ifndef SIDEREUS_RISE_SET_HPP
+#define SIDEREUS_RISE_SET_HPP
+
+#include <sidereus/observer.hxx>
+
+#include <genesis/geometry.hxx>
+
+#include <cstddef>
+
+namespace sidereus {
+  // Standard altitudes of the upper limb at rising and setting (deg): 
+  // stars and planets, Sun, and Moon at mean distance.
+  #define RISE_SET_STAR -0.5667
+  #define RISE_SET_SUN -0.8333
+  #define RISE_SET_MOON 0.125
+
+  // Most corrections of a first guess; two or three are the rule.
+  #define RISE_SET_ITERATIONS 8
+
+  /**
+   * Sidereus Rise Set.
+   *
+   * Times of rising, transit and setting, (Meeus chapter 15): a 
+   * closed form first guess from the hour angle at the horizon, then 
+   * Newton corrections of the altitude until they drop below 
+   * 0.01 s.
+   */
+  class rise_set {
+  public:
+    /**
+     * Rise, transit and set times.
+     */
+    struct rst {
+      double rise;    ///< Rising (JD).
+      double transit; ///< Upper transit (JD).
+      double set;     ///< Setting (JD).
+    };
+
+    /**
+     * Calculate rise, transit and set times of a fixed object for the 
+     * UT day of a Julian Day.
+     *
+     * @param object - Object coordinates.
+     * @param site - Observer.
+     * @param JD - Any Julian Day of the UT day.
+     * @param horizon - Altitude of rising and setting (deg), 
+     * e.g. RISE_SET_STAR.
+     * @param time - Pointer to store the times, between 0h UT of the 
+     * day and the same time next day.
+     * @return 0 if the object rises and sets, 1 if it is circumpolar 
+     * and -1 if it never rises; then only the transit is stored.
+     */
+    static int get( genesis::proto_geo::point_equ_posn* object, 
+                    const observer* site, double JD, double horizon,
+                    rst* time );
+
+    /**
+     * Calculate rise, transit and set times of a moving object for the 
+     * UT day of a Julian Day, interpolating its position.
+     *
+     * @param before - Object coordinates at 0h UT of the day before.
+     * @param object - Object coordinates at 0h UT of the day.
+     * @param after - Object coordinates at 0h UT of the day after.
+     * @param site - Observer.
+     * @param JD - Any Julian Day of the UT day.
+     * @param horizon - Altitude of rising and setting (deg).
+     * @param time - Pointer to store the times.
+     * @return 0 if the object rises and sets, 1 if it is circumpolar 
+     * and -1 if it never rises; then only the transit is stored.
+     */
+    static int get( genesis::proto_geo::point_equ_posn* before,
+                    genesis::proto_geo::point_equ_posn* object,
+                    genesis::proto_geo::point_equ_posn* after,
+                    const observer* site, double JD, double horizon,
+                    rst* time );
+
+    /**
+     * Calculate rise, transit and set times of a list of fixed 
+     * objects for the UT day of a Julian Day.
+     *
+     * @param ra - Right ascensions (deg).
+     * @param dec - Declinations (deg).
+     * @param count - Number of objects.
+     * @param site - Observer.
+     * @param JD - Any Julian Day of the UT day.
+     * @param horizon - Altitude of rising and setting (deg).
+     * @param rise - Array to store rising times (JD).
+     * @param transit - Array to store transit times (JD).
+     * @param set - Array to store setting times (JD).
+     * @param status - Array to store 0, 1 (circumpolar) or -1 (never 
+     * rises) for each object.
+     */
+    static void get( const double* ra, const double* dec, size_t count,
+                     const observer* site, double JD, double horizon,
+                     double* rise, double* transit, double* set, 
+                     int* status );
+  };
+
+}
+
+#endif // SIDEREUS_RISE_SET_HPP
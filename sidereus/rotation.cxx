@@ -0,0 +1,226 @@
+/**
+ * @file
+ *
+ * Implementation for an rotation.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/rotation.hxx>
+#include <sidereus/vector_math.hxx>
+
+#include <algorithm>
+
+namespace sidereus {
+
+  rotation::rotation()
+   : m{ { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 }, { 0.0, 0.0, 1.0 } }
+  {
+  }
+
+  rotation rotation::rotate_x( double angle )
+  {
+    double s = std::sin( GEN_GEOMETRY_DEGTORAD( angle ) );
+    double c = std::cos( GEN_GEOMETRY_DEGTORAD( angle ) );
+
+    return rotation( 1.0, 0.0, 0.0,
+                     0.0, c, s,
+                     0.0, -s, c );
+  }
+
+  rotation rotation::rotate_y( double angle )
+  {
+    double s = std::sin( GEN_GEOMETRY_DEGTORAD( angle ) );
+    double c = std::cos( GEN_GEOMETRY_DEGTORAD( angle ) );
+
+    return rotation( c, 0.0, -s,
+                     0.0, 1.0, 0.0,
+                     s, 0.0, c );
+  }
+
+  rotation rotation::rotate_z( double angle )
+  {
+    double s = std::sin( GEN_GEOMETRY_DEGTORAD( angle ) );
+    double c = std::cos( GEN_GEOMETRY_DEGTORAD( angle ) );
+
+    return rotation( c, s, 0.0,
+                     -s, c, 0.0,
+                     0.0, 0.0, 1.0 );
+  }
+
+  rotation rotation::operator*( const rotation& r ) const
+  {
+    rotation p;
+
+    for( int i = 0; i < 3; i++ ) {
+      for( int j = 0; j < 3; j++ ) {
+        p.m[i][j] = m[i][0] * r.m[0][j] + m[i][1] * r.m[1][j] +
+                    m[i][2] * r.m[2][j];
+      }
+    }
+
+    return p;
+  }
+
+  rotation rotation::transpose() const
+  {
+    return rotation( m[0][0], m[1][0], m[2][0],
+                     m[0][1], m[1][1], m[2][1],
+                     m[0][2], m[1][2], m[2][2] );
+  }
+
+  void rotation::apply( const genesis::proto_geo::point_rect_coord* v,
+   genesis::proto_geo::point_rect_coord* r ) const
+  {
+    double x = v->x, y = v->y, z = v->z;
+
+    r->x = m[0][0] * x + m[0][1] * y + m[0][2] * z;
+    r->y = m[1][0] * x + m[1][1] * y + m[1][2] * z;
+    r->z = m[2][0] * x + m[2][1] * y + m[2][2] * z;
+  }
+
+  void rotation::apply( double* x, double* y, double* z,
+   size_t count ) const
+  {
+    for( size_t i = 0; i < count; i++ ) {
+      double vx = x[i], vy = y[i], vz = z[i];
+
+      x[i] = m[0][0] * vx + m[0][1] * vy + m[0][2] * vz;
+      y[i] = m[1][0] * vx + m[1][1] * vy + m[1][2] * vz;
+      z[i] = m[2][0] * vx + m[2][1] * vy + m[2][2] * vz;
+    }
+  }
+
+  void rotation::apply( const double* lon, const double* lat,
+   size_t count, double* out_lon, double* out_lat ) const
+  {
+    double a[VECTOR_MATH_CHUNK], b[VECTOR_MATH_CHUNK],
+           sin_a[VECTOR_MATH_CHUNK], cos_a[VECTOR_MATH_CHUNK],
+           sin_b[VECTOR_MATH_CHUNK], cos_b[VECTOR_MATH_CHUNK],
+           x[VECTOR_MATH_CHUNK], y[VECTOR_MATH_CHUNK],
+           z[VECTOR_MATH_CHUNK], rho[VECTOR_MATH_CHUNK];
+
+    for( size_t first = 0; first < count; first += VECTOR_MATH_CHUNK ) {
+      size_t n = std::min( count - first, ( size_t )VECTOR_MATH_CHUNK );
+
+      for( size_t i = 0; i < n; i++ ) {
+        a[i] = GEN_GEOMETRY_DEGTORAD( lon[first + i] );
+        b[i] = GEN_GEOMETRY_DEGTORAD( lat[first + i] );
+      }
+
+      vector_math::sincos( a, sin_a, cos_a, n );
+      vector_math::sincos( b, sin_b, cos_b, n );
+
+      // One matrix-vector product per point.
+      for( size_t i = 0; i < n; i++ ) {
+        double vx = cos_b[i] * cos_a[i];
+        double vy = cos_b[i] * sin_a[i];
+        double vz = sin_b[i];
+
+        x[i] = m[0][0] * vx + m[0][1] * vy + m[0][2] * vz;
+        y[i] = m[1][0] * vx + m[1][1] * vy + m[1][2] * vz;
+        z[i] = m[2][0] * vx + m[2][1] * vy + m[2][2] * vz;
+        rho[i] = std::sqrt( x[i] * x[i] + y[i] * y[i] );
+      }
+
+      vector_math::atan2( y, x, a, n );
+      vector_math::atan2( z, rho, b, n );
+
+      for( size_t i = 0; i < n; i++ ) {
+        double longitude = GEN_GEOMETRY_RADTODEG( a[i] );
+
+        // Just below zero the sum rounds to 360, which is 0.
+        longitude += longitude < 0.0 ? 360.0 : 0.0;
+        out_lon[first + i] = longitude < 360.0 ? longitude : 0.0;
+        out_lat[first + i] = GEN_GEOMETRY_RADTODEG( b[i] );
+      }
+    }
+  }
+
+  void rotation::get_rect( double lon, double lat,
+   genesis::proto_geo::point_rect_coord* v )
+  {
+    double a = GEN_GEOMETRY_DEGTORAD( lon );
+    double b = GEN_GEOMETRY_DEGTORAD( lat );
+
+    v->x = std::cos( b ) * std::cos( a );
+    v->y = std::cos( b ) * std::sin( a );
+    v->z = std::sin( b );
+  }
+
+  void rotation::get_spherical(
+   const genesis::proto_geo::point_rect_coord* v, double* lon, double* lat )
+  {
+    double rho = std::sqrt( v->x * v->x + v->y * v->y );
+
+    // atan2 keeps full precision close to the poles, unlike asin.
+    *lon = genesis::geometry::range_degrees(
+            GEN_GEOMETRY_RADTODEG( std::atan2( v->y, v->x ) ));
+
+    // range_degrees() takes just below zero to 360; that is 0.
+    if( *lon >= 360.0 ) {
+      *lon = 0.0;
+    }
+
+    *lat = GEN_GEOMETRY_RADTODEG( std::atan2( v->z, rho ) );
+  }
+
+  void rotation::get_rect( const double* lon, const double* lat,
+   size_t count, double* x, double* y, double* z )
+  {
+    double a[VECTOR_MATH_CHUNK], b[VECTOR_MATH_CHUNK],
+           sin_a[VECTOR_MATH_CHUNK], cos_a[VECTOR_MATH_CHUNK],
+           cos_b[VECTOR_MATH_CHUNK];
+
+    for( size_t first = 0; first < count; first += VECTOR_MATH_CHUNK ) {
+      size_t n = std::min( count - first, ( size_t )VECTOR_MATH_CHUNK );
+
+      for( size_t i = 0; i < n; i++ ) {
+        a[i] = GEN_GEOMETRY_DEGTORAD( lon[first + i] );
+        b[i] = GEN_GEOMETRY_DEGTORAD( lat[first + i] );
+      }
+
+      vector_math::sincos( a, sin_a, cos_a, n );
+      vector_math::sincos( b, z + first, cos_b, n );
+
+      for( size_t i = 0; i < n; i++ ) {
+        x[first + i] = cos_b[i] * cos_a[i];
+        y[first + i] = cos_b[i] * sin_a[i];
+      }
+    }
+  }
+
+  void rotation::get_spherical( const double* x, const double* y,
+   const double* z, size_t count, double* lon, double* lat )
+  {
+    double a[VECTOR_MATH_CHUNK], b[VECTOR_MATH_CHUNK],
+           rho[VECTOR_MATH_CHUNK];
+
+    for( size_t first = 0; first < count; first += VECTOR_MATH_CHUNK ) {
+      size_t n = std::min( count - first, ( size_t )VECTOR_MATH_CHUNK );
+
+      for( size_t i = 0; i < n; i++ ) {
+        rho[i] = std::sqrt( x[first + i] * x[first + i] +
+                            y[first + i] * y[first + i] );
+      }
+
+      vector_math::atan2( y + first, x + first, a, n );
+      vector_math::atan2( z + first, rho, b, n );
+
+      for( size_t i = 0; i < n; i++ ) {
+        double longitude = GEN_GEOMETRY_RADTODEG( a[i] );
+
+        longitude += longitude < 0.0 ? 360.0 : 0.0;
+        lon[first + i] = longitude < 360.0 ? longitude : 0.0;
+        lat[first + i] = GEN_GEOMETRY_RADTODEG( b[i] );
+      }
+    }
+  }
+
+}
@@ -0,0 +1,173 @@
+/**
+ * @file
+ *
+ * Definitions for an rotation.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#ifndef SIDEREUS_ROTATION_HPP
+#define SIDEREUS_ROTATION_HPP
+
+#include <genesis/geometry.hxx>
+
+#include <cstddef>
+
+namespace sidereus {
+  /**
+   * Sidereus Rotation.
+   *
+   * 3x3 rotation matrix between two celestial frames, applied to
+   * rectangular unit vectors. A matrix rotates the frame, not the
+   * vector: applied to a vector it gives the coordinates of the same
+   * direction in the new frame. Products compose as later * earlier.
+   */
+  class rotation {
+  public:
+    /**
+     * Constructor.
+     *
+     * Identity rotation.
+     */
+    rotation();
+
+    /**
+     * Constructor.
+     *
+     * Rotation from its elements, row by row.
+     */
+    constexpr rotation( double xx, double xy, double xz,
+                        double yx, double yy, double yz,
+                        double zx, double zy, double zz )
+     : m{ { xx, xy, xz }, { yx, yy, yz }, { zx, zy, zz } } {}
+
+    /**
+     * Rotation of the frame around its x axis.
+     *
+     * @param angle - Angle (deg).
+     * @return Rotation.
+     */
+    static rotation rotate_x( double angle );
+
+    /**
+     * Rotation of the frame around its y axis.
+     *
+     * @param angle - Angle (deg).
+     * @return Rotation.
+     */
+    static rotation rotate_y( double angle );
+
+    /**
+     * Rotation of the frame around its z axis.
+     *
+     * @param angle - Angle (deg).
+     * @return Rotation.
+     */
+    static rotation rotate_z( double angle );
+
+    /**
+     * Compose two rotations, r is applied first.
+     *
+     * @param r - Rotation applied before this one.
+     * @return Combined rotation.
+     */
+    rotation operator*( const rotation& r ) const;
+
+    /**
+     * Get the inverse rotation.
+     *
+     * @return Transposed matrix.
+     */
+    rotation transpose() const;
+
+    /**
+     * Rotate a rectangular vector.
+     *
+     * @param v - Vector.
+     * @param r - Pointer to store rotated vector, may be v.
+     */
+    void apply( const genesis::proto_geo::point_rect_coord* v,
+                genesis::proto_geo::point_rect_coord* r ) const;
+
+    /**
+     * Rotate arrays of rectangular vectors in place.
+     *
+     * @param x - X components.
+     * @param y - Y components.
+     * @param z - Z components.
+     * @param count - Number of vectors.
+     */
+    void apply( double* x, double* y, double* z, size_t count ) const;
+
+    /**
+     * Rotate arrays of spherical coordinates.
+     *
+     * @param lon - Longitudes or right ascensions (deg).
+     * @param lat - Latitudes or declinations (deg).
+     * @param count - Number of points.
+     * @param out_lon - Array to store longitudes in [0, 360) (deg).
+     * @param out_lat - Array to store latitudes (deg).
+     */
+    void apply( const double* lon, const double* lat, size_t count,
+                double* out_lon, double* out_lat ) const;
+
+    /**
+     * Get the unit vector of a spherical position.
+     *
+     * @param lon - Longitude or right ascension (deg).
+     * @param lat - Latitude or declination (deg).
+     * @param v - Pointer to store the unit vector.
+     */
+    static void get_rect( double lon, double lat,
+                          genesis::proto_geo::point_rect_coord* v );
+
+    /**
+     * Get the spherical position of a vector.
+     *
+     * @param v - Vector, need not be normalized.
+     * @param lon - Pointer to store longitude in [0, 360) (deg).
+     * @param lat - Pointer to store latitude (deg).
+     */
+    static void get_spherical( const genesis::proto_geo::point_rect_coord* v,
+                               double* lon, double* lat );
+
+    /**
+     * Get the unit vectors of arrays of spherical positions.
+     *
+     * @param lon - Longitudes or right ascensions (deg).
+     * @param lat - Latitudes or declinations (deg).
+     * @param count - Number of points.
+     * @param x - Array to store X components.
+     * @param y - Array to store Y components.
+     * @param z - Array to store Z components.
+     */
+    static void get_rect( const double* lon, const double* lat, size_t count,
+                          double* x, double* y, double* z );
+
+    /**
+     * Get the spherical positions of arrays of vectors.
+     *
+     * @param x - X components.
+     * @param y - Y components.
+     * @param z - Z components.
+     * @param count - Number of vectors, need not be normalized.
+     * @param lon - Array to store longitudes in [0, 360) (deg).
+     * @param lat - Array to store latitudes (deg).
+     */
+    static void get_spherical( const double* x, const double* y,
+                               const double* z, size_t count,
+                               double* lon, double* lat );
+
+    /// Matrix elements, row by row.
+    double m[3][3];
+  };
+
+}
+
+#endif // SIDEREUS_ROTATION_HPP
@@ -18,13 +18,24 @@ namespace sidereus {
 
   double sidereal_time::get_mean( double JD )
   {
-    long double sidereal = 0.0;
-    long double T = 0.0;
+    return get_mean( julian_date( JD ));
+  }
+
+  double sidereal_time::get_mean( julian_date JD )
+  {
+    double sidereal = 0.0;
+    double T = 0.0;
 
-    T = ( JD - 2451545.0 ) / 36525.0;
+    // Whole days from J2000 are exact, the fraction keeps its digits.
+    double days = JD.get_day() - 2451545.0;
+    double fraction = JD.get_fraction();
 
-    // Calc mean angle.
-    sidereal = 280.46061837 + ( 360.98564736629 * ( JD - 2451545.0 )) + 
+    T = ( days + fraction ) / 36525.0;
+
+    // Calc mean angle. 360.98564736629 deg a day is a whole turn 
+    // plus 0.98564736629 deg, the turns of the whole days drop out.
+    sidereal = 280.46061837 + 0.98564736629 * days + 
+               360.98564736629 * fraction + 
                ( 0.000387933 * T * T ) - ( T * T * T / 38710000.0 );
 
     // Add a convenient multiple of 360 degrees.
@@ -38,30 +49,44 @@ namespace sidereus {
 
   double sidereal_time::get_apparent( double JD )
   {
-     double correction = 0.0;
-     double hours = 0.0;
-     double sidereal = 0.0;
+    return get_apparent( JD, &nutation_cache::local() );
+  }
 
+  double sidereal_time::get_apparent( double JD, nutation_cache* cache )
+  {
      // Nutation
      nut nutation;
 
-     // Get the mean sidereal time.
-     sidereal = get_mean( JD );
-
      // Add corrections for nutation in longitude and for 
      // the true obliquity of the ecliptic.
-     sidereus::nutation( JD, &nutation );
+     sidereus::nutation( JD, &nutation, cache );
 
-     correction = ( nutation.longitude / 15.0 * 
-                    std::cos( GEN_GEOMETRY_DEGTORAD( nutation.obliquity ) ));
+     return get_mean( JD ) + get_equinoxes( &nutation );
+  }
 
-     // Value is in degrees so change it to hours and 
-     // add to mean sidereal time.
-     hours = ( 24.0 / 360.0 ) * correction;
+  double sidereal_time::get_apparent( julian_date JD )
+  {
+    return get_apparent( JD, &nutation_cache::local() );
+  }
+
+  double sidereal_time::get_apparent( julian_date JD, 
+   nutation_cache* cache )
+  {
+     // Nutation
+     nut nutation;
+
+     // Nutation changes slowly, a single number is enough for it.
+     sidereus::nutation( JD.get_jd(), &nutation, cache );
 
-     sidereal += hours;
+     return get_mean( JD ) + get_equinoxes( &nutation );
+  }
 
-     return sidereal;
+  double sidereal_time::get_equinoxes( const nut* nutation )
+  {
+     // Equ 12.b: nutation in longitude projected on the equator by 
+     // the true obliquity, degrees to hours.
+     return nutation->longitude * 
+            std::cos( GEN_GEOMETRY_DEGTORAD( nutation->ecliptic )) / 15.0;
   }
 
 }
@@ -43,6 +43,15 @@ namespace sidereus {
      */ 
     static double get_mean( double JD );
 
+    /**
+     * Calculate the mean sidereal time at the meridian of
+     * Greenwich of a two part Julian date.
+     *
+     * @param JD - Julian date.
+     * @return Mean sidereal time (hours).
+     */ 
+    static double get_mean( julian_date JD );
+
     /**
      * Calculate the apparent sidereal time at the meridian of 
      * Greenwich of a given date.
@@ -52,6 +61,47 @@ namespace sidereus {
      */ 
     static double get_apparent( double JD );
 
+    /**
+     * Calculate the apparent sidereal time at the meridian of 
+     * Greenwich of a given date, taking nutation from a caller 
+     * owned cache.
+     *
+     * @param JD - Julian day.
+     * @param cache - Nutation cache.
+     * @return Apparent sidereal time (hours).
+     */ 
+    static double get_apparent( double JD, nutation_cache* cache );
+
+    /**
+     * Calculate the apparent sidereal time at the meridian of 
+     * Greenwich of a two part Julian date.
+     *
+     * @param JD - Julian date.
+     * @return Apparent sidereal time (hours).
+     */ 
+    static double get_apparent( julian_date JD );
+
+    /**
+     * Calculate the apparent sidereal time at the meridian of 
+     * Greenwich of a two part Julian date, taking nutation from a 
+     * caller owned cache.
+     *
+     * @param JD - Julian date.
+     * @param cache - Nutation cache.
+     * @return Apparent sidereal time (hours).
+     */ 
+    static double get_apparent( julian_date JD, nutation_cache* cache );
+
+    /**
+     * Calculate the correction from mean to apparent sidereal time
+     * (equation of the equinoxes) for a given nutation, 
+     * delta psi cos( epsilon ).
+     *
+     * @param nutation - Nutation.
+     * @return Correction (hours).
+     */ 
+    static double get_equinoxes( const nut* nutation );
+
   };
 
 }
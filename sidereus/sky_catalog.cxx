@@ -0,0 +1,98 @@
+/**
+ * @file
+ *
+ * Implementation for an sky_catalog.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/sky_catalog.hxx>
+#include <sidereus/rotation.hxx>
+
+#include <algorithm>
+#include <cmath>
+
+namespace sidereus {
+
+  sky_catalog::sky_catalog( int level )
+   : index_( level )
+  {
+  }
+
+  void sky_catalog::build( const double* ra, const double* dec, 
+   size_t count )
+  {
+    genesis::proto_geo::point_rect_coord v;
+
+    index_.build( ra, dec, count );
+
+    x_.resize( count );
+    y_.resize( count );
+    z_.resize( count );
+
+    for( size_t i = 0; i < count; i++ ) {
+      rotation::get_rect( index_.get_ra()[i], index_.get_dec()[i], &v );
+
+      x_[i] = v.x;
+      y_[i] = v.y;
+      z_[i] = v.z;
+    }
+  }
+
+  size_t sky_catalog::get_count() const
+  {
+    return index_.get_count();
+  }
+
+  const sky_index& sky_catalog::get_index() const
+  {
+    return index_;
+  }
+
+  size_t sky_catalog::get_cone( double ra, double dec, double radius,
+   std::vector< size_t >* ids, std::vector< double >* distance ) const
+  {
+    genesis::proto_geo::point_rect_coord center;
+
+    std::vector< sky_index::range > ranges;
+
+    // Inside the cone if the dot product is above its cosine.
+    double limit = std::cos( GEN_GEOMETRY_DEGTORAD( 
+                              std::min( radius, 180.0 )));
+
+    const size_t* sorted_ids = index_.get_ids();
+
+    ids->clear();
+
+    if( distance ) {
+      distance->clear();
+    }
+
+    rotation::get_rect( ra, dec, &center );
+    index_.get_ranges( ra, dec, radius, &ranges );
+
+    for( size_t r = 0; r < ranges.size(); r++ ) {
+      for( size_t i = ranges[r].first; i < ranges[r].second; i++ ) {
+        double d = x_[i] * center.x + y_[i] * center.y + z_[i] * center.z;
+
+        if( d >= limit ) {
+          ids->push_back( sorted_ids[i] );
+
+          if( distance ) {
+            distance->push_back( GEN_GEOMETRY_RADTODEG( 
+             std::acos( std::min( 1.0, d ))));
+          }
+        }
+      }
+    }
+
+    return ids->size();
+  }
+
+}
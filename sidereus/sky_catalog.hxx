@@ -0,0 +1,100 @@
+/**
+ * @file
+ *
+ * Definitions for an sky_catalog.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#ifndef SIDEREUS_SKY_CATALOG_HPP
+#define SIDEREUS_SKY_CATALOG_HPP
+
+#include <sidereus/sky_index.hxx>
+
+#include <cstddef>
+#include <vector>
+
+namespace sidereus {
+  // Default level for cone searches, 6 * 4^8 cells of about 0.35 deg.
+  #define SKY_CATALOG_LEVEL 8
+
+  /**
+   * Sidereus Sky Catalog.
+   *
+   * Equatorial catalog for cone searches: the unit vector of every 
+   * object, stored as three arrays in sky_index order, so a search 
+   * only reads the few contiguous ranges of the cells around the cone 
+   * and tests them with a dot product, without trigonometry.
+   */
+  class sky_catalog {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param level - Subdivision level of the index.
+     */
+    explicit sky_catalog( int level = SKY_CATALOG_LEVEL );
+
+    /**
+     * Destructor.
+     */
+    ~sky_catalog() {};
+
+    /**
+     * Load a catalog, replacing the previous one.
+     *
+     * @param ra - Right ascensions (deg).
+     * @param dec - Declinations (deg).
+     * @param count - Number of objects.
+     */
+    void build( const double* ra, const double* dec, size_t count );
+
+    /**
+     * Get the number of objects.
+     *
+     * @return Objects.
+     */
+    size_t get_count() const;
+
+    /**
+     * Get the index, for its sorted positions and range queries.
+     *
+     * @return Sky index.
+     */
+    const sky_index& get_index() const;
+
+    /**
+     * Find the objects within a distance of a position.
+     *
+     * @param ra - Right ascension of the center (deg).
+     * @param dec - Declination of the center (deg).
+     * @param radius - Distance (deg).
+     * @param ids - Pointer to store the indices of the objects in the 
+     * loaded catalog, in index order.
+     * @param distance - Pointer to store their distances from the 
+     * center (deg), or NULL.
+     * @return Number of objects found.
+     */
+    size_t get_cone( double ra, double dec, double radius, 
+                     std::vector< size_t >* ids, 
+                     std::vector< double >* distance = 0 ) const;
+
+  private:
+    /// Sorted positions and cells.
+    sky_index index_;
+
+    /// Unit vectors in index order.
+    std::vector< double > x_;
+    std::vector< double > y_;
+    std::vector< double > z_;
+  };
+
+}
+
+#endif // SIDEREUS_SKY_CATALOG_HPP
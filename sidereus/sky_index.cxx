@@ -0,0 +1,321 @@
+/**
+ * @file
+ *
+ * Implementation for an sky_index.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/sky_index.hxx>
+#include <sidereus/rotation.hxx>
+
+#include <algorithm>
+#include <cmath>
+
+namespace sidereus {
+
+/**
+ * This namespace works as if anything inside it were declared
+ * staticaly in each source file.
+ */
+namespace {
+
+  // Margin of the cell tests, for rounding in the angles (deg).
+  const double CELL_MARGIN = 1e-9;
+
+  // Face of the cube a direction goes through, 2 * axis + 1 on the 
+  // negative side, and the other two components over the major one.
+  void get_face( const genesis::proto_geo::point_rect_coord* v, 
+   int* face, double* u, double* w )
+  {
+    double c[3] = { v->x, v->y, v->z };
+
+    int k = 0;
+
+    if( std::fabs( c[1] ) > std::fabs( c[k] )) {
+      k = 1;
+    }
+
+    if( std::fabs( c[2] ) > std::fabs( c[k] )) {
+      k = 2;
+    }
+
+    *face = 2 * k + ( c[k] < 0.0 ? 1 : 0 );
+    *u = c[( k + 1 ) % 3] / std::fabs( c[k] );
+    *w = c[( k + 2 ) % 3] / std::fabs( c[k] );
+  }
+
+  // Unit vector of a point of a face.
+  void get_vector( int face, double u, double w, 
+   genesis::proto_geo::point_rect_coord* v )
+  {
+    double c[3];
+    double norm = std::sqrt( 1.0 + u * u + w * w );
+
+    int k = face / 2;
+
+    c[k] = ( face % 2 ? -1.0 : 1.0 ) / norm;
+    c[( k + 1 ) % 3] = u / norm;
+    c[( k + 2 ) % 3] = w / norm;
+
+    v->x = c[0];
+    v->y = c[1];
+    v->z = c[2];
+  }
+
+  // Face coordinate to [-1, 1] grid coordinate with equal angles 
+  // between grid lines, and back.
+  double to_grid( double u )
+  {
+    return std::atan( u ) * 4.0 / M_PI;
+  }
+
+  double from_grid( double g )
+  {
+    return std::tan( g * M_PI / 4.0 );
+  }
+
+  // Z-order of a cell in its face, bits of i even and of j odd.
+  unsigned long long interleave( unsigned i, unsigned j )
+  {
+    unsigned long long code = 0;
+
+    for( int b = 0; b < SKY_INDEX_MAX_LEVEL; b++ ) {
+      code |= ( unsigned long long )(( i >> b ) & 1 ) << ( 2 * b );
+      code |= ( unsigned long long )(( j >> b ) & 1 ) << ( 2 * b + 1 );
+    }
+
+    return code;
+  }
+
+  // Angle between unit vectors (deg).
+  double get_angle( const genesis::proto_geo::point_rect_coord* a,
+   const genesis::proto_geo::point_rect_coord* b )
+  {
+    double d = a->x * b->x + a->y * b->y + a->z * b->z;
+
+    return GEN_GEOMETRY_RADTODEG( std::acos( std::max( -1.0, 
+                                             std::min( 1.0, d ))));
+  }
+}
+
+  sky_index::sky_index( int level )
+   : level_( std::max( 0, std::min( level, SKY_INDEX_MAX_LEVEL )))
+  {
+  }
+
+  void sky_index::build( const double* ra, const double* dec, 
+   size_t count )
+  {
+    std::vector< std::pair< unsigned long long, size_t > > order( count );
+
+    for( size_t i = 0; i < count; i++ ) {
+      order[i].first = get_cell( ra[i], dec[i], level_ );
+      order[i].second = i;
+    }
+
+    std::sort( order.begin(), order.end() );
+
+    cells_.resize( count );
+    ra_.resize( count );
+    dec_.resize( count );
+    ids_.resize( count );
+
+    for( size_t i = 0; i < count; i++ ) {
+      cells_[i] = order[i].first;
+      ids_[i] = order[i].second;
+      ra_[i] = ra[ids_[i]];
+      dec_[i] = dec[ids_[i]];
+    }
+  }
+
+  int sky_index::get_level() const
+  {
+    return level_;
+  }
+
+  size_t sky_index::get_count() const
+  {
+    return ids_.size();
+  }
+
+  const double* sky_index::get_ra() const
+  {
+    return ra_.empty() ? 0 : &ra_[0];
+  }
+
+  const double* sky_index::get_dec() const
+  {
+    return dec_.empty() ? 0 : &dec_[0];
+  }
+
+  const size_t* sky_index::get_ids() const
+  {
+    return ids_.empty() ? 0 : &ids_[0];
+  }
+
+  unsigned long long sky_index::get_cell( double ra, double dec, 
+   int level )
+  {
+    genesis::proto_geo::point_rect_coord v;
+
+    unsigned n = 1u << level;
+
+    double u = 0.0, w = 0.0;
+
+    int face = 0;
+
+    rotation::get_rect( ra, dec, &v );
+    get_face( &v, &face, &u, &w );
+
+    unsigned i = std::min( n - 1, ( unsigned )(( to_grid( u ) + 1.0 ) * 
+                                               0.5 * n ));
+    unsigned j = std::min( n - 1, ( unsigned )(( to_grid( w ) + 1.0 ) * 
+                                               0.5 * n ));
+
+    return (( unsigned long long )face << ( 2 * level )) + 
+           interleave( i, j );
+  }
+
+  void sky_index::get_ranges( double ra, double dec, double radius,
+   std::vector< range >* ranges ) const
+  {
+    genesis::proto_geo::point_rect_coord center;
+
+    ranges->clear();
+
+    if( radius < 0.0 || cells_.empty() ) {
+      return;
+    }
+
+    rotation::get_rect( ra, dec, &center );
+
+    for( int face = 0; face < 6; face++ ) {
+      descend( face, 0, 0, 0, &center, radius, ranges );
+    }
+  }
+
+  void sky_index::get_visible( const observer* site, double sidereal,
+   double altitude, std::vector< range >* ranges ) const
+  {
+    genesis::proto_geo::point_lon_lat_posn position;
+
+    site->get_position( &position );
+
+    // The altitude of an object is 90 deg less its distance from the 
+    // zenith, which is at the local sidereal time and the latitude.
+    get_ranges( sidereal * 15.0 + position.lon, position.lat, 
+                90.0 - altitude, ranges );
+  }
+
+  void sky_index::get_hrz( const observer* site, double sidereal,
+   double altitude, std::vector< size_t >* ids, std::vector< double >* alt,
+   std::vector< double >* az ) const
+  {
+    std::vector< range > ranges;
+    std::vector< double > range_alt, range_az;
+
+    ids->clear();
+    alt->clear();
+    az->clear();
+
+    // Cull on the true altitude of the limit, the transform returns 
+    // apparent ones when the site refracts.
+    get_visible( site, sidereal, site->get_refraction() ? 
+                 site->get_refraction()->get_true( altitude ) : altitude, 
+                 &ranges );
+
+    for( size_t r = 0; r < ranges.size(); r++ ) {
+      size_t first = ranges[r].first;
+      size_t n = ranges[r].second - first;
+
+      range_alt.resize( n );
+      range_az.resize( n );
+
+      site->get_hrz_from_equ_sidereal_time( &ra_[first], &dec_[first], n,
+                                            sidereal, &range_alt[0], 
+                                            &range_az[0] );
+
+      // Cells on the edge of the cap hold objects just below it.
+      for( size_t i = 0; i < n; i++ ) {
+        if( range_alt[i] >= altitude ) {
+          ids->push_back( ids_[first + i] );
+          alt->push_back( range_alt[i] );
+          az->push_back( range_az[i] );
+        }
+      }
+    }
+  }
+
+  void sky_index::descend( int face, int level, unsigned i, unsigned j,
+   const genesis::proto_geo::point_rect_coord* center, double radius,
+   std::vector< range >* ranges ) const
+  {
+    genesis::proto_geo::point_rect_coord middle, corner;
+
+    double size = 2.0 / ( 1u << level );
+    double g0 = -1.0 + i * size, h0 = -1.0 + j * size;
+    double cell_radius = 0.0, distance = 0.0;
+
+    get_vector( face, from_grid( g0 + size / 2.0 ), 
+                from_grid( h0 + size / 2.0 ), &middle );
+
+    // Cell edges are great circles, so the cell is inside the circle 
+    // through its farthest corner.
+    for( int k = 0; k < 4; k++ ) {
+      get_vector( face, from_grid( g0 + ( k & 1 ) * size ), 
+                  from_grid( h0 + ( k >> 1 ) * size ), &corner );
+      cell_radius = std::max( cell_radius, get_angle( &middle, &corner ));
+    }
+
+    distance = get_angle( &middle, center );
+
+    if( distance > radius + cell_radius + CELL_MARGIN ) {
+      return;
+    }
+
+    // Whole cell inside, or finest level: all the cells below it.
+    if( distance + cell_radius <= radius || level == level_ ) {
+      int shift = 2 * ( level_ - level );
+
+      unsigned long long first = 
+       (( unsigned long long )face << ( 2 * level_ )) + 
+       ( interleave( i, j ) << shift );
+
+      add_cells( first, first + ( 1ULL << shift ), ranges );
+      return;
+    }
+
+    // Children in cell number order.
+    for( int k = 0; k < 4; k++ ) {
+      descend( face, level + 1, 2 * i + ( k & 1 ), 2 * j + ( k >> 1 ),
+               center, radius, ranges );
+    }
+  }
+
+  void sky_index::add_cells( unsigned long long first, 
+   unsigned long long end, std::vector< range >* ranges ) const
+  {
+    size_t b = std::lower_bound( cells_.begin(), cells_.end(), first ) - 
+               cells_.begin();
+    size_t e = std::lower_bound( cells_.begin() + b, cells_.end(), end ) - 
+               cells_.begin();
+
+    if( b == e ) {
+      return;
+    }
+
+    if( !ranges->empty() && ranges->back().second == b ) {
+      ranges->back().second = e;
+    } else {
+      ranges->push_back( range( b, e ));
+    }
+  }
+
+}
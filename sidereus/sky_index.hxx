@@ -0,0 +1,190 @@
+/**
+ * @file
+ *
+ * Definitions for an sky_index.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#ifndef SIDEREUS_SKY_INDEX_HPP
+#define SIDEREUS_SKY_INDEX_HPP
+
+#include <sidereus/observer.hxx>
+
+#include <genesis/geometry.hxx>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace sidereus {
+  // Default subdivision level, 6 * 4^6 cells of about 1.4 deg.
+  #define SKY_INDEX_LEVEL 6
+
+  // Deepest level, cell numbers must fit in 64 bits.
+  #define SKY_INDEX_MAX_LEVEL 24
+
+  /**
+   * Sidereus Sky Index.
+   *
+   * Equatorial catalog sorted along a hierarchical tessellation of the 
+   * sky: the six faces of a cube, each split into 2^level x 2^level 
+   * cells with equal angle spacing, numbered so that every cell at 
+   * any level covers one contiguous run of the finest cells (a 
+   * Z-order curve inside each face). The objects are kept sorted by 
+   * cell, so the objects of any set of cells are a few contiguous 
+   * ranges of the catalog.
+   *
+   * Queries descend from the faces, keeping whole cells that are 
+   * inside the searched cap and splitting those crossing its edge, 
+   * so they return every object within the cap and some just outside 
+   * it. Horizon culling is the cap around the zenith.
+   */
+  class sky_index {
+  public:
+    /// Range of sorted objects, first and one past the last.
+    typedef std::pair< size_t, size_t > range;
+
+    /**
+     * Constructor.
+     *
+     * @param level - Subdivision level of the finest cells, up to 
+     * SKY_INDEX_MAX_LEVEL.
+     */
+    explicit sky_index( int level = SKY_INDEX_LEVEL );
+
+    /**
+     * Destructor.
+     */
+    ~sky_index() {};
+
+    /**
+     * Index a catalog, replacing the previous one.
+     *
+     * @param ra - Right ascensions (deg).
+     * @param dec - Declinations (deg).
+     * @param count - Number of objects.
+     */
+    void build( const double* ra, const double* dec, size_t count );
+
+    /**
+     * Get the subdivision level.
+     *
+     * @return Level of the finest cells.
+     */
+    int get_level() const;
+
+    /**
+     * Get the number of indexed objects.
+     *
+     * @return Objects.
+     */
+    size_t get_count() const;
+
+    /**
+     * Get the right ascensions, sorted by cell.
+     *
+     * @return Array of get_count() right ascensions (deg).
+     */
+    const double* get_ra() const;
+
+    /**
+     * Get the declinations, sorted by cell.
+     *
+     * @return Array of get_count() declinations (deg).
+     */
+    const double* get_dec() const;
+
+    /**
+     * Get the position of each sorted object in the built catalog.
+     *
+     * @return Array of get_count() indices.
+     */
+    const size_t* get_ids() const;
+
+    /**
+     * Get the cell holding a position.
+     *
+     * @param ra - Right ascension (deg).
+     * @param dec - Declination (deg).
+     * @param level - Subdivision level.
+     * @return Cell number, less than 6 * 4^level.
+     */
+    static unsigned long long get_cell( double ra, double dec, int level );
+
+    /**
+     * Get the objects of the cells that reach within a distance of a 
+     * position.
+     *
+     * @param ra - Right ascension of the center (deg).
+     * @param dec - Declination of the center (deg).
+     * @param radius - Distance (deg).
+     * @param ranges - Pointer to store ranges of sorted objects, in 
+     * order and not adjacent.
+     */
+    void get_ranges( double ra, double dec, double radius,
+                     std::vector< range >* ranges ) const;
+
+    /**
+     * Get the objects of the cells that reach above an altitude.
+     *
+     * @param site - Observer.
+     * @param sidereal - Sidereal Time (hours).
+     * @param altitude - Lowest altitude (deg).
+     * @param ranges - Pointer to store ranges of sorted objects.
+     */
+    void get_visible( const observer* site, double sidereal, 
+                      double altitude, std::vector< range >* ranges ) 
+     const;
+
+    /**
+     * Transform the objects above an altitude into horizontal 
+     * coordinates, running the transform on the visible cells only.
+     *
+     * @param site - Observer.
+     * @param sidereal - Sidereal Time (hours).
+     * @param altitude - Lowest altitude (deg).
+     * @param ids - Pointer to store the indices of the visible 
+     * objects in the built catalog.
+     * @param alt - Pointer to store their altitudes (deg).
+     * @param az - Pointer to store their azimuths (deg).
+     */
+    void get_hrz( const observer* site, double sidereal, double altitude,
+                  std::vector< size_t >* ids, std::vector< double >* alt,
+                  std::vector< double >* az ) const;
+
+  private:
+    /// Add the objects of a cell and its children within the cap.
+    void descend( int face, int level, unsigned i, unsigned j, 
+                  const genesis::proto_geo::point_rect_coord* center, 
+                  double radius, std::vector< range >* ranges ) const;
+
+    /// Add the objects of a run of finest cells.
+    void add_cells( unsigned long long first, unsigned long long end,
+                    std::vector< range >* ranges ) const;
+
+    /// Level of the finest cells.
+    int level_;
+
+    /// Finest cell of each sorted object.
+    std::vector< unsigned long long > cells_;
+
+    /// Sorted right ascensions (deg).
+    std::vector< double > ra_;
+
+    /// Sorted declinations (deg).
+    std::vector< double > dec_;
+
+    /// Index of each sorted object in the built catalog.
+    std::vector< size_t > ids_;
+  };
+
+}
+
+#endif // SIDEREUS_SKY_INDEX_HPP
@@ -0,0 +1,164 @@
+/**
+ * @file
+ *
+ * Implementation for an space_motion.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/space_motion.hxx>
+#include <sidereus/vector_math.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace sidereus {
+
+  void space_motion::propagate( const astrometry_columns* columns, 
+   size_t count, double fromJD, double toJD, const rotation* frame, 
+   unsigned threads )
+  {
+    std::vector< std::thread > workers;
+
+    // Julian years.
+    double t = ( toJD - fromJD ) / 365.25;
+
+    size_t shares = std::max( ( size_t )1, std::min(( size_t )threads, 
+                     count / SPACE_MOTION_SHARE ));
+
+    // Contiguous shares, the stars are independent.
+    for( size_t s = 1; s < shares; s++ ) {
+      workers.push_back( std::thread( &space_motion::propagate_range, 
+                                      columns, count * s / shares, 
+                                      count * ( s + 1 ) / shares, t, 
+                                      frame ));
+    }
+
+    propagate_range( columns, 0, count / shares, t, frame );
+
+    for( size_t s = 0; s < workers.size(); s++ ) {
+      workers[s].join();
+    }
+  }
+
+  void space_motion::propagate_range( const astrometry_columns* columns,
+   size_t first, size_t end, double t, const rotation* frame )
+  {
+    const double MAS = GEN_GEOMETRY_DEGTORAD( 1.0 / 3600000.0 );
+
+    rotation m;
+
+    double a[VECTOR_MATH_CHUNK], d[VECTOR_MATH_CHUNK],
+           sin_a[VECTOR_MATH_CHUNK], cos_a[VECTOR_MATH_CHUNK],
+           sin_d[VECTOR_MATH_CHUNK], cos_d[VECTOR_MATH_CHUNK],
+           x[VECTOR_MATH_CHUNK], y[VECTOR_MATH_CHUNK], 
+           z[VECTOR_MATH_CHUNK], mx[VECTOR_MATH_CHUNK], 
+           my[VECTOR_MATH_CHUNK], mz[VECTOR_MATH_CHUNK], 
+           rho[VECTOR_MATH_CHUNK];
+
+    if( frame ) {
+      m = *frame;
+    }
+
+    for( size_t chunk = first; chunk < end; chunk += VECTOR_MATH_CHUNK ) {
+      size_t n = std::min( end - chunk, ( size_t )VECTOR_MATH_CHUNK );
+
+      double* ra = columns->ra + chunk;
+      double* dec = columns->dec + chunk;
+      double* pmra = columns->pmra + chunk;
+      double* pmdec = columns->pmdec + chunk;
+      double* parallax = columns->parallax ? columns->parallax + chunk : 0;
+      double* rv = columns->rv ? columns->rv + chunk : 0;
+
+      for( size_t i = 0; i < n; i++ ) {
+        a[i] = GEN_GEOMETRY_DEGTORAD( ra[i] );
+        d[i] = GEN_GEOMETRY_DEGTORAD( dec[i] );
+      }
+
+      vector_math::sincos( a, sin_a, cos_a, n );
+      vector_math::sincos( d, sin_d, cos_d, n );
+
+      for( size_t i = 0; i < n; i++ ) {
+        double plx = parallax ? parallax[i] : 0.0;
+
+        // Proper motions in rad/yr, the radial one from the radial 
+        // velocity; without a distance there is none.
+        double pa = pmra[i] * MAS, pd = pmdec[i] * MAS;
+        double pr = ( rv && plx > 0.0 ) ? 
+                    rv[i] * plx / SPACE_MOTION_AU_KM_YEAR_S * MAS : 0.0;
+
+        // Direction r and the directions p, q of increasing ra and dec.
+        double rx = cos_d[i] * cos_a[i], ry = cos_d[i] * sin_a[i], 
+               rz = sin_d[i];
+        double tx = -sin_a[i] * pa - sin_d[i] * cos_a[i] * pd;
+        double ty = cos_a[i] * pa - sin_d[i] * sin_a[i] * pd;
+        double tz = cos_d[i] * pd;
+
+        // In units of the old distance the star moves w along r and 
+        // t across it; f is the old distance over the new one. The 
+        // new proper motion is tangential, the radial one changes 
+        // separately.
+        double mu2 = pa * pa + pd * pd;
+        double w = 1.0 + pr * t;
+        double f = 1.0 / std::sqrt( w * w + mu2 * t * t );
+        double f3 = f * f * f;
+
+        double ux = ( rx * w + tx * t ) * f;
+        double uy = ( ry * w + ty * t ) * f;
+        double uz = ( rz * w + tz * t ) * f;
+
+        double vx = ( tx * w - rx * mu2 * t ) * f3;
+        double vy = ( ty * w - ry * mu2 * t ) * f3;
+        double vz = ( tz * w - rz * mu2 * t ) * f3;
+
+        x[i] = m.m[0][0] * ux + m.m[0][1] * uy + m.m[0][2] * uz;
+        y[i] = m.m[1][0] * ux + m.m[1][1] * uy + m.m[1][2] * uz;
+        z[i] = m.m[2][0] * ux + m.m[2][1] * uy + m.m[2][2] * uz;
+        mx[i] = m.m[0][0] * vx + m.m[0][1] * vy + m.m[0][2] * vz;
+        my[i] = m.m[1][0] * vx + m.m[1][1] * vy + m.m[1][2] * vz;
+        mz[i] = m.m[2][0] * vx + m.m[2][1] * vy + m.m[2][2] * vz;
+        rho[i] = std::sqrt( x[i] * x[i] + y[i] * y[i] );
+
+        if( parallax ) {
+          parallax[i] = plx * f;
+        }
+
+        // The new radial velocity from the new radial proper motion 
+        // and parallax, f cancels out of the distance.
+        if( rv && plx > 0.0 ) {
+          rv[i] = ( pr + ( mu2 + pr * pr ) * t ) * f * f / 
+                  ( MAS * plx * f ) * SPACE_MOTION_AU_KM_YEAR_S;
+        }
+      }
+
+      vector_math::atan2( y, x, a, n );
+      vector_math::atan2( z, rho, d, n );
+
+      for( size_t i = 0; i < n; i++ ) {
+        double right = GEN_GEOMETRY_RADTODEG( a[i] );
+
+        // cos dec is rho and sin dec is z, p = ( -y, x, 0 ) / rho and 
+        // q = ( -z x, -z y, rho^2 ) / rho; undefined at the poles.
+        double inverse = rho[i] > 0.0 ? 1.0 / rho[i] : 0.0;
+
+        // Just below zero the sum rounds to 360, which is 0.
+        right += right < 0.0 ? 360.0 : 0.0;
+        ra[i] = right < 360.0 ? right : 0.0;
+        dec[i] = GEN_GEOMETRY_RADTODEG( d[i] );
+        pmra[i] = ( x[i] * my[i] - y[i] * mx[i] ) * inverse / MAS;
+        pmdec[i] = ( rho[i] * rho[i] * mz[i] - 
+                     z[i] * ( x[i] * mx[i] + y[i] * my[i] )) * 
+                   inverse / MAS;
+      }
+    }
+  }
+
+}
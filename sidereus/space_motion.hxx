@@ -0,0 +1,86 @@
+/**
+ * @file
+ *
+ * Definitions for an space_motion.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#ifndef SIDEREUS_SPACE_MOTION_HPP
+#define SIDEREUS_SPACE_MOTION_HPP
+
+#include <sidereus/rotation.hxx>
+
+#include <cstddef>
+
+namespace sidereus {
+  // Astronomical unit in km times seconds per Julian year, turns 
+  // parallax times radial velocity into a radial proper motion.
+  #define SPACE_MOTION_AU_KM_YEAR_S 4.740470463533348
+
+  // Fewest stars worth a thread of their own.
+  #define SPACE_MOTION_SHARE 16384
+
+  /**
+   * Columns of a catalog with five or six parameter astrometry. Every 
+   * column holds one value per star.
+   */
+  struct astrometry_columns {
+    double* ra;       ///< Right ascensions (deg).
+    double* dec;      ///< Declinations (deg).
+    double* pmra;     ///< Proper motions in ra times cos dec (mas/yr).
+    double* pmdec;    ///< Proper motions in dec (mas/yr).
+    double* parallax; ///< Parallaxes (mas), NULL for 0.
+    double* rv;       ///< Radial velocities (km/s), NULL for 0.
+  };
+
+  /**
+   * Sidereus Space Motion.
+   *
+   * Rigorous propagation of stars in time, uniform motion along a 
+   * straight line (Hipparcos catalogue vol. 1, 1.5.5, without light 
+   * time). Positions, proper motions, parallaxes and radial 
+   * velocities are all brought to the new epoch, the radial velocity 
+   * taking part through the radial proper motion; stars without 
+   * parallax keep their tangential motion only.
+   *
+   * The catalog is updated in place, column by column, in chunks of 
+   * VECTOR_MATH_CHUNK stars, and optionally turned to another frame 
+   * such as the equator and equinox of date, so that propagation and 
+   * precession are a single pass.
+   */
+  class space_motion {
+  public:
+    /**
+     * Propagate a catalog between two epochs.
+     *
+     * @param columns - Catalog, updated in place. Parallaxes and 
+     * radial velocities are only updated if the columns exist.
+     * @param count - Number of stars.
+     * @param fromJD - Julian day of the catalog epoch.
+     * @param toJD - Julian day of the new epoch.
+     * @param frame - Rotation to the frame of the results, e.g. from 
+     * frames::get_precession(), or NULL to stay in the catalog frame.
+     * @param threads - Number of threads, including the caller.
+     */
+    static void propagate( const astrometry_columns* columns, size_t count,
+                           double fromJD, double toJD, 
+                           const rotation* frame = 0, 
+                           unsigned threads = 1 );
+
+  private:
+    /// Propagate a contiguous range of stars.
+    static void propagate_range( const astrometry_columns* columns, 
+                                 size_t first, size_t end, double t, 
+                                 const rotation* frame );
+  };
+
+}
+
+#endif // SIDEREUS_SPACE_MOTION_HPP
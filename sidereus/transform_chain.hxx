@@ -0,0 +1,303 @@
+/**
+ * @file
+ *
+ * Definitions for an transform_chain.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#ifndef SIDEREUS_TRANSFORM_CHAIN_HPP
+#define SIDEREUS_TRANSFORM_CHAIN_HPP
+
+#include <sidereus/epoch.hxx>
+#include <sidereus/frames.hxx>
+#include <sidereus/julian_day.hxx>
+#include <sidereus/observer.hxx>
+#include <sidereus/rotation.hxx>
+
+#include <cstddef>
+
+namespace sidereus {
+  /**
+   * Instant and place of a chain, stages that need neither ignore it.
+   */
+  struct chain_context {
+    const epoch* frame;  ///< Epoch, for stages of date.
+    const observer* site; ///< Observer, for horizontal stages.
+  };
+
+  /**
+   * Equinoxes of the precession stage. A fixed equinox is constant,
+   * the equinox of date takes the Julian Day of the context epoch.
+   */
+  struct equinox_b1950 {
+    static const bool constant = true;
+
+    static double get_jd( const chain_context* )
+    {
+      return JULIAN_DAY_B1950;
+    }
+  };
+
+  struct equinox_j2000 {
+    static const bool constant = true;
+
+    static double get_jd( const chain_context* )
+    {
+      return JULIAN_DAY_JD2000;
+    }
+  };
+
+  struct equinox_date {
+    static const bool constant = false;
+
+    static double get_jd( const chain_context* context )
+    {
+      return context->frame->get_jd();
+    }
+  };
+
+  /**
+   * Stages of a chain. Each one gives the rotation of its step and
+   * tells whether that rotation is the same for every context.
+   */
+  struct gal_to_equ1950 {
+    static const bool constant = true;
+
+    static rotation get( const chain_context* )
+    {
+      return frames::get_gal_from_b1950().transpose();
+    }
+  };
+
+  struct equ1950_to_gal {
+    static const bool constant = true;
+
+    static rotation get( const chain_context* )
+    {
+      return frames::get_gal_from_b1950();
+    }
+  };
+
+  struct gal_to_equ2000 {
+    static const bool constant = true;
+
+    static rotation get( const chain_context* )
+    {
+      return frames::get_gal_from_equ2000().transpose();
+    }
+  };
+
+  struct equ2000_to_gal {
+    static const bool constant = true;
+
+    static rotation get( const chain_context* )
+    {
+      return frames::get_gal_from_equ2000();
+    }
+  };
+
+  template< typename From, typename To >
+  struct precess {
+    static const bool constant = From::constant && To::constant;
+
+    static rotation get( const chain_context* context )
+    {
+      return frames::get_precession( From::get_jd( context ),
+                                     To::get_jd( context ));
+    }
+  };
+
+  struct equ_to_ecl {
+    static const bool constant = false;
+
+    static rotation get( const chain_context* context )
+    {
+      return frames::get_ecl_from_equ( context->frame );
+    }
+  };
+
+  struct ecl_to_equ {
+    static const bool constant = false;
+
+    static rotation get( const chain_context* context )
+    {
+      return frames::get_ecl_from_equ( context->frame ).transpose();
+    }
+  };
+
+  struct equ_to_hrz {
+    static const bool constant = false;
+
+    static rotation get( const chain_context* context )
+    {
+      return frames::get_hrz_from_equ( context->site, context->frame );
+    }
+  };
+
+  struct hrz_to_equ {
+    static const bool constant = false;
+
+    static rotation get( const chain_context* context )
+    {
+      return frames::get_hrz_from_equ( context->site,
+                                       context->frame ).transpose();
+    }
+  };
+
+  /**
+   * Two constant stages fused into one, multiplied once.
+   */
+  template< typename A, typename B >
+  struct fused_stage {
+    static const bool constant = true;
+
+    static rotation get( const chain_context* context )
+    {
+      static const rotation matrix = B::get( context ) * A::get( context );
+
+      return matrix;
+    }
+  };
+
+  /**
+   * True if the first two stages of a list are constant.
+   */
+  template< typename... S >
+  struct pair_constant {
+    static const bool value = false;
+  };
+
+  template< typename A, typename B, typename... R >
+  struct pair_constant< A, B, R... > {
+    static const bool value = A::constant && B::constant;
+  };
+
+  /**
+   * Product of a list of stages, fusing each run of constant stages
+   * into one matrix computed on first use.
+   */
+  template< bool fuse, typename... S >
+  struct chain_product;
+
+  template< bool fuse, typename S >
+  struct chain_product< fuse, S > {
+    static const bool constant = S::constant;
+
+    static rotation get( const chain_context* context )
+    {
+      return S::get( context );
+    }
+  };
+
+  template< typename A, typename B, typename... R >
+  struct chain_product< true, A, B, R... > {
+    typedef chain_product< pair_constant< fused_stage< A, B >, R... >::value,
+                           fused_stage< A, B >, R... > rest;
+
+    static const bool constant = rest::constant;
+
+    static rotation get( const chain_context* context )
+    {
+      return rest::get( context );
+    }
+  };
+
+  template< typename A, typename B, typename... R >
+  struct chain_product< false, A, B, R... > {
+    typedef chain_product< pair_constant< B, R... >::value, B, R... > rest;
+
+    static const bool constant = A::constant && rest::constant;
+
+    static rotation get( const chain_context* context )
+    {
+      return rest::get( context ) * A::get( context );
+    }
+  };
+
+  /**
+   * Sidereus Transform Chain.
+   *
+   * Chain of frame transforms put together at compile time, first
+   * stage applied first, e.g.
+   *
+   *   transform_chain< gal_to_equ1950,
+   *                    precess< equinox_b1950, equinox_j2000 >,
+   *                    equ_to_hrz >
+   *
+   * Every stage is a rotation, so the whole chain is one matrix: runs
+   * of constant stages are multiplied once per program, the others
+   * once per call, and the objects go through a single loop from
+   * spherical coordinates to spherical coordinates.
+   *
+   * Horizontal coordinates are stored as ( azimuth, altitude ), with
+   * 0 deg azimuth = south, 90 deg = west.
+   */
+  template< typename... S >
+  class transform_chain {
+    /// Stages multiplied together.
+    typedef chain_product< pair_constant< S... >::value, S... > product;
+
+  public:
+    /// True if the chain needs no epoch and no observer.
+    static const bool constant = product::constant;
+
+    /**
+     * Get the matrix of the whole chain.
+     *
+     * @param frame - Epoch, may be NULL if no stage is of date.
+     * @param site - Observer, may be NULL if no stage is horizontal.
+     * @return Matrix.
+     */
+    static rotation get_matrix( const epoch* frame = 0,
+                                const observer* site = 0 )
+    {
+      chain_context context = { frame, site };
+
+      return product::get( &context );
+    }
+
+    /**
+     * Transform arrays of spherical coordinates.
+     *
+     * @param lon - Longitudes or right ascensions (deg).
+     * @param lat - Latitudes or declinations (deg).
+     * @param count - Number of objects.
+     * @param out_lon - Array to store longitudes in [0, 360) (deg).
+     * @param out_lat - Array to store latitudes (deg).
+     * @param frame - Epoch, may be NULL if no stage is of date.
+     * @param site - Observer, may be NULL if no stage is horizontal.
+     */
+    static void apply( const double* lon, const double* lat, size_t count,
+                       double* out_lon, double* out_lat,
+                       const epoch* frame = 0, const observer* site = 0 )
+    {
+      get_matrix( frame, site ).apply( lon, lat, count, out_lon, out_lat );
+    }
+
+    /**
+     * Transform arrays of rectangular vectors in place.
+     *
+     * @param x - X components.
+     * @param y - Y components.
+     * @param z - Z components.
+     * @param count - Number of vectors.
+     * @param frame - Epoch, may be NULL if no stage is of date.
+     * @param site - Observer, may be NULL if no stage is horizontal.
+     */
+    static void apply( double* x, double* y, double* z, size_t count,
+                       const epoch* frame = 0, const observer* site = 0 )
+    {
+      get_matrix( frame, site ).apply( x, y, z, count );
+    }
+  };
+
+}
+
+#endif // SIDEREUS_TRANSFORM_CHAIN_HPP
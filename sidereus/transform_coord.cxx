@@ -13,11 +13,80 @@
  */
 
 #include <sidereus/transform_coord.hxx>
+#include <sidereus/frames.hxx>
+#include <sidereus/observer.hxx>
 #include <sidereus/precession.hxx>
+#include <sidereus/rotation.hxx>
 #include <sidereus/sidereal_time.hxx>
 
 namespace sidereus {
 
+/**
+ * This namespace works as if anything inside it were declared
+ * staticaly in each source file.
+ */
+namespace {
+
+  // Equ 12.3, 12.4 for a given obliquity of the ecliptic.
+  void equ_from_ecl( genesis::proto_geo::point_lon_lat_posn* object,
+   double sin_e, double cos_e,
+   genesis::proto_geo::point_equ_posn* position )
+  {
+    double ra = 0.0, declination = 0.0, 
+           longitude = 0.0, latitude = 0.0;
+
+    // Change object's position into radians.
+    longitude = GEN_GEOMETRY_DEGTORAD( object->lon );
+    latitude = GEN_GEOMETRY_DEGTORAD( object->lat );
+
+    ra = std::atan2(( std::sin( longitude ) * cos_e -
+         std::tan( latitude ) * sin_e ), std::cos ( longitude ) );
+    declination = std::sin( latitude ) * cos_e + 
+                  std::cos( latitude ) * sin_e * std::sin( longitude );
+    declination = std::asin( declination );
+
+    // Store in position.
+    position->ra = genesis::geometry::range_degrees(
+                    GEN_GEOMETRY_RADTODEG( ra ) );
+
+    // range_degrees() takes just below zero to 360; that is 0.
+    if( position->ra >= 360.0 ) {
+      position->ra = 0.0;
+    }
+
+    position->dec = GEN_GEOMETRY_RADTODEG( declination );
+  }
+
+  // Equ 12.1, 12.2 for a given obliquity of the ecliptic.
+  void ecl_from_equ( genesis::proto_geo::point_equ_posn* object,
+   double sin_e, double cos_e,
+   genesis::proto_geo::point_lon_lat_posn* position )
+  {
+    double ra = 0.0, declination = 0.0,
+           longitude = 0.0, latitude = 0.0;
+
+    // Object position:
+    ra = GEN_GEOMETRY_DEGTORAD( object->ra );
+    declination = GEN_GEOMETRY_DEGTORAD( object->dec );
+
+    longitude = std::atan2(( std::sin( ra ) * cos_e + 
+                std::tan( declination ) * sin_e ), std::cos( ra ));
+    latitude = std::sin( declination ) * cos_e - 
+               std::cos( declination ) * sin_e * std::sin( ra );
+    latitude = std::asin( latitude );
+
+    // Store in position.
+    position->lat = GEN_GEOMETRY_RADTODEG( latitude );
+    position->lon = genesis::geometry::range_degrees( 
+                     GEN_GEOMETRY_RADTODEG( longitude ) );
+
+    if( position->lon >= 360.0 ) {
+      position->lon = 0.0;
+    }
+  }
+
+}
+
   void transform_coord::get_hrz_from_equ( 
    genesis::proto_geo::point_equ_posn* object,
    genesis::proto_geo::point_lon_lat_posn* observer, double JD,
@@ -32,115 +101,163 @@ namespace sidereus {
     get_hrz_from_equ_sidereal_time( object, observer, sidereal, position );
   }
 
+  void transform_coord::get_hrz_from_equ( 
+   genesis::proto_geo::point_equ_posn* object,
+   genesis::proto_geo::point_lon_lat_posn* observer, julian_date JD,
+   genesis::proto_geo::point_hrz_posn* position )
+  {
+    get_hrz_from_equ_sidereal_time( object, observer, 
+                                    sidereus::sidereal_time::get_mean( JD ),
+                                    position );
+  }
+
+  void transform_coord::get_hrz_from_equ( 
+   genesis::proto_geo::point_equ_posn* object,
+   genesis::proto_geo::point_lon_lat_posn* observer, const epoch* frame,
+   genesis::proto_geo::point_hrz_posn* position )
+  {
+    get_hrz_from_equ_sidereal_time( object, observer, 
+                                    frame->get_mean_sidereal(), position );
+  }
+
   void transform_coord::get_hrz_from_equ_sidereal_time( 
    genesis::proto_geo::point_equ_posn* object, 
    genesis::proto_geo::point_lon_lat_posn* observer,
    double sidereal,
    genesis::proto_geo::point_hrz_posn* position )
   {
-    long double H = 0.0, ra = 0.0, latitude = 0.0, 
-                declination = 0.0, A = 0.0, Ac = 0.0, 
-                As = 0.0, h = 0.0, Z = 0.0, Zs = 0.0;
+    sidereus::observer site( observer, 0, 
+                            sidereus::observer::no_parallax() );
 
-    // Change sidereal time from hours to radians.
-    sidereal *= 2.0 * M_PI / 24.0;
+    site.get_hrz_from_equ_sidereal_time( object, sidereal, position );
+  }
 
-    // Calculate hour angle of object at observers position.
-    ra =  GEN_GEOMETRY_DEGTORAD( object->ra );
-    H = sidereal + GEN_GEOMETRY_DEGTORAD( observer->lon ) - ra;
+  void transform_coord::get_hrz_from_equ( const double* ra, 
+   const double* dec, size_t count,
+   genesis::proto_geo::point_lon_lat_posn* observer, double JD,
+   double* alt, double* az )
+  {
+    double sidereal = 0.;
 
-    // Convert to radians - hour angle, observers latitude, 
-    // object declination.
-    latitude = GEN_GEOMETRY_DEGTORAD( observer->lat );
-    declination = GEN_GEOMETRY_DEGTORAD( object->dec );
+    // Get mean sidereal time in hours, once for every object.
+    sidereal = sidereus::sidereal_time::get_mean( JD );
+    get_hrz_from_equ_sidereal_time( ra, dec, count, observer, sidereal, 
+                                    alt, az );
+  }
 
-    // Missuse of A (you have been warned).
-    A = std::sin( latitude ) * std::sin( declination ) + 
-        std::cos( latitude ) * std::cos( declination ) * std::cos( H );
-    h = std::asin( A );
+  void transform_coord::get_hrz_from_equ( const double* ra, 
+   const double* dec, size_t count,
+   genesis::proto_geo::point_lon_lat_posn* observer, const epoch* frame,
+   double* alt, double* az )
+  {
+    get_hrz_from_equ_sidereal_time( ra, dec, count, observer, 
+                                    frame->get_mean_sidereal(), alt, az );
+  }
 
-    // Convert back to degrees.
-    position->alt = GEN_GEOMETRY_RADTODEG( h );
+  void transform_coord::get_hrz_from_equ_sidereal_time( const double* ra,
+   const double* dec, size_t count,
+   genesis::proto_geo::point_lon_lat_posn* observer, double sidereal,
+   double* alt, double* az )
+  {
+    sidereus::observer site( observer, 0, 
+                            sidereus::observer::no_parallax() );
 
-    // Zenith distance, Telescope Control 6.8a.
-    Z = std::acos( A );
+    site.get_hrz_from_equ_sidereal_time( ra, dec, count, sidereal, alt, az );
+  }
 
-    // Is'n there better way to compute that?.
-    Zs = std::sin( Z );
+  void transform_coord::get_hrz_track( 
+   genesis::proto_geo::point_equ_posn* object, 
+   genesis::proto_geo::point_lon_lat_posn* observer, double JD, 
+   double step, size_t count, double* alt, double* az )
+  {
+    sidereus::observer site( observer, 0, 
+                            sidereus::observer::no_parallax() );
 
-    // Sane check for zenith distance. Don't try to divide by 0.
-    if( std::fabs( Zs ) < 1e-5 ) {
-      if( object->dec > 0 ) {
-        position->az = 180;
-      } else {
-        position->az = 0;
-      }
+    site.get_hrz_track( object, JD, step, count, alt, az );
+  }
 
-      if(( object->dec > 0 && observer->lat > 0 ) || 
-           ( object->dec < 0 && observer->lat < 0 )) {
-        position->alt = 90;
-      } else {
-        position->alt = -90;
-      }
+  void transform_coord::get_equ_from_hrz( 
+   genesis::proto_geo::point_hrz_posn* object,
+   genesis::proto_geo::point_lon_lat_posn* observer,
+   double JD,
+   genesis::proto_geo::point_equ_posn* position )
+  {
+    get_equ_from_hrz( object, observer, JD, &nutation_cache::local(), 
+                      position );
+  }
 
-      return;
-    }
+  void transform_coord::get_equ_from_hrz( 
+   genesis::proto_geo::point_hrz_posn* object,
+   genesis::proto_geo::point_lon_lat_posn* observer,
+   julian_date JD,
+   genesis::proto_geo::point_equ_posn* position )
+  {
+    sidereus::observer site( observer, 0, 
+                            sidereus::observer::no_parallax() );
 
-    // Formulas TC 6.8d Taff 1991, pp. 2 and 13 - vector transformations.
-    As = ( std::cos( declination ) * std::sin( H ) ) / Zs;
-    Ac = ( std::sin( latitude ) * std::cos( declination ) * 
-         std::cos( H ) - std::cos( latitude ) * std::sin( declination ) ) / Zs;
-
-    // Don't blom at atan2.
-    if( Ac == 0 && As == 0 ) {
-      if( object->dec > 0 ) {
-        position->az = 180.0;
-      } else {
-        position->az = 0.0;
-      }
-      return;
-    }
+    site.get_equ_from_hrz_sidereal_time( object, 
+     sidereus::sidereal_time::get_apparent( JD, &nutation_cache::local() ),
+     position );
+  }
 
-    A = std::atan2( As, Ac );
+  void transform_coord::get_equ_from_hrz( 
+   genesis::proto_geo::point_hrz_posn* object,
+   genesis::proto_geo::point_lon_lat_posn* observer,
+   double JD,
+   nutation_cache* cache,
+   genesis::proto_geo::point_equ_posn* position )
+  {
+    sidereus::observer site( observer, 0, 
+                            sidereus::observer::no_parallax() );
 
-    // Convert back to degrees.
-    position->az = genesis::geometry::range_degrees( GEN_GEOMETRY_RADTODEG( A ) );
+    site.get_equ_from_hrz_sidereal_time( object, 
+     sidereus::sidereal_time::get_apparent( JD, cache ), position );
   }
 
   void transform_coord::get_equ_from_hrz( 
    genesis::proto_geo::point_hrz_posn* object,
    genesis::proto_geo::point_lon_lat_posn* observer,
-   double JD,
+   const epoch* frame,
    genesis::proto_geo::point_equ_posn* position )
   {
-    long double H = 0.0, longitude = 0.0, declination = 0.0,
-                latitude = 0.0, A = 0.0, h = 0.0, sidereal = 0.0;
+    sidereus::observer site( observer, 0, 
+                            sidereus::observer::no_parallax() );
 
-    // Change observer/object position into radians.
-    // object alt/az:
-    A = GEN_GEOMETRY_DEGTORAD( object->az );
-    h = GEN_GEOMETRY_DEGTORAD( object->alt );
+    site.get_equ_from_hrz_sidereal_time( object, 
+     frame->get_apparent_sidereal(), position );
+  }
 
-    // Observer long / lat:
-    longitude = GEN_GEOMETRY_DEGTORAD( observer->lon );
-    latitude = GEN_GEOMETRY_DEGTORAD( observer->lat );
+  void transform_coord::get_equ_from_hrz( const double* alt, 
+   const double* az, size_t count,
+   genesis::proto_geo::point_lon_lat_posn* observer, double JD,
+   double* ra, double* dec )
+  {
+    get_equ_from_hrz( alt, az, count, observer, JD, 
+                      &nutation_cache::local(), ra, dec );
+  }
 
-    // Equ on pg89!
-    H = std::atan2( std::sin( A ), ( std::cos( A ) * 
-        std::sin( latitude ) + std::tan( h ) * std::cos( latitude ) ));
-    declination = std::sin( latitude ) * std::sin( h ) - 
-                  std::cos( latitude ) * std::cos( h ) * std::cos( A );
-    declination = std::asin( declination );
+  void transform_coord::get_equ_from_hrz( const double* alt, 
+   const double* az, size_t count,
+   genesis::proto_geo::point_lon_lat_posn* observer, double JD,
+   nutation_cache* cache, double* ra, double* dec )
+  {
+    sidereus::observer site( observer, 0, 
+                            sidereus::observer::no_parallax() );
 
-    // Get ra = sidereal - longitude + H and change sidereal to radians.
-    sidereal = sidereus::sidereal_time::get_apparent( JD );
-    sidereal *= 2.0 * M_PI / 24.0;
+    site.get_equ_from_hrz_sidereal_time( alt, az, count, 
+     sidereus::sidereal_time::get_apparent( JD, cache ), ra, dec );
+  }
 
-    // Store in position.
-    position->ra = genesis::geometry::range_degrees( 
-                    GEN_GEOMETRY_RADTODEG( sidereal - H + longitude ) );
+  void transform_coord::get_equ_from_hrz( const double* alt, 
+   const double* az, size_t count,
+   genesis::proto_geo::point_lon_lat_posn* observer, const epoch* frame,
+   double* ra, double* dec )
+  {
+    sidereus::observer site( observer, 0, 
+                            sidereus::observer::no_parallax() );
 
-    position->dec = GEN_GEOMETRY_RADTODEG( declination );
+    site.get_equ_from_hrz_sidereal_time( alt, az, count, 
+     frame->get_apparent_sidereal(), ra, dec );
   }
 
   void transform_coord::get_equ_from_ecl( 
@@ -148,66 +265,85 @@ namespace sidereus {
    double JD,
    genesis::proto_geo::point_equ_posn* position )
   {
-    double ra = 0.0, declination = 0.0, 
-           longitude = 0.0, latitude = 0.0;
+    get_equ_from_ecl( object, JD, &nutation_cache::local(), position );
+  }
+
+  void transform_coord::get_equ_from_ecl( 
+   genesis::proto_geo::point_lon_lat_posn* object,
+   double JD,
+   nutation_cache* cache,
+   genesis::proto_geo::point_equ_posn* position )
+  {
+    double ecliptic = 0.0;
 
     sidereus::nutation::nut nutation;
 
     // Get obliquity of ecliptic and change it to rads.
-    sidereus::nutation( JD, &nutation );
-    nutation.ecliptic = GEN_GEOMETRY_DEGTORAD( nutation.ecliptic );
+    sidereus::nutation( JD, &nutation, cache );
+    ecliptic = GEN_GEOMETRY_DEGTORAD( nutation.ecliptic );
 
-    // Change object's position into radians.
-    // objects:
-    longitude = GEN_GEOMETRY_DEGTORAD( object->lon );
-    latitude = GEN_GEOMETRY_DEGTORAD( object->lat );
+    equ_from_ecl( object, std::sin( ecliptic ), std::cos( ecliptic ), 
+                  position );
+  }
 
-    // Equ 12.3, 12.4.
-    ra = std::atan2(( std::sin( longitude ) * std::cos( nutation.ecliptic ) -
-         std::tan( latitude ) * std::sin( nutation.ecliptic )), 
-         std::cos ( longitude ) );
-    declination = std::sin( latitude ) * std::cos( nutation.ecliptic ) + 
-                  std::cos( latitude ) * std::sin( nutation.ecliptic ) * 
-                  std::sin( longitude );
-    declination = std::asin( declination );
+  void transform_coord::get_equ_from_ecl( 
+   genesis::proto_geo::point_lon_lat_posn* object,
+   const epoch* frame,
+   genesis::proto_geo::point_equ_posn* position )
+  {
+    equ_from_ecl( object, frame->get_sin_ecliptic(), 
+                  frame->get_cos_ecliptic(), position );
+  }
 
-    // Store in position.
-    position->ra = genesis::geometry::range_degrees(
-                    GEN_GEOMETRY_RADTODEG( ra ) );
+  void transform_coord::get_equ_from_ecl( const double* lon, 
+   const double* lat, size_t count, const epoch* frame, 
+   double* ra, double* dec )
+  {
+    // Frame rotation around the equinox by minus the true obliquity.
+    rotation::rotate_x( -frame->get_nutation().ecliptic ).apply( 
+     lon, lat, count, ra, dec );
+  }
 
-    position->dec = GEN_GEOMETRY_RADTODEG( declination );
+  void transform_coord::get_ecl_from_equ( 
+    genesis::proto_geo::point_equ_posn* object,
+    double JD,
+    genesis::proto_geo::point_lon_lat_posn* position )
+  {
+    get_ecl_from_equ( object, JD, &nutation_cache::local(), position );
   }
 
   void transform_coord::get_ecl_from_equ( 
     genesis::proto_geo::point_equ_posn* object,
     double JD,
+    nutation_cache* cache,
     genesis::proto_geo::point_lon_lat_posn* position )
   {
-    double ra = 0.0, declination = 0.0,
-           longitude = 0.0, latitude = 0.0;
+    double ecliptic = 0.0;
 
     sidereus::nutation::nut nutation;
 
-    // Object position:
-    ra = GEN_GEOMETRY_DEGTORAD( object->ra );
-    declination = GEN_GEOMETRY_DEGTORAD( object->dec );
+    sidereus::nutation( JD, &nutation, cache );
+    ecliptic = GEN_GEOMETRY_DEGTORAD( nutation.ecliptic );
 
-    sidereus::nutation( JD, &nutation );
-    nutation.ecliptic = GEN_GEOMETRY_DEGTORAD( nutation.ecliptic );
+    ecl_from_equ( object, std::sin( ecliptic ), std::cos( ecliptic ), 
+                  position );
+  }
 
-    // Equ 12.1, 12.2.
-    longitude = std::atan2(( std::sin( ra ) * std::cos( nutation.ecliptic ) + 
-                std::tan( declination ) * std::sin( nutation.ecliptic )), 
-                std::cos( ra ));
-    latitude = std::sin( declination ) * std::cos( nutation.ecliptic ) - 
-               std::cos( declination ) * std::sin( nutation.ecliptic ) * 
-               std::sin( ra );
-    latitude = std::asin( latitude );
+  void transform_coord::get_ecl_from_equ( 
+    genesis::proto_geo::point_equ_posn* object,
+    const epoch* frame,
+    genesis::proto_geo::point_lon_lat_posn* position )
+  {
+    ecl_from_equ( object, frame->get_sin_ecliptic(), 
+                  frame->get_cos_ecliptic(), position );
+  }
 
-    // Store in position.
-    position->lat = GEN_GEOMETRY_RADTODEG( latitude );
-    position->lon = genesis::geometry::range_degrees( 
-                     GEN_GEOMETRY_RADTODEG( longitude ) );
+  void transform_coord::get_ecl_from_equ( const double* ra, 
+   const double* dec, size_t count, const epoch* frame, 
+   double* lon, double* lat )
+  {
+    rotation::rotate_x( frame->get_nutation().ecliptic ).apply( 
+     ra, dec, count, lon, lat );
   }
  
   void transform_coord::get_ecl_from_rect( 
@@ -218,6 +354,11 @@ namespace sidereus {
 
     position->lon = genesis::geometry::range_degrees( 
                      GEN_GEOMETRY_RADTODEG( std::atan2( rect->x, rect->y ) ));
+
+    if( position->lon >= 360.0 ) {
+      position->lon = 0.0;
+    }
+
     position->lat = GEN_GEOMETRY_RADTODEG( std::atan2( t, rect->z ));
   }
 
@@ -225,83 +366,70 @@ namespace sidereus {
    genesis::proto_geo::point_gal_posn* gal,
    genesis::proto_geo::point_equ_posn* equ )
   {
-    double RAD_27_4 = 0.0, SIN_27_4 = 0.0, COS_27_4 = 0.0;
-
-    double l_123 = 0.0, cos_l_123 = 0.0;
-    double sin_b = 0.0, cos_b = 0.0, rad_gal_b = 0.0;
-    double y = 0.0;
-
-    RAD_27_4 = GEN_GEOMETRY_DEGTORAD( 27.4 );
-    SIN_27_4 = std::sin( RAD_27_4 );
-    COS_27_4 = std::cos( RAD_27_4 );
+    genesis::proto_geo::point_rect_coord v;
 
-    l_123 = GEN_GEOMETRY_DEGTORAD( gal->lon - 123 );
-    cos_l_123 = std::cos( l_123 );
-
-    rad_gal_b = GEN_GEOMETRY_DEGTORAD( gal->lat );
-
-    sin_b = std::sin( rad_gal_b );
-    cos_b = std::cos( rad_gal_b );
-
-    y = std::atan2( std::sin( l_123 ), cos_l_123 *
-                    SIN_27_4 - ( sin_b / cos_b ) * COS_27_4 );
-
-    equ->ra = genesis::geometry::range_degrees( 
-               GEN_GEOMETRY_RADTODEG( y ) + 12.25 );
+    rotation::get_rect( gal->lon, gal->lat, &v );
+    frames::get_gal_from_b1950().transpose().apply( &v, &v );
+    rotation::get_spherical( &v, &equ->ra, &equ->dec );
+  }
 
-    equ->dec = GEN_GEOMETRY_RADTODEG( 
-                std::asin( sin_b * SIN_27_4 + cos_b * COS_27_4 * cos_l_123 ) );
+  void transform_coord::get_equ_from_gal( const double* lon, 
+   const double* lat, size_t count, double* ra, double* dec )
+  {
+    frames::get_gal_from_b1950().transpose().apply( lon, lat, count,
+                                                ra, dec );
   }
 
   void transform_coord::get_equ2000_from_gal( 
    genesis::proto_geo::point_gal_posn* gal,
    genesis::proto_geo::point_equ_posn* equ )
   {
-    get_equ_from_gal( gal, equ );
-    sidereus::precession::get_equ_prec2( equ, JULIAN_DAY_B1950, 
-                                         JULIAN_DAY_JD2000, equ );
+    genesis::proto_geo::point_rect_coord v;
+
+    rotation::get_rect( gal->lon, gal->lat, &v );
+    frames::get_gal_from_equ2000().transpose().apply( &v, &v );
+    rotation::get_spherical( &v, &equ->ra, &equ->dec );
+  }
+
+  void transform_coord::get_equ2000_from_gal( const double* lon, 
+   const double* lat, size_t count, double* ra, double* dec )
+  {
+    frames::get_gal_from_equ2000().transpose().apply( lon, lat, count,
+                                                ra, dec );
   }
 
   void transform_coord::get_gal_from_equ( 
    genesis::proto_geo::point_equ_posn *equ,
    genesis::proto_geo::point_gal_posn* gal )
   {
-    double RAD_27_4 = 0.0, SIN_27_4 = 0.0, COS_27_4 = 0.0;
-
-    double ra_192_25 = 0.0, cos_ra_192_25 = 0.0;
-    double rad_equ_dec = 0.0;
-    double cos_dec = 0.0, sin_dec = 0.0;
-    double x = 0.0;
+    genesis::proto_geo::point_rect_coord v;
 
-    RAD_27_4 = GEN_GEOMETRY_DEGTORAD( 27.4 );
-    SIN_27_4 = std::sin( RAD_27_4 );
-    COS_27_4 = std::cos( RAD_27_4 );
-
-    ra_192_25 = GEN_GEOMETRY_DEGTORAD( 192.25 - equ->ra );
-    cos_ra_192_25 = std::cos( ra_192_25 );
-
-    rad_equ_dec = GEN_GEOMETRY_DEGTORAD( equ->dec );
-
-    sin_dec = std::sin( rad_equ_dec );
-    cos_dec = std::cos( rad_equ_dec );
-
-    x = std::atan2( std::sin( ra_192_25 ), cos_ra_192_25 * SIN_27_4 - 
-                    ( sin_dec / cos_dec ) * COS_27_4 );
+    rotation::get_rect( equ->ra, equ->dec, &v );
+    frames::get_gal_from_b1950().apply( &v, &v );
+    rotation::get_spherical( &v, &gal->lon, &gal->lat );
+  }
 
-    gal->lon = genesis::geometry::range_degrees( 303 - 
-                                                  GEN_GEOMETRY_RADTODEG( x ) );
-    gal->lat = GEN_GEOMETRY_RADTODEG( 
-                std::asin( sin_dec * SIN_27_4 + cos_dec * COS_27_4 * cos_ra_192_25 ) );
+  void transform_coord::get_gal_from_equ( const double* ra, 
+   const double* dec, size_t count, double* lon, double* lat )
+  {
+    frames::get_gal_from_b1950().apply( ra, dec, count, lon, lat );
   }
 
   void transform_coord::get_gal_from_equ2000( 
    genesis::proto_geo::point_equ_posn* equ,
    genesis::proto_geo::point_gal_posn* gal )
   {
-    genesis::proto_geo::point_equ_posn equ_1950;
-    sidereus::precession::get_equ_prec2( equ, JULIAN_DAY_JD2000, 
-                                         JULIAN_DAY_B1950, &equ_1950 );
-    get_gal_from_equ( &equ_1950, gal );
+    genesis::proto_geo::point_rect_coord v;
+
+    rotation::get_rect( equ->ra, equ->dec, &v );
+    frames::get_gal_from_equ2000().apply( &v, &v );
+    rotation::get_spherical( &v, &gal->lon, &gal->lat );
   }
-  
+
+  void transform_coord::get_gal_from_equ2000( const double* ra, 
+   const double* dec, size_t count, double* lon, double* lat )
+  {
+    frames::get_gal_from_equ2000().apply( ra, dec, count, lon, lat );
+  }
+
 }
@@ -15,11 +15,21 @@
 #ifndef SIDEREUS_TRANSFORM_COORD_HPP
 #define SIDEREUS_TRANSFORM_COORD_HPP
 
+#include <sidereus/epoch.hxx>
+#include <sidereus/nutation.hxx>
+
 #include <genesis/geometry.hxx>
 
+#include <cstddef>
+
 namespace sidereus {
   /**
    * Sidereus
+   *
+   * Galactic transforms are a single constant rotation each; the J2000
+   * ones have the B1950 to J2000 precession fused into the matrix.
+   * Horizontal transforms rebuild the observer terms on each call; 
+   * for repeated calls from the same site use sidereus::observer.
    */
   class transform_coord {
   public:
@@ -49,6 +59,33 @@ namespace sidereus {
                            double JD,
                            genesis::proto_geo::point_hrz_posn* position );
 
+    /**
+     * Same as above for a two part Julian date.
+     *
+     * @param object - Object coordinates.
+     * @param observer - Observer coordinates.
+     * @param JD - Julian date.
+     * @param position - Pointer to store new positions.
+     */
+    void get_hrz_from_equ( genesis::proto_geo::point_equ_posn* object, 
+                           genesis::proto_geo::point_lon_lat_posn* observer,
+                           julian_date JD,
+                           genesis::proto_geo::point_hrz_posn* position );
+
+    /**
+     * Transform an objects equatorial coordinates into horizontal 
+     * coordinates at the instant of an epoch frame.
+     *
+     * @param object - Object coordinates.
+     * @param observer - Observer coordinates.
+     * @param frame - Epoch.
+     * @param position - Pointer to store new positions.
+     */
+    void get_hrz_from_equ( genesis::proto_geo::point_equ_posn* object, 
+                           genesis::proto_geo::point_lon_lat_posn* observer,
+                           const epoch* frame,
+                           genesis::proto_geo::point_hrz_posn* position );
+
     /**
      * Calculate horizontal coordinates from equatorial coordinates,
      * using mean sidereal time.
@@ -64,6 +101,78 @@ namespace sidereus {
       double sidereal,
       genesis::proto_geo::point_hrz_posn* position );
 
+    /**
+     * Transform arrays of equatorial coordinates into horizontal 
+     * coordinates for the given julian day and observers position.
+     *
+     * Coordinates are passed as separate contiguous arrays of degrees
+     * (structure of arrays); the observer and sidereal time terms are
+     * computed once for the whole batch.
+     *
+     * @param ra - Right ascensions (deg).
+     * @param dec - Declinations (deg).
+     * @param count - Number of objects.
+     * @param observer - Observer coordinates.
+     * @param JD - Julian Day.
+     * @param alt - Array to store altitudes (deg).
+     * @param az - Array to store azimuths (deg).
+     */
+    void get_hrz_from_equ( const double* ra, const double* dec, 
+                           size_t count,
+                           genesis::proto_geo::point_lon_lat_posn* observer,
+                           double JD, double* alt, double* az );
+
+    /**
+     * Transform arrays of equatorial coordinates into horizontal 
+     * coordinates at the instant of an epoch frame.
+     *
+     * @param ra - Right ascensions (deg).
+     * @param dec - Declinations (deg).
+     * @param count - Number of objects.
+     * @param observer - Observer coordinates.
+     * @param frame - Epoch.
+     * @param alt - Array to store altitudes (deg).
+     * @param az - Array to store azimuths (deg).
+     */
+    void get_hrz_from_equ( const double* ra, const double* dec, 
+                           size_t count,
+                           genesis::proto_geo::point_lon_lat_posn* observer,
+                           const epoch* frame, double* alt, double* az );
+
+    /**
+     * Transform arrays of equatorial coordinates into horizontal 
+     * coordinates, using mean sidereal time.
+     *
+     * @param ra - Right ascensions (deg).
+     * @param dec - Declinations (deg).
+     * @param count - Number of objects.
+     * @param observer - Observer coordinates.
+     * @param sidereal - Sidereal Time.
+     * @param alt - Array to store altitudes (deg).
+     * @param az - Array to store azimuths (deg).
+     */
+    void get_hrz_from_equ_sidereal_time( 
+      const double* ra, const double* dec, size_t count,
+      genesis::proto_geo::point_lon_lat_posn* observer, 
+      double sidereal, double* alt, double* az );
+
+    /**
+     * Track an object in horizontal coordinates over evenly spaced 
+     * Julian days, see observer::get_hrz_track().
+     *
+     * @param object - Object coordinates.
+     * @param observer - Observer coordinates.
+     * @param JD - Julian Day of the first position.
+     * @param step - Days between positions.
+     * @param count - Number of positions.
+     * @param alt - Array to store altitudes (deg).
+     * @param az - Array to store azimuths (deg).
+     */
+    void get_hrz_track( genesis::proto_geo::point_equ_posn* object, 
+                        genesis::proto_geo::point_lon_lat_posn* observer,
+                        double JD, double step, size_t count, 
+                        double* alt, double* az );
+
     /**
      * Transform an objects horizontal coordinates into equatorial 
      * coordinates for the given Julian Day and observers position.
@@ -78,6 +187,104 @@ namespace sidereus {
                            double JD,
                            genesis::proto_geo::point_equ_posn* position );
 
+    /**
+     * Same as above for a two part Julian date.
+     *
+     * @param object - Object coordinates.
+     * @param observer - Observer coordinates.
+     * @param JD - Julian date.
+     * @param position - Pointer to store new position.
+     */
+    void get_equ_from_hrz( genesis::proto_geo::point_hrz_posn* object, 
+                           genesis::proto_geo::point_lon_lat_posn* observer, 
+                           julian_date JD,
+                           genesis::proto_geo::point_equ_posn* position );
+
+    /**
+     * Transform an objects horizontal coordinates into equatorial 
+     * coordinates for the given Julian Day and observers position,
+     * taking nutation from a caller owned cache.
+     *
+     * @param object - Object coordinates.
+     * @param observer - Observer coordinates.
+     * @param JD - Julian Day.
+     * @param cache - Nutation cache.
+     * @param position - Pointer to store new position.
+     */
+    void get_equ_from_hrz( genesis::proto_geo::point_hrz_posn* object, 
+                           genesis::proto_geo::point_lon_lat_posn* observer, 
+                           double JD,
+                           nutation_cache* cache,
+                           genesis::proto_geo::point_equ_posn* position );
+
+    /**
+     * Transform an objects horizontal coordinates into equatorial 
+     * coordinates at the instant of an epoch frame.
+     *
+     * @param object - Object coordinates.
+     * @param observer - Observer coordinates.
+     * @param frame - Epoch.
+     * @param position - Pointer to store new position.
+     */
+    void get_equ_from_hrz( genesis::proto_geo::point_hrz_posn* object, 
+                           genesis::proto_geo::point_lon_lat_posn* observer, 
+                           const epoch* frame,
+                           genesis::proto_geo::point_equ_posn* position );
+
+    /**
+     * Transform arrays of horizontal coordinates into equatorial 
+     * coordinates for the given Julian Day and observers position.
+     *
+     * @param alt - Altitudes (deg).
+     * @param az - Azimuths (deg).
+     * @param count - Number of objects.
+     * @param observer - Observer coordinates.
+     * @param JD - Julian Day.
+     * @param ra - Array to store right ascensions (deg).
+     * @param dec - Array to store declinations (deg).
+     */
+    void get_equ_from_hrz( const double* alt, const double* az, 
+                           size_t count,
+                           genesis::proto_geo::point_lon_lat_posn* observer, 
+                           double JD, double* ra, double* dec );
+
+    /**
+     * Transform arrays of horizontal coordinates into equatorial 
+     * coordinates for the given Julian Day and observers position,
+     * taking nutation from a caller owned cache.
+     *
+     * @param alt - Altitudes (deg).
+     * @param az - Azimuths (deg).
+     * @param count - Number of objects.
+     * @param observer - Observer coordinates.
+     * @param JD - Julian Day.
+     * @param cache - Nutation cache.
+     * @param ra - Array to store right ascensions (deg).
+     * @param dec - Array to store declinations (deg).
+     */
+    void get_equ_from_hrz( const double* alt, const double* az, 
+                           size_t count,
+                           genesis::proto_geo::point_lon_lat_posn* observer, 
+                           double JD, nutation_cache* cache,
+                           double* ra, double* dec );
+
+    /**
+     * Transform arrays of horizontal coordinates into equatorial 
+     * coordinates at the instant of an epoch frame.
+     *
+     * @param alt - Altitudes (deg).
+     * @param az - Azimuths (deg).
+     * @param count - Number of objects.
+     * @param observer - Observer coordinates.
+     * @param frame - Epoch.
+     * @param ra - Array to store right ascensions (deg).
+     * @param dec - Array to store declinations (deg).
+     */
+    void get_equ_from_hrz( const double* alt, const double* az, 
+                           size_t count,
+                           genesis::proto_geo::point_lon_lat_posn* observer, 
+                           const epoch* frame, double* ra, double* dec );
+
     /**
      * Transform an objects ecliptical coordinates into equatorial
      * coordinates for the given Julian Day.
@@ -90,6 +297,48 @@ namespace sidereus {
                            double JD, 
                            genesis::proto_geo::point_equ_posn* position );
 
+    /**
+     * Transform an objects ecliptical coordinates into equatorial
+     * coordinates for the given Julian Day, taking nutation from a 
+     * caller owned cache.
+     *
+     * @param object - Object coordinates.
+     * @param JD - Julian Day.
+     * @param cache - Nutation cache.
+     * @param position - Pointer to store new position.
+     */
+    void get_equ_from_ecl( genesis::proto_geo::point_lon_lat_posn* object, 
+                           double JD, 
+                           nutation_cache* cache,
+                           genesis::proto_geo::point_equ_posn* position );
+
+    /**
+     * Transform an objects ecliptical coordinates into equatorial
+     * coordinates at the instant of an epoch frame.
+     *
+     * @param object - Object coordinates.
+     * @param frame - Epoch.
+     * @param position - Pointer to store new position.
+     */
+    void get_equ_from_ecl( genesis::proto_geo::point_lon_lat_posn* object, 
+                           const epoch* frame,
+                           genesis::proto_geo::point_equ_posn* position );
+
+    /**
+     * Transform arrays of ecliptical coordinates into equatorial
+     * coordinates at the instant of an epoch frame.
+     *
+     * @param lon - Ecliptical longitudes (deg).
+     * @param lat - Ecliptical latitudes (deg).
+     * @param count - Number of objects.
+     * @param frame - Epoch.
+     * @param ra - Array to store right ascensions (deg).
+     * @param dec - Array to store declinations (deg).
+     */
+    void get_equ_from_ecl( const double* lon, const double* lat, 
+                           size_t count, const epoch* frame, 
+                           double* ra, double* dec );
+
     /**
      * Transform an objects equatorial cordinates into ecliptical 
      * coordinates for the given Julian Day.
@@ -102,6 +351,48 @@ namespace sidereus {
                            double JD,
                            genesis::proto_geo::point_lon_lat_posn* position );
 
+    /**
+     * Transform an objects equatorial cordinates into ecliptical 
+     * coordinates for the given Julian Day, taking nutation from a 
+     * caller owned cache.
+     *
+     * @param object - Object coordinates.
+     * @param JD - Julian Day.
+     * @param cache - Nutation cache.
+     * @param position - Pointer to store new position.
+     */
+    void get_ecl_from_equ( genesis::proto_geo::point_equ_posn* object,
+                           double JD,
+                           nutation_cache* cache,
+                           genesis::proto_geo::point_lon_lat_posn* position );
+
+    /**
+     * Transform an objects equatorial cordinates into ecliptical 
+     * coordinates at the instant of an epoch frame.
+     *
+     * @param object - Object coordinates.
+     * @param frame - Epoch.
+     * @param position - Pointer to store new position.
+     */
+    void get_ecl_from_equ( genesis::proto_geo::point_equ_posn* object,
+                           const epoch* frame,
+                           genesis::proto_geo::point_lon_lat_posn* position );
+
+    /**
+     * Transform arrays of equatorial coordinates into ecliptical
+     * coordinates at the instant of an epoch frame.
+     *
+     * @param ra - Right ascensions (deg).
+     * @param dec - Declinations (deg).
+     * @param count - Number of objects.
+     * @param frame - Epoch.
+     * @param lon - Array to store ecliptical longitudes (deg).
+     * @param lat - Array to store ecliptical latitudes (deg).
+     */
+    void get_ecl_from_equ( const double* ra, const double* dec, 
+                           size_t count, const epoch* frame, 
+                           double* lon, double* lat );
+
     /**
      * Transform an objects rectangular coordinates into ecliptical 
      * coordinates.
@@ -122,6 +413,19 @@ namespace sidereus {
     void get_equ_from_gal( genesis::proto_geo::point_gal_posn* gal, 
                            genesis::proto_geo::point_equ_posn* equ );
 
+    /**
+     * Transform arrays of galactic coordinates into B1950 equatorial 
+     * coordinates.
+     *
+     * @param lon - Galactic longitudes (deg).
+     * @param lat - Galactic latitudes (deg).
+     * @param count - Number of objects.
+     * @param ra - Array to store B1950 right ascensions (deg).
+     * @param dec - Array to store B1950 declinations (deg).
+     */
+    void get_equ_from_gal( const double* lon, const double* lat, 
+                           size_t count, double* ra, double* dec );
+
     /**
      * Transform an object galactic coordinates into equatorial
      * coordinate.
@@ -132,6 +436,19 @@ namespace sidereus {
     void get_equ2000_from_gal( genesis::proto_geo::point_gal_posn* gal, 
                                genesis::proto_geo::point_equ_posn* equ );
 
+    /**
+     * Transform arrays of galactic coordinates into J2000 equatorial 
+     * coordinates.
+     *
+     * @param lon - Galactic longitudes (deg).
+     * @param lat - Galactic latitudes (deg).
+     * @param count - Number of objects.
+     * @param ra - Array to store J2000 right ascensions (deg).
+     * @param dec - Array to store J2000 declinations (deg).
+     */
+    void get_equ2000_from_gal( const double* lon, const double* lat, 
+                               size_t count, double* ra, double* dec );
+
     /**
      * Transform an object B1950 equatorial coordinate into 
      * galactic coordinates.
@@ -142,6 +459,19 @@ namespace sidereus {
     void get_gal_from_equ( genesis::proto_geo::point_equ_posn *equ, 
                            genesis::proto_geo::point_gal_posn* gal );
 
+    /**
+     * Transform arrays of B1950 equatorial coordinates into 
+     * galactic coordinates.
+     *
+     * @param ra - B1950 right ascensions (deg).
+     * @param dec - B1950 declinations (deg).
+     * @param count - Number of objects.
+     * @param lon - Array to store galactic longitudes (deg).
+     * @param lat - Array to store galactic latitudes (deg).
+     */
+    void get_gal_from_equ( const double* ra, const double* dec, 
+                           size_t count, double* lon, double* lat );
+
     /**
      * Transform an object J2000 equatorial coordinate into 
      * galactic coordinates.
@@ -152,6 +482,19 @@ namespace sidereus {
     void get_gal_from_equ2000( genesis::proto_geo::point_equ_posn* equ, 
                                genesis::proto_geo::point_gal_posn* gal );
 
+    /**
+     * Transform arrays of J2000 equatorial coordinates into galactic 
+     * coordinates.
+     *
+     * @param ra - J2000 right ascensions (deg).
+     * @param dec - J2000 declinations (deg).
+     * @param count - Number of objects.
+     * @param lon - Array to store galactic longitudes (deg).
+     * @param lat - Array to store galactic latitudes (deg).
+     */
+    void get_gal_from_equ2000( const double* ra, const double* dec, 
+                               size_t count, double* lon, double* lat );
+
   };
 
 }
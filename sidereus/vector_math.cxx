@@ -0,0 +1,322 @@
+/**
+ * @file
+ *
+ * Implementation for an vector_math.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/vector_math.hxx>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined( __GNUC__ ) && defined( __x86_64__ )
+#define VECTOR_MATH_DISPATCH 1
+#define VECTOR_MATH_INLINE inline __attribute__(( always_inline ))
+#else
+#define VECTOR_MATH_INLINE inline
+#endif
+
+namespace sidereus {
+
+/**
+ * This namespace works as if anything inside it were declared
+ * staticaly in each source file.
+ */
+namespace {
+
+  // Round to nearest for |x| < 2^51, no libm call.
+  const double ROUND_MAGIC = 6755399441055744.0;
+
+  // 2 / pi and pi / 2 in three parts of 33 bits (fdlibm rem_pio2).
+  const double TWO_OVER_PI = 6.36619772367581382433e-01;
+  const double PIO2_1 = 1.57079632673412561417e+00;
+  const double PIO2_2 = 6.07710050630396597660e-11;
+  const double PIO2_3 = 2.02226624871116645580e-21;
+
+  // pi / 2, pi / 4 and pi split in high and low parts.
+  const double PIO2_HI = 1.57079632679489655800e+00;
+  const double PIO2_LO = 6.12323399573676603587e-17;
+  const double PIO4_HI = 7.85398163397448278999e-01;
+  const double PIO4_LO = 3.06161699786838301793e-17;
+  const double PI_HI = 3.14159265358979311600e+00;
+  const double PI_LO = 1.22464679914735320717e-16;
+
+  // Sine and cosine on [-pi/4, pi/4] (fdlibm k_sin, k_cos).
+  const double S1 = -1.66666666666666324348e-01;
+  const double S2 = 8.33333333332248946124e-03;
+  const double S3 = -1.98412698298579493134e-04;
+  const double S4 = 2.75573137070700676789e-06;
+  const double S5 = -2.50507602534068634195e-08;
+  const double S6 = 1.58969099521155010221e-10;
+
+  const double C1 = 4.16666666666666019037e-02;
+  const double C2 = -1.38888888888741095749e-03;
+  const double C3 = 2.48015872894767294178e-05;
+  const double C4 = -2.75573143513906633035e-07;
+  const double C5 = 2.08757232129817482790e-09;
+  const double C6 = -1.13596475577881948265e-11;
+
+  // Arc tangent on [-0.66, 0.66] (Cephes atan).
+  const double AP0 = -8.750608600031904122785e-01;
+  const double AP1 = -1.615753718733365076637e+01;
+  const double AP2 = -7.500855792314704667340e+01;
+  const double AP3 = -1.228866684490136173410e+02;
+  const double AP4 = -6.485021904942025371773e+01;
+  const double AQ0 = 2.485846490142306297962e+01;
+  const double AQ1 = 1.650270098316988542046e+02;
+  const double AQ2 = 4.328810604912902668951e+02;
+  const double AQ3 = 4.853903996359136964868e+02;
+  const double AQ4 = 1.945506571482613964425e+02;
+
+  // Arc sine on [0, 0.5] (fdlibm e_asin).
+  const double PS0 = 1.66666666666666657415e-01;
+  const double PS1 = -3.25565818622400915405e-01;
+  const double PS2 = 2.01212532134862925881e-01;
+  const double PS3 = -4.00555345006794114027e-02;
+  const double PS4 = 7.91534994289814532176e-04;
+  const double PS5 = 3.47933107596021167570e-05;
+  const double QS1 = -2.40339491173441421878e+00;
+  const double QS2 = 2.02094576023350569471e+00;
+  const double QS3 = -6.88283971605453293030e-01;
+  const double QS4 = 7.70381505559019352791e-02;
+
+  VECTOR_MATH_INLINE double round_nearest( double x )
+  {
+    return ( x + ROUND_MAGIC ) - ROUND_MAGIC;
+  }
+
+  VECTOR_MATH_INLINE void kernel_sincos( double x, double& s, double& c )
+  {
+    // Reduce to r in [-pi/4, pi/4], x = r + q * pi / 2.
+    double q = round_nearest( x * TWO_OVER_PI );
+    double r = (( x - q * PIO2_1 ) - q * PIO2_2 ) - q * PIO2_3;
+
+    double z = r * r;
+    double sn = r + r * z * ( S1 + z * ( S2 + z * ( S3 + z *
+                ( S4 + z * ( S5 + z * S6 )))));
+
+    double hz = 0.5 * z;
+    double w = 1.0 - hz;
+    double cs = w + ((( 1.0 - w ) - hz ) + z * z * ( C1 + z * ( C2 +
+                z * ( C3 + z * ( C4 + z * ( C5 + z * C6 ))))));
+
+    // Quadrant m = q mod 4.
+    double f = q * 0.25;
+    double fl = round_nearest( f );
+    fl -= fl > f ? 1.0 : 0.0;
+    double m = q - 4.0 * fl;
+
+    // Selects only pick constants or finished values and signs are 
+    // applied by exact products, so the loops vectorize with blends.
+    bool odd = ( m == 1.0 ) | ( m == 3.0 );
+    double sv = odd ? cs : sn;
+    double cv = odd ? sn : cs;
+
+    s = sv * ( m >= 2.0 ? -1.0 : 1.0 );
+    c = cv * ((( m == 1.0 ) | ( m == 2.0 )) ? -1.0 : 1.0 );
+  }
+
+  VECTOR_MATH_INLINE double kernel_atan2( double y, double x )
+  {
+    double ay = std::fabs( y );
+    double ax = std::fabs( x );
+    double mx = ay > ax ? ay : ax;
+    double mn = ay > ax ? ax : ay;
+
+    // Ratio in [0, 1], atan2( 0, 0 ) reduces to 0.
+    double t = mn / ( mx == 0.0 ? 1.0 : mx );
+
+    // Above 0.66 use atan( t ) = pi / 4 + atan( ( t - 1 ) / ( t + 1 ) ).
+    double k = t > 0.66 ? 1.0 : 0.0;
+    double u = ( t - k ) / ( k * t + 1.0 );
+
+    double z = u * u;
+    double p = ((( AP0 * z + AP1 ) * z + AP2 ) * z + AP3 ) * z + AP4;
+    double q = (((( z + AQ0 ) * z + AQ1 ) * z + AQ2 ) * z + AQ3 ) * z + AQ4;
+    double a = u * ( z * p / q ) + u;
+    a = k * PIO4_HI + ( a + k * PIO4_LO );
+
+    // Octant and quadrant: pi / 2 - a when |y| > |x|, pi - a when x < 0
+    // (including -0, as libm does).
+    bool swap = ay > ax;
+    a = ( swap ? PIO2_HI : 0.0 ) + 
+        ( swap ? -1.0 : 1.0 ) * ( a - ( swap ? PIO2_LO : 0.0 ));
+    bool left = std::signbit( x );
+    a = ( left ? PI_HI : 0.0 ) + 
+        ( left ? -1.0 : 1.0 ) * ( a - ( left ? PI_LO : 0.0 ));
+
+    return std::copysign( a, y );
+  }
+
+  VECTOR_MATH_INLINE double asin_rational( double z )
+  {
+    double p = z * ( PS0 + z * ( PS1 + z * ( PS2 + z *
+               ( PS3 + z * ( PS4 + z * PS5 )))));
+    double q = 1.0 + z * ( QS1 + z * ( QS2 + z * ( QS3 + z * QS4 )));
+
+    return p / q;
+  }
+
+  VECTOR_MATH_INLINE double kernel_asin( double x )
+  {
+    double ax = std::fabs( x );
+    ax = std::min( ax, 1.0 );
+
+    // asin( x ) = pi / 2 - 2 asin( sqrt( ( 1 - x ) / 2 )) above 0.5.
+    bool big = ax > 0.5;
+    double z_big = ( 1.0 - ax ) * 0.5;
+    double z_small = ax * ax;
+    double z = big ? z_big : z_small;
+    double root = std::sqrt( z );
+    double s = big ? root : ax;
+
+    double r = s + s * asin_rational( z );
+    r = ( big ? PIO2_HI : 0.0 ) + 
+        ( big ? -2.0 : 1.0 ) * ( r - ( big ? 0.5 * PIO2_LO : 0.0 ));
+
+    return std::copysign( r, x );
+  }
+
+  VECTOR_MATH_INLINE double kernel_acos( double x )
+  {
+    x = std::max( -1.0, std::min( x, 1.0 ));
+
+    double ax = std::fabs( x );
+    bool small = ax <= 0.5;
+    double z_big = ( 1.0 - ax ) * 0.5;
+    double z_small = x * x;
+    double z = small ? z_small : z_big;
+    double root = std::sqrt( z );
+    double s = small ? x : root;
+    double w = s * asin_rational( z );
+
+    // pi / 2 - asin( x ) around zero, 2 asin( s ) for x > 0.5 and
+    // pi - 2 asin( s ) for x < -0.5.
+    bool right = x > 0.5;
+    double r = ( right ? 0.0 : PIO2_HI ) + 
+               ( right ? 1.0 : -1.0 ) * ( s + ( w - ( right ? 0.0 : PIO2_LO )));
+
+    return r * ( small ? 1.0 : 2.0 );
+  }
+
+// Array loops over the kernels, one copy per instruction set.
+#define VECTOR_MATH_LOOPS( isa, attribute )                             \
+  attribute void sincos_##isa( const double* x, double* s, double* c,   \
+                               size_t count )                           \
+  {                                                                     \
+    for( size_t i = 0; i < count; i++ ) {                               \
+      kernel_sincos( x[i], s[i], c[i] );                                \
+    }                                                                   \
+  }                                                                     \
+                                                                        \
+  attribute void atan2_##isa( const double* y, const double* x,         \
+                              double* r, size_t count )                 \
+  {                                                                     \
+    for( size_t i = 0; i < count; i++ ) {                               \
+      r[i] = kernel_atan2( y[i], x[i] );                                \
+    }                                                                   \
+  }                                                                     \
+                                                                        \
+  attribute void asin_##isa( const double* x, double* r, size_t count ) \
+  {                                                                     \
+    for( size_t i = 0; i < count; i++ ) {                               \
+      r[i] = kernel_asin( x[i] );                                       \
+    }                                                                   \
+  }                                                                     \
+                                                                        \
+  attribute void acos_##isa( const double* x, double* r, size_t count ) \
+  {                                                                     \
+    for( size_t i = 0; i < count; i++ ) {                               \
+      r[i] = kernel_acos( x[i] );                                       \
+    }                                                                   \
+  }
+
+  VECTOR_MATH_LOOPS( scalar, )
+
+#ifdef VECTOR_MATH_DISPATCH
+  VECTOR_MATH_LOOPS( avx512f, __attribute__(( target( "avx512f" ))) )
+  VECTOR_MATH_LOOPS( avx2, __attribute__(( target( "avx2,fma" ))) )
+#endif
+
+  struct vector_math_table {
+    void ( *sincos )( const double*, double*, double*, size_t );
+    void ( *atan2 )( const double*, const double*, double*, size_t );
+    void ( *asin )( const double*, double*, size_t );
+    void ( *acos )( const double*, double*, size_t );
+    const char* isa;
+  };
+
+  vector_math_table select_table()
+  {
+#ifdef VECTOR_MATH_DISPATCH
+    __builtin_cpu_init();
+
+    if( __builtin_cpu_supports( "avx512f" ) ) {
+      vector_math_table table = { sincos_avx512f, atan2_avx512f,
+                                  asin_avx512f, acos_avx512f, "avx512f" };
+      return table;
+    }
+
+    if( __builtin_cpu_supports( "avx2" ) &&
+        __builtin_cpu_supports( "fma" ) ) {
+      vector_math_table table = { sincos_avx2, atan2_avx2,
+                                  asin_avx2, acos_avx2, "avx2" };
+      return table;
+    }
+
+    // SSE2 is the x86-64 baseline, the scalar loops are built for it.
+    vector_math_table table = { sincos_scalar, atan2_scalar,
+                                asin_scalar, acos_scalar, "sse2" };
+#else
+    vector_math_table table = { sincos_scalar, atan2_scalar,
+                                asin_scalar, acos_scalar, "scalar" };
+#endif
+    return table;
+  }
+
+  const vector_math_table& get_table()
+  {
+    // Selected once, C++11 makes the initialization thread safe.
+    static const vector_math_table table = select_table();
+
+    return table;
+  }
+
+}
+
+  void vector_math::sincos( const double* x, double* s, double* c,
+   size_t count )
+  {
+    get_table().sincos( x, s, c, count );
+  }
+
+  void vector_math::atan2( const double* y, const double* x, double* r,
+   size_t count )
+  {
+    get_table().atan2( y, x, r, count );
+  }
+
+  void vector_math::asin( const double* x, double* r, size_t count )
+  {
+    get_table().asin( x, r, count );
+  }
+
+  void vector_math::acos( const double* x, double* r, size_t count )
+  {
+    get_table().acos( x, r, count );
+  }
+
+  const char* vector_math::get_isa()
+  {
+    return get_table().isa;
+  }
+
+}
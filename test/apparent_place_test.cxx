@@ -0,0 +1,121 @@
+/**
+ * @file
+ *
+ * Tests for an apparent_place class.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * @mainteiner: ederbsd@gmail.com
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/apparent_place.hxx>
+#include <sidereus/precession.hxx>
+
+#include <genesis/logger.hxx>
+#include <genesis/tests.hxx>
+
+#include <cmath>
+
+// Test for class Apparent Place.
+static int apparent_place_test( void )
+{
+  GEN_MSG( "Tests for class Apparent Place.\n" );
+
+  const size_t count = 5;
+
+  double ra[count] = { 41.0540625, 0.0, 101.2871, 279.2347, 359.99 };
+  double dec[count] = { 49.2277489, 89.2641, -16.7161, 38.7837, -45.0 };
+  double out_ra[count], out_dec[count];
+
+  genesis::proto_geo::point_equ_posn mean, position, precessed;
+  genesis::proto_geo::point_rect_coord v;
+
+  // Set for tests.
+  int failed = 0;
+
+  // Example 23.a, theta Persei on 2028 November 13.19 TD, with the 
+  // proper motion of example 21.b already applied.
+  sidereus::epoch frame( 2462088.69 );
+  sidereus::apparent_place place( &frame );
+
+  mean.ra = ra[0];
+  mean.dec = dec[0];
+  place.get( &mean, &position );
+
+  // 2h 46m 14.390s, +49 21' 07.45".
+  failed += GEN_TEST_RESULT( "(Apparent Place) 23.a ra", position.ra, 
+                             41.5599583, 0.00001 );
+  failed += GEN_TEST_RESULT( "(Apparent Place) 23.a dec", position.dec, 
+                             49.3520694, 0.00001 );
+
+  // The velocity is the constant of aberration within the 
+  // eccentricity of the orbit.
+  place.get_velocity( &v );
+  failed += GEN_TEST_RESULT( "(Apparent Place) Velocity (arcsec)", 
+                             GEN_GEOMETRY_RADTODEG( std::sqrt( v.x * v.x + 
+                              v.y * v.y + v.z * v.z )) * 3600.0, 
+                             APPARENT_PLACE_ABERRATION, 0.4 );
+
+  // Without aberration the matrix gives the precession of example 
+  // 21.b plus the nutation of example 23.a, 15.843" and 6.218".
+  sidereus::precession::get_equ_prec2( &mean, JULIAN_DAY_JD2000, 
+                                       frame.get_jd(), &precessed );
+  sidereus::rotation::get_rect( mean.ra, mean.dec, &v );
+  place.get_matrix().apply( &v, &v );
+  sidereus::rotation::get_spherical( &v, &position.ra, &position.dec );
+
+  failed += GEN_TEST_RESULT( "(Apparent Place) Nutation ra (arcsec)", 
+                             ( position.ra - precessed.ra ) * 3600.0, 
+                             15.843, 0.02 );
+  failed += GEN_TEST_RESULT( "(Apparent Place) Nutation dec (arcsec)", 
+                             ( position.dec - precessed.dec ) * 3600.0, 
+                             6.218, 0.02 );
+
+  // Arrays against single positions, and an other catalog equinox.
+  place.get( ra, dec, count, out_ra, out_dec );
+
+  for( size_t i = 0; i < count; i++ ) {
+    mean.ra = ra[i];
+    mean.dec = dec[i];
+    place.get( &mean, &position );
+
+    failed += GEN_TEST_RESULT( "(Apparent Place) Batch ra", out_ra[i], 
+                               position.ra, 1e-9 );
+    failed += GEN_TEST_RESULT( "(Apparent Place) Batch dec", out_dec[i], 
+                               position.dec, 1e-9 );
+  }
+
+  sidereus::apparent_place b1950( &frame, JULIAN_DAY_B1950 );
+
+  mean.ra = ra[0];
+  mean.dec = dec[0];
+  sidereus::precession::get_equ_prec2( &mean, JULIAN_DAY_JD2000, 
+                                       JULIAN_DAY_B1950, &precessed );
+  b1950.get( &precessed, &position );
+
+  failed += GEN_TEST_RESULT( "(Apparent Place) B1950 ra", position.ra, 
+                             41.5599583, 0.00001 );
+  failed += GEN_TEST_RESULT( "(Apparent Place) B1950 dec", position.dec, 
+                             49.3520694, 0.00001 );
+
+  GEN_MSG( "End: Apparent Place.\n" );
+
+  return failed;
+}
+
+int main( int argc, char* argv[] ) 
+{
+  int failed = 0;
+
+  failed += apparent_place_test();
+
+  GEN_TEST_PRINT_RESULT( "apparent_place", failed );
+
+  return( failed > 0 );
+}
@@ -0,0 +1,131 @@
+/**
+ * @file
+ *
+ * Tests for an catalog_reader class.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * @mainteiner: ederbsd@gmail.com
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/catalog_reader.hxx>
+
+#include <genesis/logger.hxx>
+#include <genesis/tests.hxx>
+
+#include <cstdio>
+
+// Test for class Catalog Reader.
+static int catalog_reader_test( void )
+{
+  GEN_MSG( "Tests for class Catalog Reader.\n" );
+
+  // Records of ra, dec and magnitude.
+  const size_t count = 1000;
+
+  double ra[64], dec[64];
+
+  size_t n = 0, total = 0;
+
+  // Set for tests.
+  int failed = 0;
+
+  FILE* out = fopen( "catalog_reader_test.bin", "wb" );
+
+  for( size_t i = 0; i < count; i++ ) {
+    double record[3] = { i * 0.25, i * 0.05 - 25.0, 5.0 };
+
+    fwrite( record, sizeof( record ), 1, out );
+  }
+
+  fclose( out );
+
+  sidereus::catalog_reader catalog;
+
+  failed += GEN_TEST_RESULT( "(Catalog Reader) offsets outside record", 
+                             catalog.open( "catalog_reader_test.bin", 24, 
+                                           0, 20 ), false, 0 );
+  failed += GEN_TEST_RESULT( "(Catalog Reader) partial record", 
+                             catalog.open( "catalog_reader_test.bin", 36 ), 
+                             false, 0 );
+  failed += GEN_TEST_RESULT( "(Catalog Reader) open", 
+                             catalog.open( "catalog_reader_test.bin", 24 ), 
+                             true, 0 );
+  failed += GEN_TEST_RESULT( "(Catalog Reader) count", catalog.get_count(), 
+                             count, 0 );
+
+  // Chunks that don't divide the catalog.
+  while(( n = catalog.read( ra, dec, 64 )) > 0 ) {
+    for( size_t i = 0; i < n; i++ ) {
+      failed += GEN_TEST_RESULT( "(Catalog Reader) RA", ra[i], 
+                                 ( total + i ) * 0.25, 0 );
+      failed += GEN_TEST_RESULT( "(Catalog Reader) DEC", dec[i], 
+                                 ( total + i ) * 0.05 - 25.0, 0 );
+    }
+
+    total += n;
+  }
+
+  failed += GEN_TEST_RESULT( "(Catalog Reader) records read", total, 
+                             count, 0 );
+
+  // Declination from the magnitude column, in place.
+  failed += GEN_TEST_RESULT( "(Catalog Reader) reopen", 
+                             catalog.open( "catalog_reader_test.bin", 24, 
+                                           8, 16 ), true, 0 );
+  failed += GEN_TEST_RESULT( "(Catalog Reader) read", 
+                             catalog.read( ra, dec, 1 ), 1, 0 );
+  failed += GEN_TEST_RESULT( "(Catalog Reader) other offsets", dec[0], 
+                             5.0, 0 );
+  failed += GEN_TEST_RESULT( "(Catalog Reader) record in place", 
+                             *( const double* )catalog.get_record( 2 ), 
+                             0.5, 0 );
+
+  catalog.rewind();
+
+  failed += GEN_TEST_RESULT( "(Catalog Reader) rewind", 
+                             catalog.get_position(), 0, 0 );
+
+  catalog.close();
+
+  failed += GEN_TEST_RESULT( "(Catalog Reader) close", catalog.is_open(), 
+                             false, 0 );
+
+  std::remove( "catalog_reader_test.bin" );
+
+  // An empty catalog opens with no records.
+  out = fopen( "catalog_reader_test.bin", "wb" );
+  fclose( out );
+
+  failed += GEN_TEST_RESULT( "(Catalog Reader) open empty", 
+                             catalog.open( "catalog_reader_test.bin" ), 
+                             true, 0 );
+  failed += GEN_TEST_RESULT( "(Catalog Reader) empty count", 
+                             catalog.get_count(), 0, 0 );
+  failed += GEN_TEST_RESULT( "(Catalog Reader) empty read", 
+                             catalog.read( ra, dec, 64 ), 0, 0 );
+
+  catalog.close();
+  std::remove( "catalog_reader_test.bin" );
+
+  GEN_MSG( "End: Catalog Reader.\n" );
+
+  return failed;
+}
+
+int main( int argc, char* argv[] ) 
+{
+  int failed = 0;
+
+  failed += catalog_reader_test();
+
+  GEN_TEST_PRINT_RESULT( "catalog_reader", failed );
+
+  return( failed > 0 );
+}
@@ -0,0 +1,121 @@
+/**
+ * @file
+ *
+ * Tests for an epoch class.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * @mainteiner: ederbsd@gmail.com
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/epoch.hxx>
+#include <sidereus/precession.hxx>
+#include <sidereus/sidereal_time.hxx>
+#include <sidereus/transform_coord.hxx>
+
+#include <genesis/logger.hxx>
+#include <genesis/tests.hxx>
+
+// Test for class Epoch.
+static int epoch_test( void )
+{
+  GEN_MSG( "Tests for class Epoch.\n" );
+
+  double JD = 2446895.5;
+
+  sidereus::nutation::nut nutation;
+  sidereus::rotation matrix;
+  sidereus::transform_coord T;
+
+  genesis::proto_geo::point_equ_posn object, equ, frame_equ;
+  genesis::proto_geo::point_lon_lat_posn ecl, frame_ecl, observer;
+  genesis::proto_geo::point_hrz_posn hrz, frame_hrz;
+
+  // Set for tests.
+  int failed = 0;
+
+  sidereus::epoch frame( JD );
+
+  // Same values as computing each quantity on its own.
+  sidereus::nutation( JD, &nutation );
+
+  failed += GEN_TEST_RESULT( "(Epoch) T for JD 2446895.5", 
+                             frame.get_t(), -0.127296372348, 0.000001 );
+  failed += GEN_TEST_RESULT( "(Epoch) mean sidereal", 
+                             frame.get_mean_sidereal(), 
+                             sidereus::sidereal_time::get_mean( JD ), 0 );
+  failed += GEN_TEST_RESULT( "(Epoch) apparent sidereal", 
+                             frame.get_apparent_sidereal(), 
+                             sidereus::sidereal_time::get_apparent( JD ), 0 );
+  failed += GEN_TEST_RESULT( "(Epoch) nutation longitude", 
+                             frame.get_nutation().longitude, 
+                             nutation.longitude, 0 );
+  failed += GEN_TEST_RESULT( "(Epoch) true obliquity", 
+                             frame.get_nutation().ecliptic, 
+                             nutation.ecliptic, 0 );
+
+  sidereus::precession::get_matrix( JULIAN_DAY_JD2000, JD, &matrix );
+
+  for( int i = 0; i < 3; i++ ) {
+    for( int j = 0; j < 3; j++ ) {
+      failed += GEN_TEST_RESULT( "(Epoch) precession", 
+                                 frame.get_precession().m[i][j], 
+                                 matrix.m[i][j], 0 );
+    }
+  }
+
+  // Transforms give the same result with the frame as with the JD.
+  object.ra = 116.328942;
+  object.dec = 28.026183;
+  observer.lon = -77.065;
+  observer.lat = 38.921;
+
+  T.get_ecl_from_equ( &object, JD, &ecl );
+  T.get_ecl_from_equ( &object, &frame, &frame_ecl );
+  failed += GEN_TEST_RESULT( "(Epoch) Equ to Ecl LON ", frame_ecl.lon, 
+                             ecl.lon, 0.0000000001 );
+  failed += GEN_TEST_RESULT( "(Epoch) Equ to Ecl LAT ", frame_ecl.lat, 
+                             ecl.lat, 0.0000000001 );
+
+  T.get_equ_from_ecl( &ecl, JD, &equ );
+  T.get_equ_from_ecl( &ecl, &frame, &frame_equ );
+  failed += GEN_TEST_RESULT( "(Epoch) Ecl to Equ RA ", frame_equ.ra, 
+                             equ.ra, 0.0000000001 );
+  failed += GEN_TEST_RESULT( "(Epoch) Ecl to Equ DEC ", frame_equ.dec, 
+                             equ.dec, 0.0000000001 );
+
+  T.get_hrz_from_equ( &object, &observer, JD, &hrz );
+  T.get_hrz_from_equ( &object, &observer, &frame, &frame_hrz );
+  failed += GEN_TEST_RESULT( "(Epoch) Equ to Horiz ALT ", frame_hrz.alt, 
+                             hrz.alt, 0.0000000001 );
+  failed += GEN_TEST_RESULT( "(Epoch) Equ to Horiz AZ ", frame_hrz.az, 
+                             hrz.az, 0.0000000001 );
+
+  T.get_equ_from_hrz( &hrz, &observer, JD, &equ );
+  T.get_equ_from_hrz( &hrz, &observer, &frame, &frame_equ );
+  failed += GEN_TEST_RESULT( "(Epoch) Horiz to Equ RA ", frame_equ.ra, 
+                             equ.ra, 0.0000000001 );
+  failed += GEN_TEST_RESULT( "(Epoch) Horiz to Equ DEC ", frame_equ.dec, 
+                             equ.dec, 0.0000000001 );
+
+  GEN_MSG( "End: Epoch.\n" );
+
+  return failed;
+}
+
+int main( int argc, char* argv[] ) 
+{
+  int failed = 0;
+
+  failed += epoch_test();
+
+  GEN_TEST_PRINT_RESULT( "epoch", failed );
+
+  return( failed > 0 );
+}
@@ -0,0 +1,138 @@
+/**
+ * @file
+ *
+ * Tests for an frames class.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * @mainteiner: ederbsd@gmail.com
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/frames.hxx>
+#include <sidereus/julian_day.hxx>
+#include <sidereus/precession.hxx>
+#include <sidereus/transform_coord.hxx>
+
+#include <genesis/logger.hxx>
+#include <genesis/tests.hxx>
+
+#include <cmath>
+
+// Test for class Frames.
+static int frames_test( void )
+{
+  GEN_MSG( "Tests for class Frames.\n" );
+
+  const size_t count = 7;
+
+  double lon[count] = { 0.0, 33.3, 121.2, 180.0, 266.4, 301.7, 359.9 };
+  double lat[count] = { 0.0, -12.5, 60.1, 89.5, -28.9, 45.0, -89.0 };
+  double x[count], y[count], z[count], out_lon[count], out_lat[count];
+
+  genesis::proto_geo::point_lon_lat_posn position;
+  genesis::proto_geo::point_gal_posn gal;
+  genesis::proto_geo::point_equ_posn equ, equ2000;
+  genesis::proto_geo::point_lon_lat_posn ecl;
+  genesis::proto_geo::point_hrz_posn hrz;
+
+  double JD = 2448976.5;
+
+  // Set for tests.
+  int failed = 0;
+
+  position.lon = -77.065556;
+  position.lat = 38.921389;
+
+  sidereus::observer site( &position );
+  sidereus::epoch frame( JD );
+  sidereus::transform_coord T;
+
+  // Batch conversions against single vectors, and back.
+  sidereus::rotation::get_rect( lon, lat, count, x, y, z );
+  sidereus::rotation::get_spherical( x, y, z, count, out_lon, out_lat );
+
+  for( size_t i = 0; i < count; i++ ) {
+    genesis::proto_geo::point_rect_coord v;
+
+    sidereus::rotation::get_rect( lon[i], lat[i], &v );
+
+    failed += GEN_TEST_RESULT( "(Frames) Batch rect x", x[i], v.x, 1e-15 );
+    failed += GEN_TEST_RESULT( "(Frames) Batch rect y", y[i], v.y, 1e-15 );
+    failed += GEN_TEST_RESULT( "(Frames) Batch rect z", z[i], v.z, 1e-15 );
+    failed += GEN_TEST_RESULT( "(Frames) Batch spherical lon", 
+                               out_lon[i], lon[i], 1e-10 );
+    failed += GEN_TEST_RESULT( "(Frames) Batch spherical lat", 
+                               out_lat[i], lat[i], 1e-10 );
+  }
+
+  // Galactic to ecliptic of date as one matrix, against the chain of 
+  // spherical transforms.
+  sidereus::rotation chain = sidereus::frames::get_ecl_from_equ( &frame ) *
+    sidereus::frames::get_precession( JULIAN_DAY_JD2000, JD ) *
+    sidereus::frames::get_gal_from_equ2000().transpose();
+
+  sidereus::rotation::get_rect( lon, lat, count, x, y, z );
+  chain.apply( x, y, z, count );
+  sidereus::rotation::get_spherical( x, y, z, count, out_lon, out_lat );
+
+  for( size_t i = 0; i < count; i++ ) {
+    gal.lon = lon[i];
+    gal.lat = lat[i];
+
+    T.get_equ2000_from_gal( &gal, &equ2000 );
+    sidereus::precession::get_equ_prec2( &equ2000, JULIAN_DAY_JD2000, JD, 
+                                         &equ );
+    T.get_ecl_from_equ( &equ, &frame, &ecl );
+
+    // Longitude is undefined at the ecliptic poles.
+    if( std::fabs( ecl.lat ) < 89.0 ) {
+      failed += GEN_TEST_RESULT( "(Frames) Chain lon", out_lon[i], 
+                                 ecl.lon, 1e-8 );
+    }
+    failed += GEN_TEST_RESULT( "(Frames) Chain lat", out_lat[i], 
+                               ecl.lat, 1e-8 );
+  }
+
+  // Horizontal frame against the observer, azimuth west from south.
+  sidereus::rotation hrz_from_equ = 
+    sidereus::frames::get_hrz_from_equ( &site, &frame );
+
+  sidereus::rotation::get_rect( lon, lat, count, x, y, z );
+  hrz_from_equ.apply( x, y, z, count );
+  sidereus::rotation::get_spherical( x, y, z, count, out_lon, out_lat );
+
+  for( size_t i = 0; i < count; i++ ) {
+    equ.ra = lon[i];
+    equ.dec = lat[i];
+
+    site.get_hrz_from_equ( &equ, &frame, &hrz );
+
+    if( std::fabs( hrz.alt ) < 89.0 ) {
+      failed += GEN_TEST_RESULT( "(Frames) Horizontal az", out_lon[i], 
+                                 hrz.az, 1e-8 );
+    }
+    failed += GEN_TEST_RESULT( "(Frames) Horizontal alt", out_lat[i], 
+                               hrz.alt, 1e-8 );
+  }
+
+  GEN_MSG( "End: Frames.\n" );
+
+  return failed;
+}
+
+int main( int argc, char* argv[] ) 
+{
+  int failed = 0;
+
+  failed += frames_test();
+
+  GEN_TEST_PRINT_RESULT( "frames", failed );
+
+  return( failed > 0 );
+}
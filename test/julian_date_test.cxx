@@ -0,0 +1,108 @@
+/**
+ * @file
+ *
+ * Tests for an julian_date class.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * @mainteiner: ederbsd@gmail.com
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/julian_date.hxx>
+#include <sidereus/julian_day.hxx>
+#include <sidereus/sidereal_time.hxx>
+
+#include <genesis/logger.hxx>
+#include <genesis/tests.hxx>
+
+// Tests for class Julian Date.
+static int julian_date_test( void )
+{
+  GEN_MSG( "Tests for class Julian Date.\n" );
+
+  sidereus::julian_day J;
+
+  genesis::proto_datetime::date date;
+
+  double sidereal = 0.0;
+  double step = 0.0;
+
+  // Set for tests.
+  int failed = 0;
+
+  // A single number splits exactly.
+  sidereus::julian_date A( 2461041.25 );
+
+  failed += GEN_TEST_RESULT( "(Julian Date) Day", A.get_day(), 
+                             2461041.0, 0 );
+  failed += GEN_TEST_RESULT( "(Julian Date) Fraction", A.get_fraction(), 
+                             0.25, 0 );
+
+  // Days and fractions of any size or sign are normalized.
+  sidereus::julian_date B( 2461041.5, -0.75 );
+
+  failed += GEN_TEST_RESULT( "(Julian Date) Normalized day", B.get_day(), 
+                             2461040.0, 0 );
+  failed += GEN_TEST_RESULT( "(Julian Date) Normalized fraction", 
+                             B.get_fraction(), 0.75, 0 );
+
+  // A microsecond is lost in a single double, not in two parts.
+  sidereus::julian_date C = A + 1e-6 / 86400.0;
+
+  failed += GEN_TEST_RESULT( "(Julian Date) Microsecond", 
+                             ( C - A ) * 86400.0, 1e-6, 1e-11 );
+  failed += GEN_TEST_RESULT( "(Julian Date) Days", 
+                             ( A + 3.5 ) - A, 3.5, 0 );
+
+  // Calendar date, seconds kept apart from the day.
+  date.years = 2026;
+  date.months = 1;
+  date.days = 1;
+  date.hours = 18;
+  date.minutes = 0;
+  date.seconds = 0.000001;
+
+  sidereus::julian_date D = J.get_julian_date( &date );
+
+  failed += GEN_TEST_RESULT( "(Julian Date) Calendar day", D.get_day(), 
+                             2461042.0, 0 );
+  failed += GEN_TEST_RESULT( "(Julian Date) Calendar fraction", 
+                             D.get_fraction(), 
+                             0.25 + 0.000001 / 86400.0, 1e-17 );
+  failed += GEN_TEST_RESULT( "(Julian Date) Calendar JD", D.get_jd(), 
+                             J.get_julian_day( &date ), 1e-9 );
+
+  // Sidereal time of a two part date agrees with a single number.
+  sidereal = sidereus::sidereal_time::get_mean( A );
+
+  failed += GEN_TEST_RESULT( "(Julian Date) Mean sidereal", sidereal, 
+                             sidereus::sidereal_time::get_mean( 
+                               A.get_jd() ), 1e-9 );
+
+  // And a microsecond later runs fast by the sidereal rate.
+  step = ( sidereus::sidereal_time::get_mean( C ) - sidereal ) * 3600.0;
+
+  failed += GEN_TEST_RESULT( "(Julian Date) Sidereal microsecond", step, 
+                             1.00273790935e-6, 1e-10 );
+
+  GEN_MSG( "End: Julian Date.\n" );
+
+  return failed;
+}
+
+int main( int argc, char* argv[] ) 
+{
+  int failed = 0;
+
+  failed += julian_date_test();
+
+  GEN_TEST_PRINT_RESULT( "julian_date", failed );
+
+  return( failed > 0 );
+}
@@ -26,6 +26,8 @@ static int julian_day_test( void )
 
   sidereus::julian_day J;
 
+  const size_t count = 8;
+
   double JD = 0.0;
   double JD2 = 0.0;
 
@@ -119,6 +121,55 @@ static int julian_day_test( void )
                              "from system and from JD", 
                              std::difftime( now, now_jd ), 0, 0 );
 
+  // Meeus table 7.a, down to the first Julian Day.
+  genesis::proto_datetime::date dates[count] = {
+    { 1600, 1, 1, 0, 0, 0.0 },
+    { 837, 4, 10, 7, 12, 0.0 },
+    { -1000, 7, 12, 12, 0, 0.0 },
+    { -4712, 1, 1, 12, 0, 0.0 },
+    { 1582, 10, 4, 0, 0, 0.0 },
+    { 1582, 10, 15, 0, 0, 0.0 },
+    { 2000, 2, 29, 23, 59, 59.5 },
+    { 1900, 3, 1, 6, 30, 0.0 }
+  };
+  double expected[count] = { 2305447.5, 2026871.8, 1356001.0, 0.0,
+                             2299159.5, 2299160.5, 2451604.4999942,
+                             2415079.7708333 };
+  double jds[count];
+
+  J.get_julian_day( dates, count, jds );
+
+  for( size_t i = 0; i < count; i++ ) {
+    failed += GEN_TEST_RESULT( "(Julian Day) Batch JD", jds[i], 
+                               expected[i], 1e-7 );
+    failed += GEN_TEST_RESULT( "(Julian Day) Batch against single", 
+                               jds[i], J.get_julian_day( &dates[i] ), 0 );
+  }
+
+  // And back, against the single day version.
+  genesis::proto_datetime::date back[count];
+
+  J.get_date( jds, count, back );
+
+  for( size_t i = 0; i < count; i++ ) {
+    J.get_date( jds[i], &pdate );
+
+    failed += GEN_TEST_RESULT( "(Julian Day) Batch against single day", 
+                               back[i].days, pdate.days, 0 );
+    failed += GEN_TEST_RESULT( "(Julian Day) Batch date year", 
+                               back[i].years, dates[i].years, 0 );
+    failed += GEN_TEST_RESULT( "(Julian Day) Batch date month", 
+                               back[i].months, dates[i].months, 0 );
+    failed += GEN_TEST_RESULT( "(Julian Day) Batch date day", 
+                               back[i].days, dates[i].days, 0 );
+    failed += GEN_TEST_RESULT( "(Julian Day) Batch date hour", 
+                               back[i].hours, dates[i].hours, 0 );
+    failed += GEN_TEST_RESULT( "(Julian Day) Batch date minute", 
+                               back[i].minutes, dates[i].minutes, 0 );
+    failed += GEN_TEST_RESULT( "(Julian Day) Batch date second", 
+                               back[i].seconds, dates[i].seconds, 1e-4 );
+  }
+
   GEN_MSG( "End: Julian Day.\n" );
 
   return failed;
@@ -15,10 +15,47 @@
  */
 
 #include <sidereus/nutation.hxx>
+#include <sidereus/nutation_table.hxx>
+#include <sidereus/sidereal_time.hxx>
+
+#include <cstdio>
+#include <limits>
+#include <stdint.h>
+#include <unistd.h>
 
 #include <genesis/logger.hxx>
 #include <genesis/tests.hxx>
 
+// Save a table, overwrite a header field and check that the file is 
+// refused. Offsets follow the table file header.
+static int corrupt_table_test( const sidereus::nutation_table* table, 
+ const char* name, long offset, const void* value, size_t size )
+{
+  sidereus::nutation_table loaded;
+
+  int failed = 0;
+
+  table->save( "nutation_table_test.bad" );
+
+  FILE* file = std::fopen( "nutation_table_test.bad", "r+b" );
+
+  std::fseek( file, offset, SEEK_SET );
+  std::fwrite( value, size, 1, file );
+  std::fclose( file );
+
+  GEN_MSG( name );
+  GEN_MSG( "\n" );
+
+  failed += GEN_TEST_RESULT( "(Nutation Table) load corrupt header", 
+                             loaded.load( "nutation_table_test.bad" ), 0, 0 );
+  failed += GEN_TEST_RESULT( "(Nutation Table) map corrupt header", 
+                             loaded.map( "nutation_table_test.bad" ), 0, 0 );
+
+  std::remove( "nutation_table_test.bad" );
+
+  return failed;
+}
+
 // Test for class Nutation.
 static int nutation_test( void )
 {
@@ -38,22 +75,234 @@ static int nutation_test( void )
   sidereus::nutation( JD, &nutation );
 
   failed += GEN_TEST_RESULT( "(Nutation) longitude (deg) for JD 2446895.5", 
-                             nutation.longitude, -0.00100561, 0.00000001 );
+                             nutation.longitude, -0.00105221, 0.00000001 );
   failed += GEN_TEST_RESULT( "(Nutation) obliquity (deg) for JD 2446895.5", 
-                             nutation.obliquity, 0.00273297, 0.00000001 );
+                             nutation.obliquity, 0.00262293, 0.00000001 );
   failed += GEN_TEST_RESULT( "(Nutation) ecliptic (deg) for JD 2446895.5", 
-                             nutation.ecliptic, 23.44367936, 0.00000001 );
+                             nutation.ecliptic, 23.44356922, 0.00000001 );
+
+  // Batch series against the single day one, example 22.a and days
+  // from 1900 to 2100.
+  const size_t count = 6;
+
+  double days[count] = { 2446895.5, 2415020.0, 2433282.42, 2451545.0, 
+                         2462088.69, 2488069.5 };
+  double longitude[count], obliquity[count], ecliptic[count];
+
+  sidereus::nutation::get( days, count, longitude, obliquity, ecliptic );
+
+  for( size_t i = 0; i < count; i++ ) {
+    sidereus::nutation_cache cache;
+
+    sidereus::nutation( days[i], &nutation, &cache );
+
+    failed += GEN_TEST_RESULT( "(Nutation) Batch longitude (deg)", 
+                               longitude[i], nutation.longitude, 1e-10 );
+    failed += GEN_TEST_RESULT( "(Nutation) Batch obliquity (deg)", 
+                               obliquity[i], nutation.obliquity, 1e-10 );
+    failed += GEN_TEST_RESULT( "(Nutation) Batch ecliptic (deg)", 
+                               ecliptic[i], nutation.ecliptic, 1e-10 );
+  }
 
   GEN_MSG( "End: Nutation.\n" );
 
   return failed;
 }
 
+// Test for class Nutation Cache.
+static int nutation_cache_test( void )
+{
+  GEN_MSG( "Tests for class Nutation Cache.\n" );
+
+  double JD = 2446895.5;
+
+  sidereus::nutation::nut nutation, cached;
+  sidereus::nutation_cache cache;
+
+  // Set for tests.      
+  int failed = 0;
+
+  failed += GEN_TEST_RESULT( "(Nutation Cache) lookup on empty cache", 
+                             cache.lookup( JD, &cached ), 0, 0 );
+
+  sidereus::nutation( JD, &nutation, &cache );
+
+  failed += GEN_TEST_RESULT( "(Nutation Cache) longitude (deg) for JD 2446895.5", 
+                             nutation.longitude, -0.00105221, 0.00000001 );
+  failed += GEN_TEST_RESULT( "(Nutation Cache) obliquity (deg) for JD 2446895.5", 
+                             nutation.obliquity, 0.00262293, 0.00000001 );
+
+  // Within the default tolerance the cached value is returned.
+  failed += GEN_TEST_RESULT( "(Nutation Cache) lookup inside tolerance", 
+                             cache.lookup( JD + 0.05, &cached ), 1, 0 );
+  failed += GEN_TEST_RESULT( "(Nutation Cache) cached longitude", 
+                             cached.longitude, nutation.longitude, 0 );
+  failed += GEN_TEST_RESULT( "(Nutation Cache) lookup outside tolerance", 
+                             cache.lookup( JD + 0.2, &cached ), 0, 0 );
+
+  // A zero tolerance only reuses exact matches.
+  cache.set_tolerance( 0.0 );
+  failed += GEN_TEST_RESULT( "(Nutation Cache) zero tolerance, same JD", 
+                             cache.lookup( JD, &cached ), 1, 0 );
+  failed += GEN_TEST_RESULT( "(Nutation Cache) zero tolerance, other JD", 
+                             cache.lookup( JD + 0.05, &cached ), 0, 0 );
+
+  // Computing at another epoch and back gives the same result.
+  sidereus::nutation( JD + 1000.0, &cached, &cache );
+  sidereus::nutation( JD, &cached, &cache );
+  failed += GEN_TEST_RESULT( "(Nutation Cache) recomputed longitude", 
+                             cached.longitude, nutation.longitude, 0.00000001 );
+  failed += GEN_TEST_RESULT( "(Nutation Cache) recomputed obliquity", 
+                             cached.obliquity, nutation.obliquity, 0.00000001 );
+
+  cache.clear();
+  failed += GEN_TEST_RESULT( "(Nutation Cache) lookup after clear", 
+                             cache.lookup( JD, &cached ), 0, 0 );
+
+  GEN_MSG( "End: Nutation Cache.\n" );
+
+  return failed;
+}
+
+// Test for class Nutation Table.
+static int nutation_table_test( void )
+{
+  GEN_MSG( "Tests for class Nutation Table.\n" );
+
+  double JD = 0.0, sidereal = 0.0;
+
+  sidereus::nutation::nut nutation, interpolated, error;
+  sidereus::nutation_table table, loaded;
+
+  // Set for tests.      
+  int failed = 0;
+
+  // One year from J2000.
+  table.fit( 2451545.0, 2451910.0 );
+  table.get_max_error( &error, &sidereal );
+
+  failed += GEN_TEST_RESULT( "(Nutation Table) longitude error (deg)", 
+                             error.longitude, 0.0, 1e-10 );
+  failed += GEN_TEST_RESULT( "(Nutation Table) obliquity error (deg)", 
+                             error.obliquity, 0.0, 1e-10 );
+  failed += GEN_TEST_RESULT( "(Nutation Table) sidereal error (hours)", 
+                             sidereal, 0.0, 1e-12 );
+
+  for( int i = 0; i < 50; i++ ) {
+    sidereus::nutation_cache cache;
+
+    JD = 2451545.0 + i * 7.3 + 0.123;
+    sidereus::nutation( JD, &nutation, &cache );
+    table.get( JD, &interpolated );
+
+    failed += GEN_TEST_RESULT( "(Nutation Table) longitude (deg)", 
+                               interpolated.longitude, nutation.longitude, 
+                               1e-10 );
+    failed += GEN_TEST_RESULT( "(Nutation Table) obliquity (deg)", 
+                               interpolated.obliquity, nutation.obliquity, 
+                               1e-10 );
+    failed += GEN_TEST_RESULT( "(Nutation Table) ecliptic (deg)", 
+                               interpolated.ecliptic, nutation.ecliptic, 
+                               1e-10 );
+    failed += GEN_TEST_RESULT( "(Nutation Table) apparent sidereal (hours)", 
+                               table.get_apparent_sidereal( JD ), 
+                               sidereus::sidereal_time::get_apparent( JD, 
+                                                                      &cache ),
+                               1e-11 );
+  }
+
+  // Outside the span the series is used.
+  JD = 2446895.5;
+  failed += GEN_TEST_RESULT( "(Nutation Table) contains", 
+                             table.contains( JD ), 0, 0 );
+  table.get( JD, &interpolated );
+  failed += GEN_TEST_RESULT( "(Nutation Table) fallback longitude (deg)", 
+                             interpolated.longitude, -0.00105221, 0.00000001 );
+
+  // Saved and loaded tables are the same.
+  JD = 2451700.25;
+  failed += GEN_TEST_RESULT( "(Nutation Table) save", 
+                             table.save( "nutation_table_test.bin" ), 1, 0 );
+  failed += GEN_TEST_RESULT( "(Nutation Table) load", 
+                             loaded.load( "nutation_table_test.bin" ), 1, 0 );
+
+  table.get( JD, &nutation );
+  loaded.get( JD, &interpolated );
+  failed += GEN_TEST_RESULT( "(Nutation Table) loaded longitude", 
+                             interpolated.longitude, nutation.longitude, 0 );
+  failed += GEN_TEST_RESULT( "(Nutation Table) loaded obliquity", 
+                             interpolated.obliquity, nutation.obliquity, 0 );
+
+  // Mapped tables use the file in place.
+  sidereus::nutation_table mapped;
+
+  failed += GEN_TEST_RESULT( "(Nutation Table) map", 
+                             mapped.map( "nutation_table_test.bin" ), 1, 0 );
+  mapped.get( JD, &interpolated );
+  failed += GEN_TEST_RESULT( "(Nutation Table) mapped longitude", 
+                             interpolated.longitude, nutation.longitude, 0 );
+  failed += GEN_TEST_RESULT( "(Nutation Table) mapped sidereal", 
+                             mapped.get_apparent_sidereal( JD ), 
+                             table.get_apparent_sidereal( JD ), 0 );
+  mapped.get( 2446895.5, &interpolated );
+  failed += GEN_TEST_RESULT( "(Nutation Table) mapped fallback longitude", 
+                             interpolated.longitude, -0.00105221, 0.00000001 );
+
+  // Headers that would read past the file or break find().
+  int32_t degree = std::numeric_limits< int32_t >::max();
+  uint64_t segments = 1ULL << 62;
+  double zero = 0.0, nan = std::numeric_limits< double >::quiet_NaN();
+
+  failed += corrupt_table_test( &table, "Largest degree", 20, &degree, 
+                                sizeof( degree ));
+  failed += corrupt_table_test( &table, "Wrapping segments", 24, 
+                                &segments, sizeof( segments ));
+  failed += corrupt_table_test( &table, "NaN start", 32, &nan, 
+                                sizeof( nan ));
+  failed += corrupt_table_test( &table, "Zero segment", 40, &zero, 
+                                sizeof( zero ));
+
+  // A truncated file is refused.
+  failed += GEN_TEST_RESULT( "(Nutation Table) truncate", 
+                             truncate( "nutation_table_test.bin", 100 ), 0, 0 );
+  failed += GEN_TEST_RESULT( "(Nutation Table) map truncated file", 
+                             mapped.map( "nutation_table_test.bin" ), 0, 0 );
+  failed += GEN_TEST_RESULT( "(Nutation Table) empty after failed map", 
+                             mapped.contains( JD ), 0, 0 );
+  std::remove( "nutation_table_test.bin" );
+
+  failed += GEN_TEST_RESULT( "(Nutation Table) load missing file", 
+                             loaded.load( "nutation_table_test.none" ), 0, 0 );
+  failed += GEN_TEST_RESULT( "(Nutation Table) empty after failed load", 
+                             loaded.contains( JD ), 0, 0 );
+
+  // Arguments that would write a table load() and map() refuse.
+  failed += GEN_TEST_RESULT( "(Nutation Table) fit degree past maximum", 
+                             table.fit( 2451545.0, 2451600.0, 8.0, 
+                                        NUTATION_TABLE_MAX_DEGREE + 1 ), 
+                             0, 0 );
+  failed += GEN_TEST_RESULT( "(Nutation Table) fit negative degree", 
+                             table.fit( 2451545.0, 2451600.0, 8.0, -1 ), 
+                             0, 0 );
+  failed += GEN_TEST_RESULT( "(Nutation Table) fit zero segment", 
+                             table.fit( 2451545.0, 2451600.0, 0.0 ), 0, 0 );
+  failed += GEN_TEST_RESULT( "(Nutation Table) fit NaN segment", 
+                             table.fit( 2451545.0, 2451600.0, nan ), 0, 0 );
+  failed += GEN_TEST_RESULT( "(Nutation Table) unchanged after failed fit", 
+                             table.contains( JD ), 1, 0 );
+
+  GEN_MSG( "End: Nutation Table.\n" );
+
+  return failed;
+}
+
 int main( int argc, char* argv[] ) 
 {
   int failed = 0;
 
   failed += nutation_test();
+  failed += nutation_cache_test();
+  failed += nutation_table_test();
 
   GEN_TEST_PRINT_RESULT( "nutation", failed );
 
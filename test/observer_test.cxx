@@ -0,0 +1,142 @@
+/**
+ * @file
+ *
+ * Tests for an observer class.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * @mainteiner: ederbsd@gmail.com
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/observer.hxx>
+
+#include <genesis/logger.hxx>
+#include <genesis/tests.hxx>
+
+#include <algorithm>
+#include <cmath>
+
+// Test for class Observer.
+static int observer_test( void )
+{
+  GEN_MSG( "Tests for class Observer.\n" );
+
+  genesis::proto_geo::point_lon_lat_posn position;
+  genesis::proto_geo::point_equ_posn object, equ;
+  genesis::proto_geo::point_hrz_posn hrz;
+
+  genesis::proto_datetime::dms dms;
+
+  // Set for tests.
+  int failed = 0;
+
+  // Palomar observatory (example 11.a).
+  dms.neg = 0;
+  dms.degrees = 33;
+  dms.minutes = 21;
+  dms.seconds = 22;
+
+  position.lat = genesis::datetime::dms_to_deg( &dms );
+
+  dms.neg = 1;
+  dms.degrees = 116;
+  dms.minutes = 51;
+  dms.seconds = 47;
+
+  position.lon = genesis::datetime::dms_to_deg( &dms );
+
+  sidereus::observer palomar( &position, 1706 );
+
+  failed += GEN_TEST_RESULT( "(Observer) ro sin phi' ", palomar.get_ro_sin(), 
+                             0.546861, 0.000001 );
+  failed += GEN_TEST_RESULT( "(Observer) ro cos phi' ", palomar.get_ro_cos(), 
+                             0.836339, 0.000001 );
+
+  // Equatorial to horizontal and back with the same sidereal time.
+  object.ra = 347.3193375;
+  object.dec = -6.719891667;
+
+  palomar.get_hrz_from_equ_sidereal_time( &object, 8.5823, &hrz );
+  palomar.get_equ_from_hrz_sidereal_time( &hrz, 8.5823, &equ );
+
+  failed += GEN_TEST_RESULT( "(Observer) Horiz to Equ RA ", equ.ra, 
+                             object.ra, 0.00000001 );
+  failed += GEN_TEST_RESULT( "(Observer) Horiz to Equ DEC ", equ.dec, 
+                             object.dec, 0.00000001 );
+
+  // Arrays against single objects.
+  const size_t count = 4;
+
+  double ra[count] = { 0.0, 120.5, 250.0, 347.3193375 };
+  double dec[count] = { 0.0, 45.0, -60.0, -6.719891667 };
+  double alt[count], az[count];
+
+  palomar.get_hrz_from_equ_sidereal_time( ra, dec, count, 8.5823, 
+                                          alt, az );
+
+  for( size_t i = 0; i < count; i++ ) {
+    object.ra = ra[i];
+    object.dec = dec[i];
+    palomar.get_hrz_from_equ_sidereal_time( &object, 8.5823, &hrz );
+
+    failed += GEN_TEST_RESULT( "(Observer) Batch Equ to Horiz ALT ", 
+                               alt[i], hrz.alt, 0.00000001 );
+    failed += GEN_TEST_RESULT( "(Observer) Batch Equ to Horiz AZ ", 
+                               az[i], hrz.az, 0.00000001 );
+  }
+
+  // Tracking against one transform per Julian day: a night in one 
+  // minute steps, backwards over a year, and the celestial pole. Each 
+  // transform rounds its Julian Day to ~5e-10 days, ~2e-7 deg of 
+  // hour angle.
+  const size_t steps = 1000;
+
+  double track_alt[steps], track_az[steps];
+
+  double JD[] = { 2446896.30625, 2451545.0, 2451545.0 };
+  double step[] = { 1.0 / 1440.0, -0.37, 0.01 };
+  double track_dec[] = { -6.719891667, 45.0, 90.0 };
+
+  for( int t = 0; t < 3; t++ ) {
+    double alt_error = 0.0, az_error = 0.0;
+
+    object.ra = 347.3193375;
+    object.dec = track_dec[t];
+
+    palomar.get_hrz_track( &object, JD[t], step[t], steps, 
+                           track_alt, track_az );
+
+    for( size_t i = 0; i < steps; i++ ) {
+      palomar.get_hrz_from_equ( &object, JD[t] + i * step[t], &hrz );
+
+      alt_error = std::max( alt_error, std::fabs( track_alt[i] - hrz.alt ));
+      az_error = std::max( az_error, std::fabs( track_az[i] - hrz.az ));
+    }
+
+    failed += GEN_TEST_RESULT( "(Observer) Track ALT ", alt_error, 
+                               0.0, 0.000001 );
+    failed += GEN_TEST_RESULT( "(Observer) Track AZ ", az_error, 
+                               0.0, 0.000001 );
+  }
+
+  GEN_MSG( "End: Observer.\n" );
+
+  return failed;
+}
+
+int main( int argc, char* argv[] ) 
+{
+  int failed = 0;
+
+  failed += observer_test();
+
+  GEN_TEST_PRINT_RESULT( "observer", failed );
+
+  return( failed > 0 );
+}
@@ -15,6 +15,7 @@
  */
 
 #include <sidereus/parallax.hxx>
+#include <sidereus/observer.hxx>
 #include <sidereus/julian_day.hxx>
 
 #include <genesis/logger.hxx>
@@ -77,6 +78,54 @@ static int parallax_test( void )
 
   /////////////
 
+  // Batch parallax against the single object one.
+  const size_t count = 4;
+
+  genesis::proto_geo::point_equ_posn object, parallax;
+
+  double dec[count] = { 22.5, -14.0, 60.0, -75.0 };
+  double distance[count] = { 0.37, 0.00257, 1.5, 0.6 };
+  double H[count] = { -3.2, 0.0, 1.5, 11.0 };
+  double ra_parallax[count], dec_parallax[count];
+
+  sidereus::parallax::get_ha( dec, distance, H, count, &observer, 1706,
+                              ra_parallax, dec_parallax );
+
+  for( size_t i = 0; i < count; i++ ) {
+    object.ra = 0.0;
+    object.dec = dec[i];
+    sidereus::parallax::get_ha( &object, distance[i], &observer, 1706, 
+                                H[i], &parallax );
+
+    failed += GEN_TEST_RESULT( "(Parallax) Batch RA parallax", 
+                               ra_parallax[i], parallax.ra, 0.00000001 );
+    failed += GEN_TEST_RESULT( "(Parallax) Batch DEC parallax", 
+                               dec_parallax[i], parallax.dec, 0.00000001 );
+  }
+
+  // Hour angles from a sidereal time, against the given hour angles.
+  sidereus::observer site( &observer, 1706 );
+
+  double ra[count];
+
+  for( size_t i = 0; i < count; i++ ) {
+    ra[i] = 8.5823 * 15.0 + observer.lon - H[i] * 15.0;
+  }
+
+  site.get_parallax_sidereal_time( ra, dec, distance, count, 8.5823,
+                                   ra_parallax, dec_parallax );
+
+  for( size_t i = 0; i < count; i++ ) {
+    object.ra = 0.0;
+    object.dec = dec[i];
+    site.get_parallax_ha( &object, distance[i], H[i], &parallax );
+
+    failed += GEN_TEST_RESULT( "(Parallax) Sidereal time RA parallax", 
+                               ra_parallax[i], parallax.ra, 0.00000001 );
+    failed += GEN_TEST_RESULT( "(Parallax) Sidereal time DEC parallax", 
+                               dec_parallax[i], parallax.dec, 0.00000001 );
+  }
+
   GEN_MSG( "End: Parallax.\n" );
 
   return failed;
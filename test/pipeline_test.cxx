@@ -0,0 +1,133 @@
+/**
+ * @file
+ *
+ * Tests for an pipeline class.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * @mainteiner: ederbsd@gmail.com
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/pipeline.hxx>
+
+#include <genesis/logger.hxx>
+#include <genesis/tests.hxx>
+
+#include <cmath>
+#include <vector>
+
+// Test for class Pipeline.
+static int pipeline_test( void )
+{
+  GEN_MSG( "Tests for class Pipeline.\n" );
+
+  // Not a multiple of the chunk size, so the last chunk is partial.
+  const size_t count = 37 * PIPELINE_CHUNK + 123;
+
+  double JD = 2446895.5;
+
+  genesis::proto_geo::point_lon_lat_posn position;
+
+  std::vector< double > ra( count ), dec( count ), distance( count ),
+                        alt( count ), az( count ), pra( count ),
+                        pdec( count ), H( count );
+
+  // Set for tests.
+  int failed = 0;
+
+  position.lon = -116.8630;
+  position.lat = 33.3561;
+
+  sidereus::observer palomar( &position, 1706 );
+  sidereus::epoch frame( JD );
+
+  for( size_t i = 0; i < count; i++ ) {
+    ra[i] = std::fmod( i * 137.508, 360.0 );
+    dec[i] = std::fmod( i * 17.3, 170.0 ) - 85.0;
+    distance[i] = 0.002 + 0.001 * ( i % 50 );
+  }
+
+  // Serial results.
+  palomar.get_hrz_from_equ( &ra[0], &dec[0], count, &frame, 
+                            &alt[0], &az[0] );
+
+  // One thread, several threads and more threads than chunks.
+  unsigned threads[] = { 1, 3, 8, 64 };
+
+  for( size_t t = 0; t < sizeof( threads ) / sizeof( threads[0] ); t++ ) {
+    sidereus::pipeline P( threads[t] );
+
+    std::vector< double > a( ra ), d( dec );
+
+    double error = 0.0;
+
+    failed += GEN_TEST_RESULT( "(Pipeline) threads", P.get_threads(), 
+                               threads[t], 0 );
+
+    P.run( &palomar, &frame, &a[0], &d[0], count );
+
+    for( size_t i = 0; i < count; i++ ) {
+      error = std::max( error, std::fabs( a[i] - az[i] ));
+      error = std::max( error, std::fabs( d[i] - alt[i] ));
+    }
+
+    failed += GEN_TEST_RESULT( "(Pipeline) Equ to Horiz in place", 
+                               error, 0.0, 0 );
+  }
+
+  // Parallax first, as observer::get_parallax().
+  for( size_t i = 0; i < count; i++ ) {
+    H[i] = frame.get_apparent_sidereal() + ( position.lon - ra[i] ) / 15.0;
+  }
+
+  palomar.get_parallax_ha( &dec[0], &distance[0], &H[0], count, 
+                           &pra[0], &pdec[0] );
+
+  for( size_t i = 0; i < count; i++ ) {
+    pra[i] += ra[i];
+    pdec[i] += dec[i];
+  }
+
+  palomar.get_hrz_from_equ( &pra[0], &pdec[0], count, &frame, 
+                            &alt[0], &az[0] );
+
+  sidereus::pipeline P( 4 );
+
+  // Runs can repeat on the same threads.
+  for( int run = 0; run < 3; run++ ) {
+    std::vector< double > a( ra ), d( dec );
+
+    double error = 0.0;
+
+    P.run( &palomar, &frame, &a[0], &d[0], count, &distance[0] );
+
+    for( size_t i = 0; i < count; i++ ) {
+      error = std::max( error, std::fabs( a[i] - az[i] ));
+      error = std::max( error, std::fabs( d[i] - alt[i] ));
+    }
+
+    failed += GEN_TEST_RESULT( "(Pipeline) Parallax and Horiz", 
+                               error, 0.0, 0 );
+  }
+
+  GEN_MSG( "End: Pipeline.\n" );
+
+  return failed;
+}
+
+int main( int argc, char* argv[] ) 
+{
+  int failed = 0;
+
+  failed += pipeline_test();
+
+  GEN_TEST_PRINT_RESULT( "pipeline", failed );
+
+  return( failed > 0 );
+}
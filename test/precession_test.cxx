@@ -0,0 +1,103 @@
+/**
+ * @file
+ *
+ * Tests for an precession class.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * @mainteiner: ederbsd@gmail.com
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/precession.hxx>
+
+#include <genesis/logger.hxx>
+#include <genesis/tests.hxx>
+
+// Test for class Precession.
+static int precession_test( void )
+{
+  GEN_MSG( "Tests for class Precession.\n" );
+
+  genesis::proto_geo::point_equ_posn object, position;
+
+  // Set for tests.
+  int failed = 0;
+
+  // Theta Persei, J2000 to 2028 Nov 13.19 TD (example 21.b).
+  object.ra = 41.054063;
+  object.dec = 49.227750;
+  sidereus::precession::get_equ_prec2( &object, 2451545.0, 2462088.69, 
+                                       &position );
+  failed += GEN_TEST_RESULT( "(Precession) Equ Prec RA ", position.ra, 
+                             41.547214, 0.000001 );
+  failed += GEN_TEST_RESULT( "(Precession) Equ Prec DEC ", position.dec, 
+                             49.348483, 0.000001 );
+
+  // Back to J2000.
+  sidereus::precession::get_equ_prec2( &position, 2462088.69, 2451545.0, 
+                                       &position );
+  failed += GEN_TEST_RESULT( "(Precession) Equ Prec back RA ", position.ra, 
+                             object.ra, 0.00000001 );
+  failed += GEN_TEST_RESULT( "(Precession) Equ Prec back DEC ", position.dec, 
+                             object.dec, 0.00000001 );
+
+  // Cached pairs give the same matrix as a fresh one, also after 
+  // other pairs have pushed them out.
+  sidereus::precession P;
+  sidereus::rotation fresh;
+
+  for( int i = 0; i < 3 * PRECESSION_CACHE_SIZE; i++ ) {
+    double toJD = 2451545.0 + 1000.0 * ( i % ( PRECESSION_CACHE_SIZE + 2 ) );
+
+    sidereus::precession::get_matrix( 2433282.4235, toJD, &fresh );
+    sidereus::rotation cached = P.get( 2433282.4235, toJD );
+
+    for( int j = 0; j < 3; j++ ) {
+      for( int k = 0; k < 3; k++ ) {
+        failed += GEN_TEST_RESULT( "(Precession) Cached matrix", 
+                                   cached.m[j][k], fresh.m[j][k], 0.0 );
+      }
+    }
+  }
+
+  // Arrays against single objects.
+  const size_t count = 5;
+
+  double ra[count] = { 0.0, 41.054063, 180.0, 266.4, 359.9 };
+  double dec[count] = { 0.0, 49.227750, 89.9, -28.9, -89.5 };
+  double out_ra[count], out_dec[count];
+
+  P.apply( ra, dec, count, 2451545.0, 2462088.69, out_ra, out_dec );
+
+  for( size_t i = 0; i < count; i++ ) {
+    object.ra = ra[i];
+    object.dec = dec[i];
+    P.apply( &object, 2451545.0, 2462088.69, &position );
+
+    failed += GEN_TEST_RESULT( "(Precession) Batch RA ", out_ra[i], 
+                               position.ra, 0.0000000001 );
+    failed += GEN_TEST_RESULT( "(Precession) Batch DEC ", out_dec[i], 
+                               position.dec, 0.0000000001 );
+  }
+
+  GEN_MSG( "End: Precession.\n" );
+
+  return failed;
+}
+
+int main( int argc, char* argv[] ) 
+{
+  int failed = 0;
+
+  failed += precession_test();
+
+  GEN_TEST_PRINT_RESULT( "precession", failed );
+
+  return( failed > 0 );
+}
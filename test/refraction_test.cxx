@@ -0,0 +1,171 @@
+/**
+ * @file
+ *
+ * Tests for an refraction class.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * @mainteiner: ederbsd@gmail.com
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/refraction.hxx>
+#include <sidereus/observer.hxx>
+
+#include <genesis/logger.hxx>
+#include <genesis/tests.hxx>
+
+#include <algorithm>
+#include <cmath>
+
+// Test for class Refraction.
+static int refraction_test( void )
+{
+  GEN_MSG( "Tests for class Refraction.\n" );
+
+  const size_t count = 6;
+
+  double ra[count] = { 10.0, 95.5, 170.2, 233.3, 301.1, 355.0 };
+  double dec[count] = { 5.0, -20.0, 45.0, 80.0, -60.0, 20.0 };
+  double alt[count], az[count], apparent[count], apparent_az[count],
+         out_ra[count], out_dec[count];
+
+  genesis::proto_geo::point_lon_lat_posn position;
+  genesis::proto_geo::point_equ_posn object, equ;
+  genesis::proto_geo::point_hrz_posn hrz, refracted;
+
+  double error = 0.0;
+
+  // Set for tests.
+  int failed = 0;
+
+  // Example 16.a, apparent altitude 0.5 deg.
+  failed += GEN_TEST_RESULT( "(Refraction) Bennett 16.a", 
+                             sidereus::refraction::get_bennett( 0.5 ) * 60.0, 
+                             28.754, 0.002 );
+  failed += GEN_TEST_RESULT( "(Refraction) Bennett zenith", 
+                             sidereus::refraction::get_bennett( 90.0 ), 
+                             0.0, 1e-9 );
+  failed += GEN_TEST_RESULT( "(Refraction) Saemundsson zenith", 
+                             sidereus::refraction::get_saemundsson( 90.0 ), 
+                             0.0, 1e-9 );
+  failed += GEN_TEST_RESULT( "(Refraction) Pressure and temperature", 
+                             sidereus::refraction::get_bennett( 10.0, 
+                              1010.0 * 0.8, 283.0 / 0.9 - 273.0 ), 
+                             sidereus::refraction::get_bennett( 10.0 ) * 
+                             0.72, 1e-12 );
+
+  sidereus::refraction air( 990.0, -5.0 );
+
+  failed += GEN_TEST_RESULT( "(Refraction) Pressure", air.get_pressure(), 
+                             990.0, 0 );
+  failed += GEN_TEST_RESULT( "(Refraction) Temperature", 
+                             air.get_temperature(), -5.0, 0 );
+
+  // Tables against the formulas, above the lowest altitude.
+  for( double h = REFRACTION_MIN_ALTITUDE; h <= 90.0; h += 0.0137 ) {
+    error = std::max( error, std::fabs( air.get_apparent( h ) - h - 
+             sidereus::refraction::get_saemundsson( h, 990.0, -5.0 )));
+    error = std::max( error, std::fabs( h - air.get_true( h ) - 
+             sidereus::refraction::get_bennett( h, 990.0, -5.0 )));
+  }
+
+  failed += GEN_TEST_RESULT( "(Refraction) Tables (arcsec)", 
+                             error * 3600.0, 0.0, 0.15 );
+
+  // The formulas agree within 4 arcsec above the horizon in the 
+  // standard atmosphere.
+  sidereus::refraction standard;
+
+  error = 0.0;
+
+  for( double h = 0.0; h <= 90.0; h += 0.0137 ) {
+    error = std::max( error, std::fabs( standard.get_true( 
+             standard.get_apparent( h )) - h ));
+  }
+
+  failed += GEN_TEST_RESULT( "(Refraction) Round trip (arcsec)", 
+                             error * 3600.0, 0.0, 4.0 );
+
+  // Faded out below the horizon.
+  failed += GEN_TEST_RESULT( "(Refraction) Below the fade", 
+                             air.get_apparent( -30.0 ), -30.0, 0 );
+  failed += GEN_TEST_RESULT( "(Refraction) Below the fade", 
+                             air.get_true( -30.0 ), -30.0, 0 );
+  failed += GEN_TEST_RESULT( "(Refraction) Fade is continuous", 
+                             air.get_apparent( REFRACTION_MIN_ALTITUDE - 
+                                               1e-9 ),
+                             REFRACTION_MIN_ALTITUDE + 
+                             sidereus::refraction::get_saemundsson( 
+                              REFRACTION_MIN_ALTITUDE, 990.0, -5.0 ), 
+                             1e-6 );
+
+  // Observer working in apparent altitudes.
+  position.lon = -77.065556;
+  position.lat = 38.921389;
+
+  sidereus::observer geometric( &position );
+  sidereus::observer site( &position, 0.0, &air );
+
+  failed += GEN_TEST_RESULT( "(Refraction) Observer table", 
+                             site.get_refraction() == &air, true, 0 );
+
+  geometric.get_hrz_from_equ_sidereal_time( ra, dec, count, 8.5, alt, az );
+  site.get_hrz_from_equ_sidereal_time( ra, dec, count, 8.5, apparent, 
+                                       apparent_az );
+  site.get_equ_from_hrz_sidereal_time( apparent, apparent_az, count, 8.5, 
+                                       out_ra, out_dec );
+
+  for( size_t i = 0; i < count; i++ ) {
+    object.ra = ra[i];
+    object.dec = dec[i];
+
+    site.get_hrz_from_equ_sidereal_time( &object, 8.5, &refracted );
+    site.get_equ_from_hrz_sidereal_time( &refracted, 8.5, &equ );
+
+    failed += GEN_TEST_RESULT( "(Refraction) Observer alt", apparent[i], 
+                               air.get_apparent( alt[i] ), 1e-12 );
+    failed += GEN_TEST_RESULT( "(Refraction) Observer az", apparent_az[i], 
+                               az[i], 0 );
+    failed += GEN_TEST_RESULT( "(Refraction) Observer scalar alt", 
+                               refracted.alt, apparent[i], 1e-10 );
+
+    // Back to the catalog within the disagreement of the formulas.
+    failed += GEN_TEST_RESULT( "(Refraction) Observer round trip ra", 
+                               out_ra[i], ra[i], 0.005 );
+    failed += GEN_TEST_RESULT( "(Refraction) Observer round trip dec", 
+                               out_dec[i], dec[i], 0.002 );
+    failed += GEN_TEST_RESULT( "(Refraction) Observer scalar ra", 
+                               equ.ra, out_ra[i], 1e-9 );
+    failed += GEN_TEST_RESULT( "(Refraction) Observer scalar dec", 
+                               equ.dec, out_dec[i], 1e-9 );
+  }
+
+  // Without a table the altitudes stay true.
+  object.ra = ra[0];
+  object.dec = dec[0];
+  geometric.get_hrz_from_equ_sidereal_time( &object, 8.5, &hrz );
+
+  failed += GEN_TEST_RESULT( "(Refraction) Geometric alt", hrz.alt, 
+                             alt[0], 1e-10 );
+
+  GEN_MSG( "End: Refraction.\n" );
+
+  return failed;
+}
+
+int main( int argc, char* argv[] ) 
+{
+  int failed = 0;
+
+  failed += refraction_test();
+
+  GEN_TEST_PRINT_RESULT( "refraction", failed );
+
+  return( failed > 0 );
+}
@@ -0,0 +1,152 @@
+/**
+ * @file
+ *
+ * Tests for an rise_set class.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * @mainteiner: ederbsd@gmail.com
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/rise_set.hxx>
+#include <sidereus/sidereal_time.hxx>
+#include <sidereus/transform_coord.hxx>
+
+#include <genesis/logger.hxx>
+#include <genesis/tests.hxx>
+
+#include <cmath>
+
+// Test for class Rise Set.
+static int rise_set_test( void )
+{
+  GEN_MSG( "Tests for class Rise Set.\n" );
+
+  genesis::proto_geo::point_lon_lat_posn position;
+  genesis::proto_geo::point_equ_posn before, object, after;
+  genesis::proto_geo::point_hrz_posn hrz;
+
+  sidereus::rise_set::rst time;
+  sidereus::transform_coord T;
+
+  double JD = 2447240.5;
+
+  // Set for tests.
+  int failed = 0;
+
+  // Venus at Boston, 1988 March 20 (example 15.a).
+  position.lon = -71.0833;
+  position.lat = 42.3333;
+
+  before.ra = 40.68021;
+  before.dec = 18.04761;
+  object.ra = 41.73129;
+  object.dec = 18.44092;
+  after.ra = 42.78204;
+  after.dec = 18.82742;
+
+  sidereus::observer boston( &position );
+
+  failed += GEN_TEST_RESULT( "(Rise Set) Venus status", 
+                             sidereus::rise_set::get( &before, &object, 
+                              &after, &boston, JD + 0.3, RISE_SET_STAR, 
+                              &time ), 0, 0 );
+  failed += GEN_TEST_RESULT( "(Rise Set) Venus rise", time.rise, 
+                             JD + 0.51766, 0.0001 );
+  failed += GEN_TEST_RESULT( "(Rise Set) Venus transit", time.transit, 
+                             JD + 0.81980, 0.0001 );
+  failed += GEN_TEST_RESULT( "(Rise Set) Venus set", time.set, 
+                             JD + 0.12130, 0.0001 );
+
+  // Fixed object: hour angle zero at transit, at the horizon when 
+  // rising and setting. Transit is due south, azimuth 0 (or 360).
+  object.ra = 116.328942;
+  object.dec = 28.026183;
+
+  sidereus::rise_set::get( &object, &boston, JD, RISE_SET_STAR, &time );
+
+  T.get_hrz_from_equ_sidereal_time( &object, &position, 
+   sidereus::sidereal_time::get_apparent( time.rise ), &hrz );
+  failed += GEN_TEST_RESULT( "(Rise Set) altitude at rise", hrz.alt, 
+                             RISE_SET_STAR, 0.00001 );
+
+  T.get_hrz_from_equ_sidereal_time( &object, &position, 
+   sidereus::sidereal_time::get_apparent( time.set ), &hrz );
+  failed += GEN_TEST_RESULT( "(Rise Set) altitude at set", hrz.alt, 
+                             RISE_SET_STAR, 0.00001 );
+
+  T.get_hrz_from_equ_sidereal_time( &object, &position, 
+   sidereus::sidereal_time::get_apparent( time.transit ), &hrz );
+  failed += GEN_TEST_RESULT( "(Rise Set) azimuth at transit", 
+                             std::fabs( hrz.az - 180.0 ), 180.0, 0.00001 );
+
+  // Circumpolar and never rising from Boston, and a list.
+  const size_t count = 3;
+
+  double ra[count] = { 116.328942, 37.95, 95.99 };
+  double dec[count] = { 28.026183, 89.26, -52.70 };
+  double rise[count], transit[count], set[count];
+
+  int status[count];
+
+  sidereus::rise_set::get( ra, dec, count, &boston, JD, RISE_SET_STAR, 
+                           rise, transit, set, status );
+
+  // The sidereal times above left nutation of a nearby day in the 
+  // cache, within its tolerance.
+  failed += GEN_TEST_RESULT( "(Rise Set) batch rise", rise[0], 
+                             time.rise, 1e-8 );
+  failed += GEN_TEST_RESULT( "(Rise Set) batch set", set[0], time.set, 
+                             1e-8 );
+  failed += GEN_TEST_RESULT( "(Rise Set) Polaris circumpolar", status[1], 
+                             1, 0 );
+  failed += GEN_TEST_RESULT( "(Rise Set) Canopus never rises", status[2], 
+                             -1, 0 );
+  failed += GEN_TEST_RESULT( "(Rise Set) Canopus transit", 
+                             transit[2] >= JD && transit[2] < JD + 1.0, 
+                             true, 0 );
+
+  // At the North Pole an object on the equator stays on the horizon,
+  // above it or below it, whatever the hour angle.
+  position.lon = 0.0;
+  position.lat = 90.0;
+
+  sidereus::observer pole( &position );
+
+  object.ra = 10.0;
+  object.dec = 0.0;
+
+  failed += GEN_TEST_RESULT( "(Rise Set) pole, on the horizon", 
+                             sidereus::rise_set::get( &object, &pole, JD, 
+                              0.0, &time ), 1, 0 );
+  failed += GEN_TEST_RESULT( "(Rise Set) pole, below the horizon", 
+                             sidereus::rise_set::get( &object, &pole, JD, 
+                              RISE_SET_MOON, &time ), -1, 0 );
+  failed += GEN_TEST_RESULT( "(Rise Set) pole, above the horizon", 
+                             sidereus::rise_set::get( &object, &pole, JD, 
+                              RISE_SET_STAR, &time ), 1, 0 );
+  failed += GEN_TEST_RESULT( "(Rise Set) pole transit", 
+                             time.transit >= JD && time.transit < JD + 1.0, 
+                             true, 0 );
+
+  GEN_MSG( "End: Rise Set.\n" );
+
+  return failed;
+}
+
+int main( int argc, char* argv[] ) 
+{
+  int failed = 0;
+
+  failed += rise_set_test();
+
+  GEN_TEST_PRINT_RESULT( "rise_set", failed );
+
+  return( failed > 0 );
+}
@@ -0,0 +1,105 @@
+/**
+ * @file
+ *
+ * Tests for an rotation class.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * @mainteiner: ederbsd@gmail.com
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/rotation.hxx>
+
+#include <genesis/logger.hxx>
+#include <genesis/tests.hxx>
+
+// Test for class Rotation.
+static int rotation_test( void )
+{
+  GEN_MSG( "Tests for class Rotation.\n" );
+
+  genesis::proto_geo::point_rect_coord v;
+
+  double lon = 0.0, lat = 0.0;
+
+  // Set for tests.
+  int failed = 0;
+
+  // Rotating the frame by +90 deg around z moves x onto -y.
+  sidereus::rotation R = sidereus::rotation::rotate_z( 90.0 );
+
+  v.x = 1.0;
+  v.y = 0.0;
+  v.z = 0.0;
+  R.apply( &v, &v );
+  failed += GEN_TEST_RESULT( "(Rotation) z( 90 ) x", v.x, 0.0, 1e-15 );
+  failed += GEN_TEST_RESULT( "(Rotation) z( 90 ) y", v.y, -1.0, 1e-15 );
+
+  // The transpose undoes the rotation.
+  sidereus::rotation Q = sidereus::rotation::rotate_x( 23.4 ) * 
+                         sidereus::rotation::rotate_y( -41.0 ) * R;
+  sidereus::rotation I = Q.transpose() * Q;
+
+  for( int i = 0; i < 3; i++ ) {
+    for( int j = 0; j < 3; j++ ) {
+      failed += GEN_TEST_RESULT( "(Rotation) transpose * rotation", 
+                                 I.m[i][j], i == j ? 1.0 : 0.0, 1e-15 );
+    }
+  }
+
+  // Spherical round trip.
+  sidereus::rotation::get_rect( 123.456, -54.321, &v );
+  sidereus::rotation::get_spherical( &v, &lon, &lat );
+  failed += GEN_TEST_RESULT( "(Rotation) rect to spherical lon", 
+                             lon, 123.456, 1e-12 );
+  failed += GEN_TEST_RESULT( "(Rotation) rect to spherical lat", 
+                             lat, -54.321, 1e-12 );
+
+  // Rotation of arrays against rotation of single vectors.
+  const size_t count = 5;
+
+  double lons[count] = { 0.0, 45.0, 181.0, 270.5, 359.9 };
+  double lats[count] = { 0.0, 89.9, -30.0, 12.5, -89.0 };
+  double out_lon[count], out_lat[count];
+
+  Q.apply( lons, lats, count, out_lon, out_lat );
+
+  for( size_t i = 0; i < count; i++ ) {
+    sidereus::rotation::get_rect( lons[i], lats[i], &v );
+    Q.apply( &v, &v );
+    sidereus::rotation::get_spherical( &v, &lon, &lat );
+
+    failed += GEN_TEST_RESULT( "(Rotation) Batch lon", out_lon[i], 
+                               lon, 1e-10 );
+    failed += GEN_TEST_RESULT( "(Rotation) Batch lat", out_lat[i], 
+                               lat, 1e-10 );
+  }
+
+  // Just below zero wraps to 0, not to 360.
+  double tiny = -1e-15;
+
+  sidereus::rotation().apply( &tiny, lats, 1, out_lon, out_lat );
+  failed += GEN_TEST_RESULT( "(Rotation) Batch lon below zero", 
+                             out_lon[0] < 360.0, 1, 0 );
+
+  GEN_MSG( "End: Rotation.\n" );
+
+  return failed;
+}
+
+int main( int argc, char* argv[] ) 
+{
+  int failed = 0;
+
+  failed += rotation_test();
+
+  GEN_TEST_PRINT_RESULT( "rotation", failed );
+
+  return( failed > 0 );
+}
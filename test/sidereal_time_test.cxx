@@ -48,7 +48,7 @@ static int sidereal_time_test( void )
 
   sd = sidereus::sidereal_time::get_apparent( JD );
   failed += GEN_TEST_RESULT( "(Sidereal) apparent hours on 10/04/1987 19:21:00 "
-                             , sd, 8.58252060, 0.000001 );
+                             , sd, 8.5824592, 0.000001 );
 
   GEN_MSG( "End: Sidereal Time.\n" );
 
@@ -0,0 +1,115 @@
+/**
+ * @file
+ *
+ * Tests for an sky_catalog class.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * @mainteiner: ederbsd@gmail.com
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/sky_catalog.hxx>
+#include <sidereus/rotation.hxx>
+
+#include <genesis/logger.hxx>
+#include <genesis/tests.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+// Test for class Sky Catalog.
+static int sky_catalog_test( void )
+{
+  GEN_MSG( "Tests for class Sky Catalog.\n" );
+
+  const size_t count = 50000;
+
+  genesis::proto_geo::point_rect_coord center, v;
+
+  std::vector< double > ra( count ), dec( count ), distance;
+  std::vector< size_t > ids, expected;
+
+  // Set for tests.
+  int failed = 0;
+
+  srand( 2 );
+
+  for( size_t i = 0; i < count; i++ ) {
+    ra[i] = 360.0 * rand() / ( RAND_MAX + 1.0 );
+    dec[i] = GEN_GEOMETRY_RADTODEG( std::asin( 2.0 * rand() / RAND_MAX - 
+                                               1.0 ));
+  }
+
+  sidereus::sky_catalog catalog;
+
+  catalog.build( &ra[0], &dec[0], count );
+
+  failed += GEN_TEST_RESULT( "(Sky Catalog) count", catalog.get_count(), 
+                             count, 0 );
+
+  // Cones against the angular distance of every object: small, around 
+  // a pole, across ra 0, a hemisphere and the whole sky.
+  double cone_ra[] = { 83.8, 10.0, 359.9, 200.0, 0.0, 120.0 };
+  double cone_dec[] = { -5.4, 89.5, 0.0, -30.0, 0.0, 45.0 };
+  double cone_radius[] = { 2.0, 3.0, 1.5, 90.0, 180.0, 0.0 };
+
+  for( int c = 0; c < 6; c++ ) {
+    double limit = std::cos( GEN_GEOMETRY_DEGTORAD( cone_radius[c] ));
+    double error = 0.0;
+
+    sidereus::rotation::get_rect( cone_ra[c], cone_dec[c], &center );
+
+    expected.clear();
+
+    for( size_t i = 0; i < count; i++ ) {
+      sidereus::rotation::get_rect( ra[i], dec[i], &v );
+
+      if( v.x * center.x + v.y * center.y + v.z * center.z >= limit ) {
+        expected.push_back( i );
+      }
+    }
+
+    catalog.get_cone( cone_ra[c], cone_dec[c], cone_radius[c], &ids, 
+                      &distance );
+
+    for( size_t i = 0; i < ids.size(); i++ ) {
+      sidereus::rotation::get_rect( ra[ids[i]], dec[ids[i]], &v );
+
+      error = std::max( error, std::fabs( distance[i] - 
+                GEN_GEOMETRY_RADTODEG( std::acos( std::min( 1.0, 
+                 v.x * center.x + v.y * center.y + v.z * center.z )))));
+    }
+
+    std::sort( ids.begin(), ids.end() );
+
+    failed += GEN_TEST_RESULT( "(Sky Catalog) cone count", ids.size(), 
+                               expected.size(), 0 );
+    failed += GEN_TEST_RESULT( "(Sky Catalog) cone objects", 
+                               ids == expected, true, 0 );
+    failed += GEN_TEST_RESULT( "(Sky Catalog) cone distances", error, 
+                               0.0, 0.0000001 );
+  }
+
+  GEN_MSG( "End: Sky Catalog.\n" );
+
+  return failed;
+}
+
+int main( int argc, char* argv[] ) 
+{
+  int failed = 0;
+
+  failed += sky_catalog_test();
+
+  GEN_TEST_PRINT_RESULT( "sky_catalog", failed );
+
+  return( failed > 0 );
+}
@@ -0,0 +1,149 @@
+/**
+ * @file
+ *
+ * Tests for an sky_index class.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * @mainteiner: ederbsd@gmail.com
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/sky_index.hxx>
+#include <sidereus/rotation.hxx>
+
+#include <genesis/logger.hxx>
+#include <genesis/tests.hxx>
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+// Test for class Sky Index.
+static int sky_index_test( void )
+{
+  GEN_MSG( "Tests for class Sky Index.\n" );
+
+  const size_t count = 20000;
+
+  genesis::proto_geo::point_lon_lat_posn position;
+  genesis::proto_geo::point_rect_coord center, v;
+
+  std::vector< double > ra( count ), dec( count ), alt( count ), 
+                        az( count );
+  std::vector< size_t > ids;
+  std::vector< double > index_alt, index_az;
+  std::vector< sidereus::sky_index::range > ranges;
+
+  // Set for tests.
+  int failed = 0;
+
+  // Uniform on the sphere, plus the poles and face edges.
+  srand( 1 );
+
+  for( size_t i = 0; i < count; i++ ) {
+    ra[i] = 360.0 * rand() / ( RAND_MAX + 1.0 );
+    dec[i] = GEN_GEOMETRY_RADTODEG( std::asin( 2.0 * rand() / RAND_MAX - 
+                                               1.0 ));
+  }
+
+  ra[0] = 0.0; dec[0] = 90.0;
+  ra[1] = 0.0; dec[1] = -90.0;
+  ra[2] = 45.0; dec[2] = 0.0;
+  ra[3] = 45.0; dec[3] = 35.2643896828;
+
+  // A cell number at one level less is its parent.
+  for( size_t i = 0; i < 100; i++ ) {
+    failed += GEN_TEST_RESULT( "(Sky Index) parent cell", 
+                  sidereus::sky_index::get_cell( ra[i], dec[i], 8 ) >> 2, 
+                  sidereus::sky_index::get_cell( ra[i], dec[i], 7 ), 0 );
+  }
+
+  sidereus::sky_index index;
+
+  index.build( &ra[0], &dec[0], count );
+
+  failed += GEN_TEST_RESULT( "(Sky Index) count", index.get_count(), 
+                             count, 0 );
+
+  // Visible objects are exactly those of a full transform above the 
+  // altitude.
+  position.lon = -116.8630;
+  position.lat = 33.3561;
+
+  sidereus::observer palomar( &position );
+
+  double altitude[] = { 0.0, 30.0, -10.0, 89.0 };
+
+  for( int t = 0; t < 4; t++ ) {
+    size_t above = 0;
+
+    double error = 0.0;
+
+    palomar.get_hrz_from_equ_sidereal_time( &ra[0], &dec[0], count, 
+                                            8.5823, &alt[0], &az[0] );
+    index.get_hrz( &palomar, 8.5823, altitude[t], &ids, &index_alt, 
+                   &index_az );
+
+    for( size_t i = 0; i < count; i++ ) {
+      above += alt[i] >= altitude[t];
+    }
+
+    for( size_t i = 0; i < ids.size(); i++ ) {
+      error = std::max( error, std::fabs( index_alt[i] - alt[ids[i]] ));
+      error = std::max( error, std::fabs( index_az[i] - az[ids[i]] ));
+    }
+
+    failed += GEN_TEST_RESULT( "(Sky Index) visible objects", ids.size(), 
+                               above, 0 );
+    failed += GEN_TEST_RESULT( "(Sky Index) visible positions", error, 
+                               0.0, 0.0000000001 );
+  }
+
+  // Every object of a cone is in the ranges, which cover little more.
+  index.get_ranges( 83.0, -5.0, 10.0, &ranges );
+  sidereus::rotation::get_rect( 83.0, -5.0, &center );
+
+  size_t inside = 0, found = 0, covered = 0;
+
+  for( size_t r = 0; r < ranges.size(); r++ ) {
+    covered += ranges[r].second - ranges[r].first;
+
+    for( size_t i = ranges[r].first; i < ranges[r].second; i++ ) {
+      sidereus::rotation::get_rect( index.get_ra()[i], index.get_dec()[i], 
+                                    &v );
+      found += v.x * center.x + v.y * center.y + v.z * center.z >= 
+               std::cos( GEN_GEOMETRY_DEGTORAD( 10.0 ));
+    }
+  }
+
+  for( size_t i = 0; i < count; i++ ) {
+    sidereus::rotation::get_rect( ra[i], dec[i], &v );
+    inside += v.x * center.x + v.y * center.y + v.z * center.z >= 
+              std::cos( GEN_GEOMETRY_DEGTORAD( 10.0 ));
+  }
+
+  failed += GEN_TEST_RESULT( "(Sky Index) cone objects", found, inside, 0 );
+  failed += GEN_TEST_RESULT( "(Sky Index) cone coverage", 
+                             covered < 2 * inside, true, 0 );
+
+  GEN_MSG( "End: Sky Index.\n" );
+
+  return failed;
+}
+
+int main( int argc, char* argv[] ) 
+{
+  int failed = 0;
+
+  failed += sky_index_test();
+
+  GEN_TEST_PRINT_RESULT( "sky_index", failed );
+
+  return( failed > 0 );
+}
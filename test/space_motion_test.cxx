@@ -0,0 +1,213 @@
+/**
+ * @file
+ *
+ * Tests for an space_motion class.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * @mainteiner: ederbsd@gmail.com
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/space_motion.hxx>
+#include <sidereus/frames.hxx>
+#include <sidereus/julian_day.hxx>
+
+#include <genesis/logger.hxx>
+#include <genesis/tests.hxx>
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+// Test for class Space Motion.
+static int space_motion_test( void )
+{
+  GEN_MSG( "Tests for class Space Motion.\n" );
+
+  const double MAS = GEN_GEOMETRY_DEGTORAD( 1.0 / 3600000.0 );
+  const size_t count = 40000;
+
+  // Barnard's star, fastest proper motion known.
+  double ra = 269.452075, dec = 4.693391, pmra = -801.551, 
+         pmdec = 10362.394, parallax = 548.31, rv = -110.51;
+
+  sidereus::astrometry_columns star = { &ra, &dec, &pmra, &pmdec, &parallax, &rv };
+
+  std::vector< double > c_ra( count ), c_dec( count ), c_pmra( count ), 
+                        c_pmdec( count ), c_parallax( count ), 
+                        c_rv( count );
+
+  // Set for tests.
+  int failed = 0;
+
+  // Straight line motion over a thousand years, in au and au/yr.
+  genesis::proto_geo::point_rect_coord r, b, v;
+
+  double a0 = GEN_GEOMETRY_DEGTORAD( ra ), d0 = GEN_GEOMETRY_DEGTORAD( dec );
+  double distance = 1.0 / ( parallax * MAS ), years = 1000.0;
+  double vr = rv / SPACE_MOTION_AU_KM_YEAR_S;
+
+  r.x = std::cos( d0 ) * std::cos( a0 );
+  r.y = std::cos( d0 ) * std::sin( a0 );
+  r.z = std::sin( d0 );
+
+  v.x = ( -std::sin( a0 ) * pmra - std::sin( d0 ) * std::cos( a0 ) * pmdec ) 
+        * MAS * distance + r.x * vr;
+  v.y = ( std::cos( a0 ) * pmra - std::sin( d0 ) * std::sin( a0 ) * pmdec ) 
+        * MAS * distance + r.y * vr;
+  v.z = std::cos( d0 ) * pmdec * MAS * distance + r.z * vr;
+
+  b.x = r.x * distance + v.x * years;
+  b.y = r.y * distance + v.y * years;
+  b.z = r.z * distance + v.z * years;
+
+  double length = std::sqrt( b.x * b.x + b.y * b.y + b.z * b.z );
+  double radial = ( b.x * v.x + b.y * v.y + b.z * v.z ) / length;
+  double a1 = std::atan2( b.y, b.x );
+  double d1 = std::asin( b.z / length );
+
+  // Proper motions from the tangential velocity at the new place.
+  double tangent_a = ( -std::sin( a1 ) * v.x + std::cos( a1 ) * v.y ) / 
+                     length / MAS;
+  double tangent_d = ( -std::sin( d1 ) * std::cos( a1 ) * v.x - 
+                       std::sin( d1 ) * std::sin( a1 ) * v.y + 
+                       std::cos( d1 ) * v.z ) / length / MAS;
+
+  sidereus::space_motion::propagate( &star, 1, JULIAN_DAY_JD2016, 
+                                     JULIAN_DAY_JD2016 + 365250.0 );
+
+  failed += GEN_TEST_RESULT( "(Space Motion) Barnard ra", ra, 
+                             GEN_GEOMETRY_RADTODEG( a1 ) + 360.0 * 
+                             ( a1 < 0.0 ), 1e-10 );
+  failed += GEN_TEST_RESULT( "(Space Motion) Barnard dec", dec, 
+                             GEN_GEOMETRY_RADTODEG( d1 ), 1e-10 );
+  failed += GEN_TEST_RESULT( "(Space Motion) Barnard pmra", pmra, 
+                             tangent_a, 1e-6 );
+  failed += GEN_TEST_RESULT( "(Space Motion) Barnard pmdec", pmdec, 
+                             tangent_d, 1e-6 );
+  failed += GEN_TEST_RESULT( "(Space Motion) Barnard parallax", parallax, 
+                             1.0 / ( length * MAS ), 1e-9 );
+  failed += GEN_TEST_RESULT( "(Space Motion) Barnard rv", rv, 
+                             radial * SPACE_MOTION_AU_KM_YEAR_S, 1e-9 );
+
+  // And back.
+  sidereus::space_motion::propagate( &star, 1, JULIAN_DAY_JD2016 + 
+                                     365250.0, JULIAN_DAY_JD2016 );
+
+  failed += GEN_TEST_RESULT( "(Space Motion) Back ra", ra, 269.452075, 
+                             1e-10 );
+  failed += GEN_TEST_RESULT( "(Space Motion) Back dec", dec, 4.693391, 
+                             1e-10 );
+  failed += GEN_TEST_RESULT( "(Space Motion) Back pmra", pmra, -801.551, 
+                             1e-6 );
+  failed += GEN_TEST_RESULT( "(Space Motion) Back pmdec", pmdec, 
+                             10362.394, 1e-6 );
+  failed += GEN_TEST_RESULT( "(Space Motion) Back parallax", parallax, 
+                             548.31, 1e-9 );
+  failed += GEN_TEST_RESULT( "(Space Motion) Back rv", rv, -110.51, 1e-9 );
+
+  // Threads and a frame rotation against one thread and the rotation 
+  // applied afterwards.
+  srand( 3 );
+
+  for( size_t i = 0; i < count; i++ ) {
+    c_ra[i] = 360.0 * rand() / ( RAND_MAX + 1.0 );
+    c_dec[i] = 180.0 * rand() / RAND_MAX - 90.0;
+    c_pmra[i] = 200.0 * rand() / RAND_MAX - 100.0;
+    c_pmdec[i] = 200.0 * rand() / RAND_MAX - 100.0;
+    c_parallax[i] = 10.0 * rand() / RAND_MAX - 1.0;
+    c_rv[i] = 100.0 * rand() / RAND_MAX - 50.0;
+  }
+
+  std::vector< double > s_ra( c_ra ), s_dec( c_dec ), s_pmra( c_pmra ), 
+                        s_pmdec( c_pmdec ), s_parallax( c_parallax ), 
+                        s_rv( c_rv );
+
+  sidereus::astrometry_columns single = { &s_ra[0], &s_dec[0], &s_pmra[0], 
+                                &s_pmdec[0], &s_parallax[0], &s_rv[0] };
+  sidereus::astrometry_columns many = { &c_ra[0], &c_dec[0], &c_pmra[0], 
+                              &c_pmdec[0], &c_parallax[0], &c_rv[0] };
+
+  double JD = 2461041.5;
+
+  sidereus::rotation P = sidereus::frames::get_precession( 
+                           JULIAN_DAY_JD2000, JD );
+
+  sidereus::space_motion::propagate( &single, count, JULIAN_DAY_JD2016, 
+                                     JD );
+  sidereus::space_motion::propagate( &many, count, JULIAN_DAY_JD2016, JD,
+                                     &P, 3 );
+
+  double error = 0.0, pm_error = 0.0, other_error = 0.0;
+
+  for( size_t i = 0; i < count; i++ ) {
+    genesis::proto_geo::point_rect_coord u;
+
+    double lon = 0.0, lat = 0.0;
+
+    sidereus::rotation::get_rect( s_ra[i], s_dec[i], &u );
+    P.apply( &u, &u );
+    sidereus::rotation::get_spherical( &u, &lon, &lat );
+
+    if( std::fabs( lat ) < 89.0 ) {
+      error = std::max( error, std::fabs( c_ra[i] - lon ));
+    }
+    error = std::max( error, std::fabs( c_dec[i] - lat ));
+
+    // Rotations keep the size of the proper motion.
+    pm_error = std::max( pm_error, std::fabs( 
+                 std::sqrt( c_pmra[i] * c_pmra[i] + 
+                            c_pmdec[i] * c_pmdec[i] ) - 
+                 std::sqrt( s_pmra[i] * s_pmra[i] + 
+                            s_pmdec[i] * s_pmdec[i] )));
+    other_error = std::max( other_error, 
+                   std::fabs( c_parallax[i] - s_parallax[i] ) + 
+                   std::fabs( c_rv[i] - s_rv[i] ));
+  }
+
+  failed += GEN_TEST_RESULT( "(Space Motion) Threads and frame position", 
+                             error, 0.0, 1e-9 );
+  failed += GEN_TEST_RESULT( "(Space Motion) Threads and frame motion", 
+                             pm_error, 0.0, 1e-9 );
+  failed += GEN_TEST_RESULT( "(Space Motion) Threads parallax and rv", 
+                             other_error, 0.0, 0 );
+
+  // Without parallax and radial velocity only the tangential motion.
+  ra = 10.0;
+  dec = 20.0;
+  pmra = 100.0;
+  pmdec = -50.0;
+  star.parallax = 0;
+  star.rv = 0;
+
+  sidereus::space_motion::propagate( &star, 1, JULIAN_DAY_JD2000, 
+                                     JULIAN_DAY_JD2000 + 3652.5 );
+
+  failed += GEN_TEST_RESULT( "(Space Motion) Tangential ra", ra, 
+                             10.0 + 1.0 / 3600.0 / 
+                             std::cos( GEN_GEOMETRY_DEGTORAD( 20.0 )), 
+                             1e-8 );
+  failed += GEN_TEST_RESULT( "(Space Motion) Tangential dec", dec, 
+                             20.0 - 0.5 / 3600.0, 1e-8 );
+
+  GEN_MSG( "End: Space Motion.\n" );
+
+  return failed;
+}
+
+int main( int argc, char* argv[] ) 
+{
+  int failed = 0;
+
+  failed += space_motion_test();
+
+  GEN_TEST_PRINT_RESULT( "space_motion", failed );
+
+  return( failed > 0 );
+}
@@ -0,0 +1,137 @@
+/**
+ * @file
+ *
+ * Tests for an transform_chain class.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * @mainteiner: ederbsd@gmail.com
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/transform_chain.hxx>
+#include <sidereus/precession.hxx>
+#include <sidereus/transform_coord.hxx>
+
+#include <genesis/logger.hxx>
+#include <genesis/tests.hxx>
+
+#include <cmath>
+
+// Test for class Transform Chain.
+static int transform_chain_test( void )
+{
+  GEN_MSG( "Tests for class Transform Chain.\n" );
+
+  using namespace sidereus;
+
+  typedef transform_chain< gal_to_equ1950,
+                           precess< equinox_b1950, equinox_j2000 > > 
+    gal_to_j2000;
+
+  typedef transform_chain< gal_to_equ1950,
+                           precess< equinox_b1950, equinox_date >,
+                           equ_to_hrz > gal_to_hrz;
+
+  typedef transform_chain< gal_to_equ2000,
+                           precess< equinox_j2000, equinox_date >,
+                           equ_to_ecl, ecl_to_equ, equ_to_hrz, 
+                           hrz_to_equ > gal_to_equ;
+
+  const size_t count = 7;
+
+  double lon[count] = { 0.0, 33.3, 121.2, 180.0, 266.4, 301.7, 359.9 };
+  double lat[count] = { 0.0, -12.5, 60.1, 89.5, -28.9, 45.0, -89.0 };
+  double out_lon[count], out_lat[count];
+
+  genesis::proto_geo::point_lon_lat_posn position;
+  genesis::proto_geo::point_gal_posn gal;
+  genesis::proto_geo::point_equ_posn equ, equ1950;
+  genesis::proto_geo::point_hrz_posn hrz;
+
+  double JD = 2448976.5;
+
+  // Set for tests.
+  int failed = 0;
+
+  position.lon = -77.065556;
+  position.lat = 38.921389;
+
+  observer site( &position );
+  epoch frame( JD );
+  transform_coord T;
+
+  failed += GEN_TEST_RESULT( "(Transform Chain) Constant chain", 
+                             gal_to_j2000::constant, true, 0 );
+  failed += GEN_TEST_RESULT( "(Transform Chain) Chain of date", 
+                             gal_to_hrz::constant, false, 0 );
+
+  // Fused constant chain against the J2000 galactic transform.
+  gal_to_j2000::apply( lon, lat, count, out_lon, out_lat );
+
+  for( size_t i = 0; i < count; i++ ) {
+    gal.lon = lon[i];
+    gal.lat = lat[i];
+
+    T.get_equ2000_from_gal( &gal, &equ );
+
+    if( std::fabs( equ.dec ) < 89.0 ) {
+      failed += GEN_TEST_RESULT( "(Transform Chain) J2000 ra", out_lon[i], 
+                                 equ.ra, 1e-8 );
+    }
+    failed += GEN_TEST_RESULT( "(Transform Chain) J2000 dec", out_lat[i], 
+                               equ.dec, 1e-8 );
+  }
+
+  // Galactic to horizontal against the transforms one by one.
+  gal_to_hrz::apply( lon, lat, count, out_lon, out_lat, &frame, &site );
+
+  for( size_t i = 0; i < count; i++ ) {
+    gal.lon = lon[i];
+    gal.lat = lat[i];
+
+    T.get_equ_from_gal( &gal, &equ1950 );
+    precession::get_equ_prec2( &equ1950, JULIAN_DAY_B1950, JD, &equ );
+    site.get_hrz_from_equ( &equ, &frame, &hrz );
+
+    if( std::fabs( hrz.alt ) < 89.0 ) {
+      failed += GEN_TEST_RESULT( "(Transform Chain) Horizontal az", 
+                                 out_lon[i], hrz.az, 1e-8 );
+    }
+    failed += GEN_TEST_RESULT( "(Transform Chain) Horizontal alt", 
+                               out_lat[i], hrz.alt, 1e-8 );
+  }
+
+  // Stages and their inverses cancel.
+  rotation M = gal_to_equ::get_matrix( &frame, &site );
+  rotation P = transform_chain< gal_to_equ2000, 
+                                precess< equinox_j2000, equinox_date > 
+                              >::get_matrix( &frame );
+
+  for( int i = 0; i < 3; i++ ) {
+    for( int j = 0; j < 3; j++ ) {
+      failed += GEN_TEST_RESULT( "(Transform Chain) Inverse stages", 
+                                 M.m[i][j], P.m[i][j], 1e-15 );
+    }
+  }
+
+  GEN_MSG( "End: Transform Chain.\n" );
+
+  return failed;
+}
+
+int main( int argc, char* argv[] ) 
+{
+  int failed = 0;
+
+  failed += transform_chain_test();
+
+  GEN_TEST_PRINT_RESULT( "transform_chain", failed );
+
+  return( failed > 0 );
+}
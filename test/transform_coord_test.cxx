@@ -16,10 +16,13 @@
 
 #include <sidereus/transform_coord.hxx>
 #include <sidereus/julian_day.hxx>
+#include <sidereus/epoch.hxx>
 
 #include <genesis/logger.hxx>
 #include <genesis/tests.hxx>
 
+#include <cmath>
+
 // Test for class Transformation Coord.
 static int transform_coord_test( void )
 {
@@ -136,16 +139,170 @@ static int transform_coord_test( void )
   failed += GEN_TEST_RESULT( "(Transforms) Ecl to Equ DEC", equ.dec, 
                              28.02618333, 0.00000001 );
 
+  // Galactic centre, B1950.
+  genesis::proto_geo::point_gal_posn gal;
+
+  equ.ra = 265.6;
+  equ.dec = -28.92;
+  T.get_gal_from_equ( &equ, &gal );
+  failed += GEN_TEST_RESULT( "(Transforms) Equ to Gal LON ", gal.lon, 
+                             359.99227911, 0.000001 );
+  failed += GEN_TEST_RESULT( "(Transforms) Equ to Gal LAT ", gal.lat, 
+                             0.00638635, 0.000001 );
+
+  T.get_equ_from_gal( &gal, &equ );
+  failed += GEN_TEST_RESULT( "(Transforms) Gal to Equ RA ", equ.ra, 
+                             265.6, 0.00000001 );
+  failed += GEN_TEST_RESULT( "(Transforms) Gal to Equ DEC ", equ.dec, 
+                             -28.92, 0.00000001 );
+
+  // Galactic north pole, J2000.
+  gal.lon = 0.0;
+  gal.lat = 90.0;
+  T.get_equ2000_from_gal( &gal, &equ );
+  failed += GEN_TEST_RESULT( "(Transforms) Gal to Equ2000 RA ", equ.ra, 
+                             192.85933573, 0.000001 );
+  failed += GEN_TEST_RESULT( "(Transforms) Gal to Equ2000 DEC ", equ.dec, 
+                             27.12825103, 0.000001 );
+
+  T.get_gal_from_equ2000( &equ, &gal );
+  failed += GEN_TEST_RESULT( "(Transforms) Equ2000 to Gal LAT ", gal.lat, 
+                             90.0, 0.00000001 );
+
   GEN_MSG( "End: Tranformation Coord.\n" );
 
   return failed;
 }
 
+// Test for batch transforms of class Transformation Coord.
+static int transform_coord_batch_test( void )
+{
+  GEN_MSG( "Tests for batch Transform Coord.\n" );
+
+  genesis::proto_geo::point_equ_posn object;
+  genesis::proto_geo::point_hrz_posn hrz;
+  genesis::proto_geo::point_lon_lat_posn observer;
+
+  const size_t count = 6;
+  double ra[count] = { 347.3193375, 116.32894167, 0.0, 200.5, 83.0, 10.0 };
+  double dec[count] = { -6.71989167, 28.02618333, 90.0, -90.0, -1.2, 45.0 };
+  double alt[count], az[count];
+
+  double JD = 2446896.30625;
+
+  // Set for tests.      
+  int failed = 0;
+
+  observer.lon = 282.93444444;
+  observer.lat = 38.92138889;
+
+  sidereus::transform_coord T;
+
+  T.get_hrz_from_equ( ra, dec, count, &observer, JD, alt, az );
+
+  for( size_t i = 0; i < count; i++ ) {
+    object.ra = ra[i];
+    object.dec = dec[i];
+    T.get_hrz_from_equ( &object, &observer, JD, &hrz );
+
+    failed += GEN_TEST_RESULT( "(Transforms) Batch Equ to Horiz ALT ", 
+                               alt[i], hrz.alt, 0.00000001 );
+    failed += GEN_TEST_RESULT( "(Transforms) Batch Equ to Horiz AZ ", 
+                               az[i], hrz.az, 0.00000001 );
+  }
+
+  genesis::proto_geo::point_equ_posn equ;
+  genesis::proto_geo::point_gal_posn gal;
+
+  double ra2[count], dec2[count], lon[count], lat[count];
+
+  // Back to equatorial, away from the poles.
+  T.get_equ_from_hrz( alt, az, count, &observer, JD, ra2, dec2 );
+
+  for( size_t i = 0; i < count; i++ ) {
+    hrz.alt = alt[i];
+    hrz.az = az[i];
+    T.get_equ_from_hrz( &hrz, &observer, JD, &equ );
+
+    // Right ascension is undefined at the celestial poles.
+    if( std::fabs( dec[i] ) < 90.0 ) {
+      failed += GEN_TEST_RESULT( "(Transforms) Batch Horiz to Equ RA ", 
+                                 ra2[i], equ.ra, 0.00000001 );
+      failed += GEN_TEST_RESULT( "(Transforms) Batch Horiz to Equ DEC ", 
+                                 dec2[i], equ.dec, 0.00000001 );
+    }
+  }
+
+  T.get_gal_from_equ( ra, dec, count, lon, lat );
+
+  for( size_t i = 0; i < count; i++ ) {
+    object.ra = ra[i];
+    object.dec = dec[i];
+    T.get_gal_from_equ( &object, &gal );
+
+    if( std::fabs( dec[i] ) < 90.0 ) {
+      failed += GEN_TEST_RESULT( "(Transforms) Batch Equ to Gal LON ", 
+                                 lon[i], gal.lon, 0.00000001 );
+    }
+    failed += GEN_TEST_RESULT( "(Transforms) Batch Equ to Gal LAT ", 
+                               lat[i], gal.lat, 0.00000001 );
+  }
+
+  T.get_gal_from_equ2000( ra, dec, count, lon, lat );
+  T.get_equ2000_from_gal( lon, lat, count, ra2, dec2 );
+
+  for( size_t i = 0; i < count; i++ ) {
+    object.ra = ra[i];
+    object.dec = dec[i];
+    T.get_gal_from_equ2000( &object, &gal );
+
+    if( std::fabs( dec[i] ) < 90.0 ) {
+      failed += GEN_TEST_RESULT( "(Transforms) Batch Equ2000 to Gal LON ", 
+                                 lon[i], gal.lon, 0.00000001 );
+      failed += GEN_TEST_RESULT( "(Transforms) Batch Gal to Equ2000 RA ", 
+                                 ra2[i], ra[i], 0.00000001 );
+    }
+    failed += GEN_TEST_RESULT( "(Transforms) Batch Equ2000 to Gal LAT ", 
+                               lat[i], gal.lat, 0.00000001 );
+    failed += GEN_TEST_RESULT( "(Transforms) Batch Gal to Equ2000 DEC ", 
+                               dec2[i], dec[i], 0.00000001 );
+  }
+
+  sidereus::epoch frame( JD );
+
+  genesis::proto_geo::point_lon_lat_posn ecl;
+
+  T.get_ecl_from_equ( ra, dec, count, &frame, lon, lat );
+  T.get_equ_from_ecl( lon, lat, count, &frame, ra2, dec2 );
+
+  for( size_t i = 0; i < count; i++ ) {
+    object.ra = ra[i];
+    object.dec = dec[i];
+    T.get_ecl_from_equ( &object, &frame, &ecl );
+
+    if( std::fabs( dec[i] ) < 90.0 ) {
+      failed += GEN_TEST_RESULT( "(Transforms) Batch Equ to Ecl LON ", 
+                                 lon[i], ecl.lon, 0.00000001 );
+      failed += GEN_TEST_RESULT( "(Transforms) Batch Ecl to Equ RA ", 
+                                 ra2[i], ra[i], 0.00000001 );
+    }
+    failed += GEN_TEST_RESULT( "(Transforms) Batch Equ to Ecl LAT ", 
+                               lat[i], ecl.lat, 0.00000001 );
+    failed += GEN_TEST_RESULT( "(Transforms) Batch Ecl to Equ DEC ", 
+                               dec2[i], dec[i], 0.00000001 );
+  }
+
+  GEN_MSG( "End: Batch Tranformation Coord.\n" );
+
+  return failed;
+}
+
 int main( int argc, char* argv[] ) 
 {
   int failed = 0;
 
   failed += transform_coord_test();
+  failed += transform_coord_batch_test();
 
   GEN_TEST_PRINT_RESULT( "tranformation_coord", failed );
 
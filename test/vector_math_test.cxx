@@ -0,0 +1,116 @@
+/**
+ * @file
+ *
+ * Tests for an vector_math class.
+ *
+ * SIDEREUS - Astronomy Librarie
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * @mainteiner: ederbsd@gmail.com
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/vector_math.hxx>
+
+#include <genesis/logger.hxx>
+#include <genesis/tests.hxx>
+
+#include <algorithm>
+#include <cmath>
+
+// Largest error in units of the last place of the libm value.
+static double max_ulp( const double* value, const double* expected, 
+                       size_t count )
+{
+  double worst = 0.0;
+
+  for( size_t i = 0; i < count; i++ ) {
+    double ulp = std::nextafter( std::fabs( expected[i] ), 1e300 ) - 
+                 std::fabs( expected[i] );
+    worst = std::max( worst, std::fabs( value[i] - expected[i] ) / ulp );
+  }
+
+  return worst;
+}
+
+// Test for class Vector Math.
+static int vector_math_test( void )
+{
+  GEN_MSG( "Tests for class Vector Math.\n" );
+  GEN_MSG( sidereus::vector_math::get_isa() );
+  GEN_MSG( "\n" );
+
+  const size_t count = 1001;
+
+  double x[count], y[count], s[count], c[count], r[count], 
+         es[count], ec[count], er[count];
+
+  // Set for tests.
+  int failed = 0;
+
+  // Angles around the circle, a few turns both ways.
+  for( size_t i = 0; i < count; i++ ) {
+    x[i] = -20.0 + 40.0 * i / ( count - 1 );
+    es[i] = std::sin( x[i] );
+    ec[i] = std::cos( x[i] );
+  }
+
+  sidereus::vector_math::sincos( x, s, c, count );
+
+  // libm itself may be off by up to 1 ULP.
+  failed += GEN_TEST_RESULT( "(Vector Math) sin max ULP", 
+                             max_ulp( s, es, count ), 0.0, 2.5 );
+  failed += GEN_TEST_RESULT( "(Vector Math) cos max ULP", 
+                             max_ulp( c, ec, count ), 0.0, 2.5 );
+
+  // Every quadrant, including the axes.
+  for( size_t i = 0; i < count; i++ ) {
+    double a = 2.0 * M_PI * i / ( count - 1 );
+    y[i] = 3.0 * std::sin( a );
+    x[i] = 3.0 * std::cos( a );
+    er[i] = std::atan2( y[i], x[i] );
+  }
+  y[0] = 0.0;
+  x[0] = 0.0;
+  er[0] = 0.0;
+
+  sidereus::vector_math::atan2( y, x, r, count );
+  failed += GEN_TEST_RESULT( "(Vector Math) atan2 max ULP", 
+                             max_ulp( r, er, count ), 0.0, 3.0 );
+
+  for( size_t i = 0; i < count; i++ ) {
+    x[i] = -1.0 + 2.0 * i / ( count - 1 );
+    er[i] = std::asin( x[i] );
+  }
+
+  sidereus::vector_math::asin( x, r, count );
+  failed += GEN_TEST_RESULT( "(Vector Math) asin max ULP", 
+                             max_ulp( r, er, count ), 0.0, 3.5 );
+
+  for( size_t i = 0; i < count; i++ ) {
+    er[i] = std::acos( x[i] );
+  }
+
+  sidereus::vector_math::acos( x, r, count );
+  failed += GEN_TEST_RESULT( "(Vector Math) acos max ULP", 
+                             max_ulp( r, er, count ), 0.0, 2.5 );
+
+  GEN_MSG( "End: Vector Math.\n" );
+
+  return failed;
+}
+
+int main( int argc, char* argv[] ) 
+{
+  int failed = 0;
+
+  failed += vector_math_test();
+
+  GEN_TEST_PRINT_RESULT( "vector_math", failed );
+
+  return( failed > 0 );
+}
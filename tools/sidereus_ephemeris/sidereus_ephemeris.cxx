@@ -0,0 +1,163 @@
+/**
+ * @file
+ *
+ * Ephemeris table writer.
+ *
+ * Copyright (c) 2009 Ederson de Moura
+ *
+ * @author Ederson de Moura
+ *
+ * $Id: Exp$
+ */
+
+#include <sidereus/nutation_table.hxx>
+
+#include <genesis/application.hxx>
+#include <genesis/logger.hxx>
+#include <genesis/string_util.hxx>
+
+#include <cstdio>
+#include <cstdlib>
+
+class sidereus_ephemeris : public genesis::application {
+  public:
+    /// Constructor.
+    sidereus_ephemeris() {};
+
+  private:
+    // Override.
+    int main( int argc, char* argv[] );
+
+    /// Print usage message to console.
+    void usage();
+
+    /// Print version message to console.
+    void version() const;
+
+  protected:
+    /**
+     * Fit a nutation table and write it.
+     *
+     * @param start - First Julian day.
+     * @param end - Last Julian day.
+     * @param segment - Segment length in days.
+     * @param degree - Degree of the polynomials.
+     * @param path - Output file.
+     * @return Exit status.
+     */
+    int write_table( double start, double end, double segment, 
+                     int degree, const char* path );
+};
+
+void sidereus_ephemeris::usage()
+{
+  add_usage( "Description:" );
+  add_usage( "   Writes a nutation and sidereal time table that the library" );
+  add_usage( "   maps with nutation_table::map().\n" );
+  add_usage( "Usage: " );
+  add_usage( "   -s <START JD> -e <END JD> -o <FILE> [<OPTIONS>]\n" );
+  add_usage( "Options:" );
+  add_usage( "   -s, --start     First Julian day." );
+  add_usage( "   -e, --end       Last Julian day." );
+  add_usage( "   -o, --output    Table file." );
+  add_usage( "   -g, --segment   Segment length in days (default 8)." );
+  add_usage( "   -d, --degree    Chebyshev degree (default 12)." );
+  add_usage( "   -v, --version   Print version." );
+  add_usage( "   -h, --help      Print this message." );
+  print_usage();
+}
+
+void sidereus_ephemeris::version() const
+{
+  std::cout << "\n" << genesis::string_util::to_uppercase( name() )
+            << ":\n\n"
+            << "      Version " << VERSION << "." << " Part of the "
+            << genesis::string_util::to_uppercase( PACKAGE )
+            << " package.\n\n"
+            << "Copyright (C) 2009 "
+            << "Ederson de Moura.\n"
+            << std::endl;
+}
+
+int sidereus_ephemeris::write_table( double start, double end, 
+ double segment, int degree, const char* path )
+{
+  sidereus::nutation_table table;
+  sidereus::nutation::nut error;
+
+  double sidereal = 0.0;
+
+  if( !( end > start ) || degree < 1 || 
+      !table.fit( start, end, segment, degree )) {
+    fprintf( stderr, "Invalid range, segment or degree (1 to %d).\n",
+             NUTATION_TABLE_MAX_DEGREE );
+    return 1;
+  }
+
+  table.get_max_error( &error, &sidereal );
+
+  if( !table.save( path ) ) {
+    fprintf( stderr, "Can't write %s.\n", path );
+    return 1;
+  }
+
+  fprintf( stdout, "JD %f to %f, %g day segments, degree %d: %s\n", 
+           start, end, segment, degree, path );
+  fprintf( stdout, "Max error: longitude %g\", obliquity %g\", "
+           "sidereal time %g s\n", error.longitude * 3600.0, 
+           error.obliquity * 3600.0, sidereal * 3600.0 );
+
+  return 0;
+}
+
+int sidereus_ephemeris::main( int argc, char* argv[] )
+{
+  set_verbose();
+
+  set_flag( "version", 'v' );
+  set_flag( "help", 'h' );
+
+  set_option( "start", 's' );
+  set_option( "end", 'e' );
+  set_option( "output", 'o' );
+  set_option( "segment", 'g' );
+  set_option( "degree", 'd' );
+
+  process_command_args( argc, argv );
+
+  if( !has_options() ) {
+    usage();
+    return 1;
+  }
+
+  if( get_flag( "version" ) || get_flag( 'v' ) ) {
+    version();
+    return 0;
+  }
+
+  if( get_flag( "help" ) || get_flag( 'h' ) ) {
+    usage();
+    return 0;
+  }
+
+  const char* start = get_value( 's' );
+  const char* end = get_value( 'e' );
+  const char* output = get_value( 'o' );
+  const char* segment = get_value( 'g' );
+  const char* degree = get_value( 'd' );
+
+  if( start == 0 || end == 0 || output == 0 ) {
+    usage();
+    return 1;
+  }
+
+  return write_table( std::atof( start ), std::atof( end ), 
+                      segment ? std::atof( segment ) : NUTATION_TABLE_SEGMENT,
+                      degree ? std::atoi( degree ) : NUTATION_TABLE_DEGREE, 
+                      output );
+}
+
+int main( int argc, char* argv[] )
+{
+  return sidereus_ephemeris().run( argc, argv );
+}
@@ -11,12 +11,49 @@
  */
 
 #include <sidereus/transform_coord.hxx>
+#include <sidereus/catalog_reader.hxx>
 #include <sidereus/julian_day.hxx>
+#include <sidereus/precession.hxx>
 
 #include <genesis/application.hxx>
 #include <genesis/logger.hxx>
 #include <genesis/string_util.hxx>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Rows held in memory at once, whatever the catalog size.
+#define TRANSFORMS_BLOCK 4096
+
+// stdio buffer of the input and output streams.
+#define TRANSFORMS_IO_BUFFER ( 1 << 20 )
+
+/// Transforms of a chain.
+enum transform_step {
+  STEP_PRECESSION,
+  STEP_EQU_HRZ,
+  STEP_EQU_ECL,
+  STEP_GAL_EQU2000
+};
+
+/// Coordinates of a catalog column pair.
+enum transform_frame {
+  FRAME_EQU,
+  FRAME_HRZ,
+  FRAME_ECL,
+  FRAME_GAL
+};
+
+/// Binary catalog record, native byte order.
+struct transform_record {
+  double lon; ///< Right ascension, azimuth or longitude (deg).
+  double lat; ///< Declination, altitude or latitude (deg).
+};
+
 class sidereus_transforms : public genesis::application {
   public:
     /// Constructor.
@@ -41,8 +78,90 @@ class sidereus_transforms : public genesis::application {
 
     /**
      * Computing distances between points on Earth.
+     *
+     * @param observer - Observer position.
+     */
+    void compute_trans( genesis::proto_geo::point_lon_lat_posn* observer );
+
+    /**
+     * Parse a comma separated chain of transforms.
+     *
+     * @param text - Chain, e.g. "gal-equ2000,prec,equ-hrz".
+     * @param chain - Pointer to store the steps.
+     * @return False if a step is unknown or does not take the 
+     * coordinates of the step before it.
+     */
+    bool parse_chain( const char* text, std::vector< int >* chain );
+
+    /**
+     * Parse the number given to an option.
+     *
+     * @param name - Option name, for the error message.
+     * @param text - Option value.
+     * @param value - Pointer to store the number.
+     * @return False if the value is not a finite number.
+     */
+    bool parse_number( const char* name, const char* text, double* value );
+
+    /**
+     * Read up to TRANSFORMS_BLOCK CSV rows.
+     *
+     * @param in - Input stream.
+     * @param lon - Array to store the first columns.
+     * @param lat - Array to store the second columns.
+     * @param count - Pointer to store the number of rows read.
+     * @return False on a malformed row.
+     */
+    bool read_csv( FILE* in, double* lon, double* lat, size_t* count );
+
+    /**
+     * Read up to TRANSFORMS_BLOCK binary records.
+     *
+     * @param in - Input stream.
+     * @param lon - Array to store the first columns.
+     * @param lat - Array to store the second columns.
+     * @param count - Pointer to store the number of records read.
+     * @return False on a truncated record.
+     */
+    bool read_binary( FILE* in, double* lon, double* lat, size_t* count );
+
+    /**
+     * Write rows as CSV or binary records.
+     *
+     * @param out - Output stream.
+     * @param lon - First columns.
+     * @param lat - Second columns.
+     * @param count - Number of rows.
+     * @param binary - True for binary records.
+     * @return False on a write error.
+     */
+    bool write_rows( FILE* out, const double* lon, const double* lat,
+                     size_t count, bool binary );
+
+    /**
+     * Stream a catalog through a chain of transforms, one block of 
+     * rows at a time.
+     *
+     * @param in - Input stream, unused with a catalog.
+     * @param catalog - Mapped binary catalog, or NULL to read in.
+     * @param out - Output stream.
+     * @param binary_in - True if the input is binary records.
+     * @param binary_out - True to write binary records.
+     * @param chain - Transforms, applied in order.
+     * @param observer - Observer position.
+     * @param JD - Julian Day of the observation, also the precession 
+     * target.
+     * @param fromJD - Julian Day of the input equinox.
+     * @return Exit status.
      */
-    void compute_trans();
+    int stream( FILE* in, sidereus::catalog_reader* catalog, FILE* out, 
+                bool binary_in, bool binary_out,
+                const std::vector< int >& chain,
+                genesis::proto_geo::point_lon_lat_posn* observer,
+                double JD, double fromJD );
+
+    /// Input row, for error messages.
+    size_t line_;
 
     /// Transformation of Coordinates.
     sidereus::transform_coord trans_;
@@ -54,10 +173,28 @@ class sidereus_transforms : public genesis::application {
 void sidereus_transforms::usage()
 {
   add_usage( "Description:" );
-  add_usage( "   This application ....\n" );
+  add_usage( "   Streams a catalog of coordinate pairs, CSV rows or binary" );
+  add_usage( "   records of two doubles, through a chain of transforms. CSV" );
+  add_usage( "   columns after the second are ignored, # starts a comment." );
+  add_usage( "   Without a chain, prints the Alnilam example.\n" );
   add_usage( "Usage: " );
-  add_usage( "   [<OPTIONS>] [<LAT1>] [<LON1>] [<LAT2>] [<LON2>]\n" );
+  add_usage( "   -c <CHAIN> [-i <FILE>] [-o <FILE>] [<OPTIONS>]\n" );
   add_usage( "Options:" );
+  add_usage( "   -c, --chain     Comma separated transforms, applied in order:" );
+  add_usage( "                   prec, equ-hrz, equ-ecl, gal-equ2000; equ-hrz" );
+  add_usage( "                   writes azimuth (0 = south), altitude." );
+  add_usage( "   -i, --input     Input catalog (default stdin), binary files" );
+  add_usage( "                   are memory mapped." );
+  add_usage( "   -o, --output    Output catalog (default stdout)." );
+  add_usage( "   -f, --format    Input format, csv or binary (default csv)." );
+  add_usage( "   -w, --write     Output format (default the input format)." );
+  add_usage( "   -j, --jd        Julian day of the observation." );
+  add_usage( "   -r, --from      Julian day of the input equinox for prec" );
+  add_usage( "                   (default J2000)." );
+  add_usage( "   -a, --lat1      Observer latitude (deg)." );
+  add_usage( "   -b, --lon1      Observer longitude, positive east (deg)." );
+  add_usage( "   -v, --version   Print version." );
+  add_usage( "   -h, --help      Print this message." );
   print_usage();
 }
 
@@ -87,26 +224,17 @@ void sidereus_transforms::equ_to_hequ( genesis::proto_geo::point_equ_posn* pos,
   genesis::datetime::deg_to_dms( pos->dec, &hpos->dec );
 }
 
-void sidereus_transforms::compute_trans()
+void sidereus_transforms::compute_trans( 
+ genesis::proto_geo::point_lon_lat_posn* observer )
 {
   genesis::proto_geo::point_nh_equ_posn hobject, hequ;
-  genesis::proto_geo::point_nh_lonlat_posn hobserver;
   genesis::proto_geo::point_equ_posn object, equ;
   genesis::proto_geo::point_hrz_posn hrz;
   genesis::proto_geo::point_nh_hrz_posn hhrz;
-  genesis::proto_geo::point_lon_lat_posn observer;
 
   double JD = 0.0;
   genesis::proto_datetime::date date;
 
-  // Observers position. 
-  hobserver.lon.degrees = -5;
-  hobserver.lon.minutes = 36;
-  hobserver.lon.seconds = 30;
-  hobserver.lat.degrees = 42;
-  hobserver.lat.minutes = 35;
-  hobserver.lat.seconds = 40;
-
   // Alnilam.
   hobject.ra.hours = 5;
   hobject.ra.minutes = 36;
@@ -127,11 +255,10 @@ void sidereus_transforms::compute_trans()
   JD = julian_.get_julian_day( &date );
 
   genesis::geometry::hequ_to_equ( &hobject, &object );
-  genesis::geometry::hlnlat_to_lnlat( &hobserver, &observer );
 
   GEN_MSG( "\nComputing Altitude and Azimuth\n" );
 
-  trans_.get_hrz_from_equ( &object, &observer, JD, &hrz );
+  trans_.get_hrz_from_equ( &object, observer, JD, &hrz );
 
   fprintf( stdout, "( Alnilam ) Equ to Horiz Altitude: %f\n", hrz.alt );
   fprintf( stdout, "( Alnilam ) Equ to Horiz Azimuth: %f\n", hrz.az );
@@ -144,7 +271,7 @@ void sidereus_transforms::compute_trans()
   fprintf( stdout, "Azimuth = %d:%d:%f\n\n", hhrz.az.degrees, 
                    hhrz.az.minutes, hhrz.az.seconds );
 
-  trans_.get_equ_from_hrz( &hrz, &observer, JD, &equ );
+  trans_.get_equ_from_hrz( &hrz, observer, JD, &equ );
 
   fprintf( stdout, "( Alnilam ) Horiz to Equ Right Ascension: %f\n", equ.ra );
   fprintf( stdout, "( Alnilam ) Horiz to Equ Declination: %f\n", equ.dec );
@@ -158,6 +285,253 @@ void sidereus_transforms::compute_trans()
                    hequ.dec.minutes, hequ.dec.seconds );
 }
 
+bool sidereus_transforms::parse_number( const char* name, 
+ const char* text, double* value )
+{
+  char* end = 0;
+
+  // atof() would take a malformed value for 0.
+  *value = strtod( text, &end );
+
+  if( end == text || *end != '\0' || !std::isfinite( *value )) {
+    fprintf( stderr, "--%s: %s is not a number.\n", name, text );
+    return false;
+  }
+
+  return true;
+}
+
+bool sidereus_transforms::parse_chain( const char* text, 
+ std::vector< int >* chain )
+{
+  static const char* names[] = { "prec", "equ-hrz", "equ-ecl", 
+                                 "gal-equ2000" };
+  static const int from[] = { FRAME_EQU, FRAME_EQU, FRAME_EQU, FRAME_GAL };
+  static const int to[] = { FRAME_EQU, FRAME_HRZ, FRAME_ECL, FRAME_EQU };
+
+  std::string steps( text );
+
+  size_t first = 0;
+
+  int frame = -1;
+
+  chain->clear();
+
+  while( first <= steps.size() ) {
+    size_t end = std::min( steps.find( ',', first ), steps.size() );
+    std::string name = steps.substr( first, end - first );
+
+    int step = -1;
+
+    for( int k = 0; k < 4; k++ ) {
+      if( name == names[k] ) {
+        step = k;
+      }
+    }
+
+    if( step < 0 ) {
+      fprintf( stderr, "Unknown transform '%s'.\n", name.c_str() );
+      return false;
+    }
+
+    if( frame >= 0 && frame != from[step] ) {
+      fprintf( stderr, "Transform '%s' does not take the output of the "
+               "one before it.\n", name.c_str() );
+      return false;
+    }
+
+    frame = to[step];
+    chain->push_back( step );
+    first = end + 1;
+  }
+
+  return true;
+}
+
+bool sidereus_transforms::read_csv( FILE* in, double* lon, double* lat,
+ size_t* count )
+{
+  char row[256];
+
+  *count = 0;
+
+  while( *count < TRANSFORMS_BLOCK && fgets( row, sizeof( row ), in )) {
+    char* end = 0;
+    char* second = 0;
+
+    line_++;
+
+    if( strchr( row, '\n' ) == 0 && !feof( in )) {
+      fprintf( stderr, "Line %zu: row too long.\n", line_ );
+      return false;
+    }
+
+    // Blank rows and comments.
+    if( row[strspn( row, " \t\r\n" )] == '\0' || row[0] == '#' ) {
+      continue;
+    }
+
+    lon[*count] = strtod( row, &end );
+
+    if( end == row || *end != ',' ) {
+      fprintf( stderr, "Line %zu: expected two numbers.\n", line_ );
+      return false;
+    }
+
+    // strtod() points end back at the field when it reads nothing.
+    second = end + 1;
+    lat[*count] = strtod( second, &end );
+
+    if( end == second || 
+        ( end[strspn( end, " \t\r\n" )] != '\0' && *end != ',' )) {
+      fprintf( stderr, "Line %zu: expected two numbers.\n", line_ );
+      return false;
+    }
+
+    ( *count )++;
+  }
+
+  if( ferror( in )) {
+    fprintf( stderr, "Read error.\n" );
+    return false;
+  }
+
+  return true;
+}
+
+bool sidereus_transforms::read_binary( FILE* in, double* lon, double* lat,
+ size_t* count )
+{
+  transform_record records[TRANSFORMS_BLOCK];
+
+  size_t bytes = fread( records, 1, sizeof( records ), in );
+
+  *count = bytes / sizeof( transform_record );
+
+  if( bytes % sizeof( transform_record ) != 0 || ferror( in )) {
+    fprintf( stderr, "Record %zu: truncated.\n", line_ + *count + 1 );
+    return false;
+  }
+
+  for( size_t i = 0; i < *count; i++ ) {
+    lon[i] = records[i].lon;
+    lat[i] = records[i].lat;
+  }
+
+  line_ += *count;
+
+  return true;
+}
+
+bool sidereus_transforms::write_rows( FILE* out, const double* lon, 
+ const double* lat, size_t count, bool binary )
+{
+  if( binary ) {
+    transform_record records[TRANSFORMS_BLOCK];
+
+    for( size_t i = 0; i < count; i++ ) {
+      records[i].lon = lon[i];
+      records[i].lat = lat[i];
+    }
+
+    return fwrite( records, sizeof( transform_record ), count, out ) == count;
+  }
+
+  for( size_t i = 0; i < count; i++ ) {
+    fprintf( out, "%.9f,%.9f\n", lon[i], lat[i] );
+  }
+
+  return !ferror( out );
+}
+
+int sidereus_transforms::stream( FILE* in, 
+ sidereus::catalog_reader* catalog, FILE* out, bool binary_in,
+ bool binary_out, const std::vector< int >& chain,
+ genesis::proto_geo::point_lon_lat_posn* observer, double JD, double fromJD )
+{
+  // Static, the streams may outlive this call.
+  static char in_buffer[TRANSFORMS_IO_BUFFER];
+  static char out_buffer[TRANSFORMS_IO_BUFFER];
+
+  std::vector< double > buffer( 4 * TRANSFORMS_BLOCK );
+
+  // Columns of the current block and scratch for the next step.
+  double* lon = &buffer[0];
+  double* lat = &buffer[TRANSFORMS_BLOCK];
+  double* next_lon = &buffer[2 * TRANSFORMS_BLOCK];
+  double* next_lat = &buffer[3 * TRANSFORMS_BLOCK];
+
+  size_t count = 0;
+
+  // Nutation and sidereal time once for the whole catalog.
+  sidereus::epoch frame( JD );
+  sidereus::precession& precession = sidereus::precession::local();
+
+  if( catalog == 0 ) {
+    setvbuf( in, in_buffer, _IOFBF, sizeof( in_buffer ));
+  }
+
+  setvbuf( out, out_buffer, _IOFBF, sizeof( out_buffer ));
+
+  line_ = 0;
+
+  for( ;; ) {
+    bool ok = true;
+
+    // Mapped catalogs go from the page cache to the columns directly.
+    if( catalog != 0 ) {
+      count = catalog->read( lon, lat, TRANSFORMS_BLOCK );
+    } else if( binary_in ) {
+      ok = read_binary( in, lon, lat, &count );
+    } else {
+      ok = read_csv( in, lon, lat, &count );
+    }
+
+    if( !ok ) {
+      return 1;
+    }
+
+    if( count == 0 ) {
+      break;
+    }
+
+    for( size_t k = 0; k < chain.size(); k++ ) {
+      switch( chain[k] ) {
+      case STEP_PRECESSION:
+        precession.apply( lon, lat, count, fromJD, JD, next_lon, next_lat );
+        break;
+      case STEP_EQU_HRZ:
+        // Azimuth first, like the other longitudes.
+        trans_.get_hrz_from_equ( lon, lat, count, observer, &frame,
+                                 next_lat, next_lon );
+        break;
+      case STEP_EQU_ECL:
+        trans_.get_ecl_from_equ( lon, lat, count, &frame, 
+                                 next_lon, next_lat );
+        break;
+      case STEP_GAL_EQU2000:
+        trans_.get_equ2000_from_gal( lon, lat, count, next_lon, next_lat );
+        break;
+      }
+
+      std::swap( lon, next_lon );
+      std::swap( lat, next_lat );
+    }
+
+    if( !write_rows( out, lon, lat, count, binary_out )) {
+      fprintf( stderr, "Write error.\n" );
+      return 1;
+    }
+  }
+
+  if( fflush( out ) != 0 ) {
+    fprintf( stderr, "Write error.\n" );
+    return 1;
+  }
+
+  return 0;
+}
+
 int sidereus_transforms::main( int argc, char* argv[] )
 {
   set_verbose();
@@ -168,6 +542,14 @@ int sidereus_transforms::main( int argc, char* argv[] )
   set_flag( "log", 'l' );
 
   set_option( "lat1", 'a' );
+  set_option( "lon1", 'b' );
+  set_option( "chain", 'c' );
+  set_option( "input", 'i' );
+  set_option( "output", 'o' );
+  set_option( "format", 'f' );
+  set_option( "write", 'w' );
+  set_option( "jd", 'j' );
+  set_option( "from", 'r' );
 
   bool ok = false;
 
@@ -193,14 +575,122 @@ int sidereus_transforms::main( int argc, char* argv[] )
     return ok;
   }
 
-  std::string lat1;
-  if( get_value( "lat1" ) != 0 || get_value( 'a' ) != 0 ) {
-    lat1 = get_value( 'a' );
+  genesis::proto_geo::point_nh_lonlat_posn hobserver;
+  genesis::proto_geo::point_lon_lat_posn observer;
+
+  // Default observers position. 
+  hobserver.lon.neg = 0;
+  hobserver.lon.degrees = -5;
+  hobserver.lon.minutes = 36;
+  hobserver.lon.seconds = 30;
+  hobserver.lat.neg = 0;
+  hobserver.lat.degrees = 42;
+  hobserver.lat.minutes = 35;
+  hobserver.lat.seconds = 40;
+
+  genesis::geometry::hlnlat_to_lnlat( &hobserver, &observer );
+
+  const char* lat1 = get_value( 'a' );
+  const char* lon1 = get_value( 'b' );
+  const char* chain = get_value( 'c' );
+  const char* input = get_value( 'i' );
+  const char* output = get_value( 'o' );
+  const char* format = get_value( 'f' );
+  const char* write = get_value( 'w' );
+  const char* jd = get_value( 'j' );
+  const char* from = get_value( 'r' );
+
+  double JD = JULIAN_DAY_JD2000, from_JD = JULIAN_DAY_JD2000;
+
+  if(( lat1 != 0 && !parse_number( "lat1", lat1, &observer.lat )) ||
+     ( lon1 != 0 && !parse_number( "lon1", lon1, &observer.lon )) ||
+     ( jd != 0 && !parse_number( "jd", jd, &JD )) ||
+     ( from != 0 && !parse_number( "from", from, &from_JD ))) {
+    usage();
+    return 1;
+  }
+
+  if( chain == 0 ) {
+    compute_trans( &observer );
+    return 0;
   }
 
-  compute_trans();
+  std::vector< int > steps;
 
-  return 0;
+  if( !parse_chain( chain, &steps )) {
+    return 1;
+  }
+
+  bool binary_in = format != 0 && strcmp( format, "binary" ) == 0;
+  bool binary_out = write != 0 ? strcmp( write, "binary" ) == 0 : binary_in;
+
+  if(( format != 0 && !binary_in && strcmp( format, "csv" ) != 0 ) ||
+     ( write != 0 && !binary_out && strcmp( write, "csv" ) != 0 )) {
+    fprintf( stderr, "Formats are csv or binary.\n" );
+    return 1;
+  }
+
+  // Every step but gal-equ2000 depends on the time.
+  if( jd == 0 && std::count( steps.begin(), steps.end(), 
+                             ( int )STEP_GAL_EQU2000 ) != 
+                 ( long )steps.size() ) {
+    fprintf( stderr, "The chain needs --jd.\n" );
+    return 1;
+  }
+
+  FILE* in = stdin;
+  FILE* out = stdout;
+
+  sidereus::catalog_reader catalog;
+
+  bool mapped = false;
+
+  // Binary files are mapped, pipes and CSV go through stdio.
+  if( input != 0 && strcmp( input, "-" ) != 0 && binary_in ) {
+    if( !catalog.open( input )) {
+      fprintf( stderr, "Can't map %s, or it is not a whole number of "
+               "records.\n", input );
+      return 1;
+    }
+
+    mapped = true;
+  } else if( input != 0 && strcmp( input, "-" ) != 0 ) {
+    in = fopen( input, "r" );
+
+    if( in == 0 ) {
+      fprintf( stderr, "Can't read %s.\n", input );
+      return 1;
+    }
+  }
+
+  if( output != 0 && strcmp( output, "-" ) != 0 ) {
+    out = fopen( output, binary_out ? "wb" : "w" );
+
+    if( out == 0 ) {
+      fprintf( stderr, "Can't write %s.\n", output );
+
+      if( in != stdin ) {
+        fclose( in );
+      }
+
+      return 1;
+    }
+  }
+
+  int status = stream( in, mapped ? &catalog : 0, out, binary_in, 
+                       binary_out, steps, &observer,
+                       JD, from_JD );
+
+  if( in != stdin ) {
+    fclose( in );
+  }
+
+  if( out != stdout && fclose( out ) != 0 ) {
+    fprintf( stderr, "Can't write %s.\n", output );
+    status = 1;
+  }
+
+  return status;
 }
 
 int main( int argc, char* argv[] )